@@ -151,6 +151,10 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/** The number of finished draw tasks kept for reuse, so that drawing doesn't allocate them every frame.
+ *  Each one has room for its draw descriptor too. Set it to 0 to always free them. */
+#define LV_DRAW_TASK_POOL_CNT    256
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -183,6 +187,11 @@
      *  - > 1 means multiple threads will render the screen in parallel. */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /** Split large fills, images and layers into horizontal bands of this many rows,
+     *  so idle rendering threads can help drawing them. 0: don't split.
+     *  Used only if `LV_DRAW_SW_DRAW_UNIT_CNT > 1`. */
+    #define LV_DRAW_SW_BAND_HEIGHT      0
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -195,14 +204,16 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /** Allow buffering some shadow calculation.
-         *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+        /** Size of the shadow cache in bytes. It keeps the blurred corners of box shadows, so shadows with
+         *  the same radius and width are not blurred again in every frame.
+         *  A shadow needs `2 * (shadow_width + radius)^2` bytes. Shadows larger than a quarter of the cache are not stored.
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE 0
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle. The circles are kept between frames, and the cache
+         *  is cleared after a frame that used more radii. The drawing threads find the circles without locking.
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
@@ -216,6 +227,12 @@
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
 
+    /** Size of the gradient cache in bytes. It keeps the colors of horizontal and vertical gradients
+     *  and the color maps of complex gradients, so they are not calculated again in every frame.
+     *  A gradient needs `4 * length` bytes. Gradients larger than a quarter of the cache are not stored.
+     *  - 0: disables caching */
+    #define LV_DRAW_SW_GRAD_CACHE_DEF_SIZE 0
+
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -445,6 +462,19 @@
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/** Default number of glyph descriptor cache entries. An entry stores the metrics of a letter and its kerning
+ *  with the next letter, as returned by `lv_font_get_glyph_dsc()`. Measuring, wrapping and drawing a text
+ *  look up the same letter pairs again, so with the cache these are resolved only once.
+ *  Worth it for fonts with a slow lookup, like TinyTTF, FreeType and image fonts.
+ *  Fonts in the built-in format find a glyph faster than the cache and don't use it.
+ *  If 0, the cache is disabled. */
+#define LV_FONT_GLYPH_CACHE_DEF_CNT 0
+
+/** Default size of the glyph atlas in bytes. The atlas keeps the unpacked A8 bitmaps of the glyphs of
+ *  built-in format fonts, so letters drawn again skip expanding 1..4 bpp pixels and decompressing.
+ *  A 14 px glyph needs about 150 bytes. If 0, the atlas is disabled. */
+#define LV_FONT_GLYPH_ATLAS_DEF_SIZE 0
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #define LV_GRADIENT_MAX_STOPS   2
@@ -460,6 +490,10 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Add 2 x 16-bit variables to each `lv_obj_t` to cache if it covers its inner area.
+ *  It makes finding the top object of the redrawn areas cheaper. */
+#define LV_OBJ_COVER_CACHE      0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -620,6 +654,16 @@
  *  A compiler error will be triggered if a font needs it. */
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/** Build a codepoint to glyph ID table for each font in the built-in format on its first use.
+ *  Finding a glyph then takes a table lookup instead of a search through the font's character maps.
+ *  Costs 2 bytes per 256 codepoints up to the font's last character,
+ *  plus 512 bytes for each block of 256 codepoints that contains characters. */
+#define LV_FONT_FMT_TXT_GLYPH_INDEX 0
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    /** Maximum number of fonts with a glyph index. Further fonts search their character maps. */
+    #define LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT 16
+#endif
+
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
@@ -729,6 +773,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1   /**< Enable selecting text of the label */
     #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
+    #define LV_LABEL_LINE_CACHE 0       /**< Store the line breaks and line widths of labels to draw them without measuring the text again */
     #define LV_LABEL_WAIT_CHAR_COUNT 3  /**< The count of wait chart */
 #endif
 
@@ -37,6 +37,8 @@ extern "C" {
 #include "src/misc/lv_circle_buf.h"
 #include "src/misc/lv_tree.h"
 #include "src/misc/cache/lv_image_cache.h"
+#include "src/misc/cache/lv_font_glyph_cache.h"
+#include "src/misc/cache/lv_font_glyph_atlas.h"
 
 #include "src/tick/lv_tick.h"
 
@@ -66,6 +66,7 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 #define LV_NEMA_HAL_CUSTOM          0
@@ -231,6 +232,10 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #endif
 #endif
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    #warning "LV_DRAW_SW_SHADOW_CACHE_SIZE was replaced by LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE which is the size of the cache in bytes. Please update lv_conf.h or run menuconfig again."
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
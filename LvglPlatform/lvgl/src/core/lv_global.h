@@ -31,7 +31,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_FONT_FMT_TXT_GLYPH_INDEX
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -51,6 +51,9 @@ extern "C" {
 #include "../draw/lv_draw_private.h"
 #include "../draw/sw/lv_draw_sw_private.h"
 #include "../draw/sw/lv_draw_sw_mask_private.h"
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+#include "../draw/sw/blend/sse2/lv_blend_sse2.h"
+#endif
 #include "../stdlib/builtin/lv_tlsf_private.h"
 #include "../others/sysmon/lv_sysmon_private.h"
 #include "../others/test/lv_test_private.h"
@@ -126,13 +129,27 @@ typedef struct _lv_global_t {
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
 
+    lv_cache_t * font_glyph_cache;
+    uint32_t font_glyph_cache_hit_cnt;
+    uint32_t font_glyph_cache_miss_cnt;
+    lv_cache_t * font_glyph_atlas;
+    uint32_t font_glyph_atlas_hit_cnt;
+    uint32_t font_glyph_atlas_miss_cnt;
+
     lv_draw_global_info_t draw_info;
     lv_ll_t draw_sw_blend_handler_ll;
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
-#endif
+    lv_cache_t * sw_grad_cache;
+    uint32_t sw_grad_cache_hit_cnt;
+    uint32_t sw_grad_cache_miss_cnt;
 #if LV_DRAW_SW_COMPLEX
+    lv_cache_t * sw_shadow_cache;
+    uint32_t sw_shadow_cache_hit_cnt;
+    uint32_t sw_shadow_cache_miss_cnt;
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    bool sw_circle_cache_overflow;
+#endif
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+    lv_blend_sse2_isa_t draw_sw_blend_isa;
 #endif
 
 #if LV_USE_LOG
@@ -199,6 +216,10 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    lv_font_fmt_txt_glyph_index_state_t font_fmt_txt_glyph_index;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
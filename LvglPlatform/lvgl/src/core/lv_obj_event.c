@@ -102,6 +102,11 @@ lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb, lv_
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_obj_allocate_spec_attr(obj);
 
+#if LV_OBJ_COVER_CACHE
+    /*The new callback might change the result of the cover check*/
+    obj->cover_cache = LV_OBJ_COVER_CACHE_UNKNOWN;
+#endif
+
     return lv_event_add(&obj->spec_attr->event_list, event_cb, filter, user_data);
 }
 
@@ -123,6 +128,12 @@ bool lv_obj_remove_event(lv_obj_t * obj, uint32_t index)
 {
     LV_ASSERT_NULL(obj);
     if(obj->spec_attr == NULL) return false;
+
+#if LV_OBJ_COVER_CACHE
+    /*The removed callback might have changed the result of the cover check*/
+    obj->cover_cache = LV_OBJ_COVER_CACHE_UNKNOWN;
+#endif
+
     return lv_event_remove(&obj->spec_attr->event_list, index);
 }
 
@@ -131,6 +142,11 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, lv_event_dsc_t * dsc)
     LV_ASSERT_NULL(obj);
     LV_ASSERT_NULL(dsc);
     if(obj->spec_attr == NULL) return false;
+
+#if LV_OBJ_COVER_CACHE
+    obj->cover_cache = LV_OBJ_COVER_CACHE_UNKNOWN;
+#endif
+
     return lv_event_remove_dsc(&obj->spec_attr->event_list, dsc);
 }
 
@@ -823,6 +823,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_COVER_CACHE
+    /*Anything which needs a redraw might change what the object covers too*/
+    ((lv_obj_t *)obj)->cover_cache = LV_OBJ_COVER_CACHE_UNKNOWN;
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
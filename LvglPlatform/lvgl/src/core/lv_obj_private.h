@@ -24,6 +24,16 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_OBJ_COVER_CACHE
+/** Cached result of the cover check of an object's inner area. See `cover_cache` in `lv_obj_t`*/
+typedef enum {
+    LV_OBJ_COVER_CACHE_UNKNOWN = 0,     /**< Not checked since the last invalidation*/
+    LV_OBJ_COVER_CACHE_COVER,           /**< Covers its coordinates shrunk by `cover_inset`*/
+    LV_OBJ_COVER_CACHE_NOT_COVER,       /**< Doesn't cover its inner area*/
+    LV_OBJ_COVER_CACHE_SKIP,            /**< Masked or transparent, neither it nor its children cover anything*/
+} lv_obj_cover_cache_t;
+#endif
+
 /**
  * Special, rarely used attributes.
  * They are allocated automatically if any elements is set.
@@ -76,6 +86,10 @@ struct _lv_obj_t {
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
     uint16_t is_deleting : 1;
+#if LV_OBJ_COVER_CACHE
+    uint16_t cover_cache;   /**< Element of `lv_obj_cover_cache_t`. Reset when the object is invalidated.*/
+    uint16_t cover_inset;   /**< The cached cover result is valid on the coordinates shrunk by this*/
+#endif
 };
 
 
@@ -40,11 +40,16 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static bool inv_tiles_add(lv_display_t * disp, const lv_area_t * area_p);
+static bool inv_tiles_cover(const lv_display_t * disp, const lv_area_t * area_p);
+static void inv_tiles_to_areas(lv_display_t * disp);
+static bool inv_areas_reserve(lv_display_t * disp, uint32_t cnt);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p, int32_t y_offset);
 static void refr_configured_layer(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+static lv_cover_res_t obj_cover_check(lv_obj_t * obj, const lv_area_t * area_p);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
@@ -280,7 +285,7 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
 
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
-        disp->inv_p = 0;
+        lv_refr_reset_inv_areas(disp);
         return;
     }
 
@@ -319,19 +324,30 @@ void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     for(i = 0; i < disp->inv_p; i++) {
         if(lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
+    if(inv_tiles_cover(disp, &com_area)) return;
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*Save the area. If there is no place for it, mark its tiles, or add the screen as a last resort.
+     *In tiled mode all the areas are marked on the tiles.*/
+    if(disp->inv_p < LV_INV_BUF_SIZE && disp->render_mode != LV_DISPLAY_RENDER_MODE_TILED) {
+        lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
+    }
+    else if(inv_tiles_add(disp, &com_area) == false) {
+        lv_refr_reset_inv_areas(disp);
+        disp->inv_areas[0] = scr_area;
+        disp->inv_p = 1;
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+void lv_refr_reset_inv_areas(lv_display_t * disp)
+{
+    lv_memzero(disp->inv_area_joined, disp->inv_p);
+    disp->inv_p = 0;
+    disp->inv_tiles_dirty = 0;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -395,7 +411,7 @@ void lv_display_refr_timer(lv_timer_t * tmr)
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
-        disp_refr->inv_p = 0;
+        lv_refr_reset_inv_areas(disp_refr);
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
@@ -418,9 +434,7 @@ void lv_display_refr_timer(lv_timer_t * tmr)
         }
     }
 
-    lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-    lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
-    disp_refr->inv_p = 0;
+    lv_refr_reset_inv_areas(disp_refr);
 
 refr_finish:
 
@@ -440,6 +454,7 @@ refr_finish:
 
 /**
  * Join the areas which has got common parts
+ * and add the areas of the marked tiles
  */
 static void lv_refr_join_area(void)
 {
@@ -447,6 +462,16 @@ static void lv_refr_join_area(void)
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
+
+    /*If the areas didn't fit into the buffer, redraw all of them with the tiles, so that they can be joined
+     *with respect to the cost of the areas*/
+    if(disp_refr->inv_tiles_dirty) {
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            inv_tiles_add(disp_refr, &disp_refr->inv_areas[join_in]);
+            disp_refr->inv_area_joined[join_in] = 1;
+        }
+    }
+
     for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
         if(disp_refr->inv_area_joined[join_in] != 0) continue;
 
@@ -474,9 +499,196 @@ static void lv_refr_join_area(void)
             }
         }
     }
+
+    /*The areas of the tiles are joined while they are collected*/
+    if(disp_refr->inv_tiles_dirty) inv_tiles_to_areas(disp_refr);
     LV_PROFILER_REFR_END;
 }
 
+/**
+ * Mark the tiles touched by an area
+ * @param disp      pointer to a display
+ * @param area_p    the area to mark, already clipped to the screen
+ * @return          false if the tiles couldn't be allocated
+ */
+static bool inv_tiles_add(lv_display_t * disp, const lv_area_t * area_p)
+{
+    if(disp->inv_tiles_dirty == 0) {
+        /*The first area of this refresh: fit the grid to the current resolution*/
+        int32_t cols = (lv_display_get_horizontal_resolution(disp) + LV_INV_TILE_SIZE - 1) / LV_INV_TILE_SIZE;
+        int32_t rows = (lv_display_get_vertical_resolution(disp) + LV_INV_TILE_SIZE - 1) / LV_INV_TILE_SIZE;
+        uint32_t cnt = (uint32_t)(cols * rows);
+        if(cnt > disp->inv_tile_cap) {
+            uint8_t * tiles = lv_realloc(disp->inv_tiles, cnt);
+            if(tiles == NULL) return false;
+            disp->inv_tiles = tiles;
+            disp->inv_tile_cap = cnt;
+        }
+        lv_memzero(disp->inv_tiles, cnt);
+        disp->inv_tile_cols = cols;
+        disp->inv_tile_rows = rows;
+        disp->inv_tiles_dirty = 1;
+    }
+
+    int32_t col1 = area_p->x1 / LV_INV_TILE_SIZE;
+    int32_t col2 = LV_MIN(area_p->x2 / LV_INV_TILE_SIZE, disp->inv_tile_cols - 1);
+    int32_t row1 = area_p->y1 / LV_INV_TILE_SIZE;
+    int32_t row2 = LV_MIN(area_p->y2 / LV_INV_TILE_SIZE, disp->inv_tile_rows - 1);
+    if(col1 > col2 || row1 > row2) return true;
+
+    int32_t row;
+    for(row = row1; row <= row2; row++) {
+        lv_memset(&disp->inv_tiles[row * disp->inv_tile_cols + col1], 1, col2 - col1 + 1);
+    }
+
+    return true;
+}
+
+/**
+ * Check if all the tiles touched by an area are marked
+ * @param disp      pointer to a display
+ * @param area_p    an area on the screen
+ * @return          true: the area will be redrawn with the tiles
+ */
+static bool inv_tiles_cover(const lv_display_t * disp, const lv_area_t * area_p)
+{
+    if(disp->inv_tiles_dirty == 0) return false;
+
+    int32_t col1 = area_p->x1 / LV_INV_TILE_SIZE;
+    int32_t col2 = area_p->x2 / LV_INV_TILE_SIZE;
+    int32_t row1 = area_p->y1 / LV_INV_TILE_SIZE;
+    int32_t row2 = area_p->y2 / LV_INV_TILE_SIZE;
+    if(col2 >= disp->inv_tile_cols || row2 >= disp->inv_tile_rows) return false;
+
+    int32_t row;
+    int32_t col;
+    for(row = row1; row <= row2; row++) {
+        const uint8_t * tile = &disp->inv_tiles[row * disp->inv_tile_cols];
+        for(col = col1; col <= col2; col++) {
+            if(tile[col] == 0) return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Add the marked tiles to the invalidated areas as a few rectangles.
+ * Every area has a fixed cost to redraw, so a few unmarked tiles are also added
+ * if that saves an area. In tiled mode only the marked tiles are added, and
+ * they are rendered in parts which fit into the draw buffer as in partial mode.
+ * @param disp      pointer to a display
+ */
+static void inv_tiles_to_areas(lv_display_t * disp)
+{
+    int32_t cols = disp->inv_tile_cols;
+    int32_t rows = disp->inv_tile_rows;
+    const uint8_t * tiles = disp->inv_tiles;
+    uint32_t first = disp->inv_p;
+    int32_t join_cnt = disp->render_mode == LV_DISPLAY_RENDER_MODE_TILED ? 0 : LV_INV_TILE_JOIN_CNT;
+    int32_t row;
+    uint32_t i;
+
+    /*Collect the areas in tile units first*/
+    for(row = 0; row < rows; row++) {
+        const uint8_t * tile = &tiles[row * cols];
+        int32_t col = 0;
+        while(col < cols) {
+            if(tile[col] == 0) {
+                col++;
+                continue;
+            }
+
+            /*Take the run of marked tiles in this row, bridging short gaps*/
+            int32_t col_end = col;
+            int32_t c;
+            for(c = col + 1; c < cols && c - col_end <= join_cnt + 1; c++) {
+                if(tile[c]) col_end = c;
+            }
+
+            /*Grow an area of the row above if only a few unmarked tiles are added by that*/
+            lv_area_t * join_to = NULL;
+            int32_t join_waste = join_cnt + 1;
+            for(i = first; i < disp->inv_p; i++) {
+                lv_area_t * a = &disp->inv_areas[i];
+                if(a->y2 != row - 1) continue;
+
+                int32_t w = LV_MAX(a->x2, col_end) - LV_MIN(a->x1, col) + 1;
+                int32_t waste = w * (lv_area_get_height(a) + 1) - lv_area_get_size(a) - (col_end - col + 1);
+                if(waste < join_waste) {
+                    join_to = a;
+                    join_waste = waste;
+                }
+            }
+
+            if(join_to) {
+                join_to->x1 = LV_MIN(join_to->x1, col);
+                join_to->x2 = LV_MAX(join_to->x2, col_end);
+                join_to->y2 = row;
+            }
+            else {
+                if(inv_areas_reserve(disp, disp->inv_p + 1) == false) {
+                    /*No memory for more areas, redraw the whole screen*/
+                    LV_LOG_WARN("couldn't allocate the invalidated areas, redrawing the screen");
+                    lv_memzero(disp->inv_area_joined, disp->inv_p);
+                    lv_area_set(&disp->inv_areas[0], 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                                lv_display_get_vertical_resolution(disp) - 1);
+                    disp->inv_p = 1;
+                    disp->inv_tiles_dirty = 0;
+                    return;
+                }
+
+                lv_area_set(&disp->inv_areas[disp->inv_p], col, row, col_end, row);
+                disp->inv_area_joined[disp->inv_p] = 0;
+                disp->inv_p++;
+            }
+
+            col = col_end + 1;
+        }
+    }
+
+    /*Convert the areas to pixels. The resolution might have been changed since the tiles were marked*/
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                lv_display_get_vertical_resolution(disp) - 1);
+    for(i = first; i < disp->inv_p; i++) {
+        lv_area_t * a = &disp->inv_areas[i];
+        a->x1 = a->x1 * LV_INV_TILE_SIZE;
+        a->y1 = a->y1 * LV_INV_TILE_SIZE;
+        a->x2 = (a->x2 + 1) * LV_INV_TILE_SIZE - 1;
+        a->y2 = (a->y2 + 1) * LV_INV_TILE_SIZE - 1;
+        if(lv_area_intersect(a, a, &scr_area) == false) disp->inv_area_joined[i] = 1;
+    }
+
+    disp->inv_tiles_dirty = 0;
+}
+
+/**
+ * Make sure that the invalidated areas have room for a given number of areas
+ * @param disp      pointer to a display
+ * @param cnt       the number of areas needed
+ * @return          false if the memory couldn't be allocated
+ */
+static bool inv_areas_reserve(lv_display_t * disp, uint32_t cnt)
+{
+    if(cnt <= disp->inv_area_cap) return true;
+
+    uint32_t cap = disp->inv_area_cap * 2;
+    while(cap < cnt) cap *= 2;
+
+    lv_area_t * areas = lv_realloc(disp->inv_areas, cap * sizeof(lv_area_t));
+    if(areas == NULL) return false;
+    disp->inv_areas = areas;
+
+    uint8_t * joined = lv_realloc(disp->inv_area_joined, cap);
+    if(joined == NULL) return false;
+    lv_memzero(&joined[disp->inv_area_cap], cap - disp->inv_area_cap);
+    disp->inv_area_joined = joined;
+    disp->inv_area_cap = cap;
+
+    return true;
+}
+
 /**
  * Refresh the sync areas
  */
@@ -588,7 +800,8 @@ static void refr_invalid_areas(void)
         disp_refr->last_part = 0;
 
         lv_area_t inv_a = disp_refr->inv_areas[i];
-        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL ||
+           disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
             /*Calculate the max row num*/
             int32_t w = lv_area_get_width(&inv_a);
             int32_t h = lv_area_get_height(&inv_a);
@@ -672,8 +885,9 @@ static void refr_area(const lv_area_t * area_p, int32_t y_offset)
         layer_reshape_draw_buf(layer, layer->draw_buf->header.stride);
 
     }
-    else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /*In partial mode render this area to the buffer*/
+    else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL ||
+            disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /*In partial and tiled mode render this area to the buffer*/
         layer->buf_area = *area_p;
         layer_reshape_draw_buf(layer, LV_STRIDE_AUTO);
     }
@@ -834,14 +1048,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     if(lv_area_is_in(area_p, &obj->coords, 0) == false) return NULL;
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return NULL;
     if(lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return NULL;
-    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return NULL;
 
     /*If this object is fully cover the draw area then check the children too*/
-    lv_cover_check_info_t info;
-    info.res = LV_COVER_RES_COVER;
-    info.area = area_p;
-    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
-    if(info.res == LV_COVER_RES_MASKED) return NULL;
+    lv_cover_res_t cover_res = obj_cover_check(obj, area_p);
+    if(cover_res == LV_COVER_RES_MASKED) return NULL;
 
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_count(obj);
@@ -856,13 +1066,79 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     }
 
     /*If no better children use this object*/
-    if(found_p == NULL && info.res == LV_COVER_RES_COVER) {
+    if(found_p == NULL && cover_res == LV_COVER_RES_COVER) {
         found_p = obj;
     }
 
     return found_p;
 }
 
+/**
+ * Check if an object covers an area.
+ * With `LV_OBJ_COVER_CACHE` the result is checked once on the inner area of the object
+ * and reused for all areas in it until the object is invalidated.
+ * @param obj       pointer to an object
+ * @param area_p    the area to check
+ * @return          `LV_COVER_RES_MASKED` also if the object is transparent,
+ *                  so its children can't cover the area either
+ */
+static lv_cover_res_t obj_cover_check(lv_obj_t * obj, const lv_area_t * area_p)
+{
+    lv_cover_check_info_t info;
+
+#if LV_OBJ_COVER_CACHE
+    if(obj->cover_cache == LV_OBJ_COVER_CACHE_UNKNOWN) {
+        if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) {
+            obj->cover_cache = LV_OBJ_COVER_CACHE_SKIP;
+        }
+        else {
+            /*Check the largest rectangle which is in the object even with the largest radius.
+             *If it's covered, every area in it is covered too.*/
+            int32_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+            int32_t r_max = LV_MIN(lv_area_get_width(&obj->coords), lv_area_get_height(&obj->coords)) / 2;
+            r = LV_MIN(r, r_max);
+
+            lv_area_t inner;
+            lv_area_copy(&inner, &obj->coords);
+            lv_area_increase(&inner, -r, -r);
+
+            /*Keep the cache unknown if the inner area is too small to be useful*/
+            if(r <= UINT16_MAX && inner.x1 <= inner.x2 && inner.y1 <= inner.y2) {
+                info.res = LV_COVER_RES_COVER;
+                info.area = &inner;
+                lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+
+                obj->cover_inset = (uint16_t)r;
+                if(info.res == LV_COVER_RES_COVER) obj->cover_cache = LV_OBJ_COVER_CACHE_COVER;
+                else if(info.res == LV_COVER_RES_MASKED) obj->cover_cache = LV_OBJ_COVER_CACHE_SKIP;
+                else obj->cover_cache = LV_OBJ_COVER_CACHE_NOT_COVER;
+            }
+        }
+    }
+
+    if(obj->cover_cache == LV_OBJ_COVER_CACHE_SKIP) return LV_COVER_RES_MASKED;
+    /*Not covering the inner area means mostly a transparent background. In the rare case
+     *when only a part of the inner area is covered (e.g. a scaled image) the parent is
+     *used as top object instead, which is slower but still correct.*/
+    if(obj->cover_cache == LV_OBJ_COVER_CACHE_NOT_COVER) return LV_COVER_RES_NOT_COVER;
+    if(obj->cover_cache == LV_OBJ_COVER_CACHE_COVER) {
+        int32_t inset = obj->cover_inset;
+        if(area_p->x1 >= obj->coords.x1 + inset && area_p->x2 <= obj->coords.x2 - inset &&
+           area_p->y1 >= obj->coords.y1 + inset && area_p->y2 <= obj->coords.y2 - inset) {
+            return LV_COVER_RES_COVER;
+        }
+    }
+#endif
+
+    /*The area reaches into the rounded corners or it's not cached, ask the object*/
+    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return LV_COVER_RES_MASKED;
+
+    info.res = LV_COVER_RES_COVER;
+    info.area = area_p;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res;
+}
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -971,11 +1247,7 @@ static bool alpha_test_area_on_obj(lv_obj_t * obj, const lv_area_t * area)
     /*If the layer area is not fully on the object, it can't fully cover it*/
     if(!lv_area_is_on(area, &obj->coords)) return true;
 
-    lv_cover_check_info_t info;
-    info.res = LV_COVER_RES_COVER;
-    info.area = area;
-    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
-    if(info.res == LV_COVER_RES_COVER) return false;
+    if(obj_cover_check(obj, area) == LV_COVER_RES_COVER) return false;
     else return true;
 }
 
@@ -46,6 +46,12 @@ void lv_refr_deinit(void);
  */
 void lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Forget the invalidated areas of a display without any checks
+ * @param disp pointer to a display
+ */
+void lv_refr_reset_inv_areas(lv_display_t * disp);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -96,6 +96,20 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->layer_head->buf_area.y2 = ver_res - 1;
     disp->layer_head->color_format = disp->color_format;
 
+    disp->inv_areas = lv_malloc(LV_INV_BUF_SIZE * sizeof(lv_area_t));
+    disp->inv_area_joined = lv_malloc_zeroed(LV_INV_BUF_SIZE);
+    LV_ASSERT_MALLOC(disp->inv_areas);
+    LV_ASSERT_MALLOC(disp->inv_area_joined);
+    if(disp->inv_areas == NULL || disp->inv_area_joined == NULL) {
+        lv_free(disp->inv_areas);
+        lv_free(disp->inv_area_joined);
+        lv_free(disp->layer_head);
+        lv_ll_remove(disp_ll_p, disp);
+        lv_free(disp);
+        return NULL;
+    }
+    disp->inv_area_cap = LV_INV_BUF_SIZE;
+
     disp->inv_en_cnt = 1;
     disp->last_activity_time = lv_tick_get();
 
@@ -206,6 +220,9 @@ void lv_display_delete(lv_display_t * disp)
     }
 
     lv_ll_clear(&disp->sync_areas);
+    lv_free(disp->inv_areas);
+    lv_free(disp->inv_area_joined);
+    lv_free(disp->inv_tiles);
     lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
@@ -436,8 +453,8 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
     LV_ASSERT_FORMAT_MSG(buf2 == NULL || buf2 == lv_draw_buf_align(buf2, cf), "buf2 is not aligned: %p", buf2);
 
     uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
-    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* for partial mode, we calculate the height based on the buf_size and stride */
+    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for partial and tiled mode, we calculate the height based on the buf_size and stride */
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
@@ -461,8 +478,8 @@ void lv_display_set_buffers_with_stride(lv_display_t * disp, void * buf1, void *
     uint32_t h = lv_display_get_vertical_resolution(disp);
     LV_ASSERT_MSG(w != 0 && h != 0, "display resolution is 0");
 
-    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* for partial mode, we calculate the height based on the buf_size and stride */
+    if(render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || render_mode == LV_DISPLAY_RENDER_MODE_TILED) {
+        /* for partial and tiled mode, we calculate the height based on the buf_size and stride */
         h = buf_size / stride;
         LV_ASSERT_MSG(h != 0, "the buffer is too small");
     }
@@ -1123,9 +1140,7 @@ static void update_resolution(lv_display_t * disp)
     lv_area_set_height(&disp->bottom_layer->coords, ver_res);
     lv_obj_send_event(disp->bottom_layer, LV_EVENT_SIZE_CHANGED, &prev_coords);
 
-    lv_memzero(disp->inv_areas, sizeof(disp->inv_areas));
-    lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
-    disp->inv_p = 0;
+    lv_refr_reset_inv_areas(disp);
     lv_obj_invalidate(disp->sys_layer);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -57,6 +57,13 @@ typedef enum {
      * With 2 buffers in flush_cb only an address change is required.
      */
     LV_DISPLAY_RENDER_MODE_FULL,
+
+    /**
+     * Like `LV_DISPLAY_RENDER_MODE_PARTIAL`, but the invalidated areas are marked on a grid of
+     * `LV_INV_TILE_SIZE` sized tiles, and only the marked tiles are rendered, in row spans which fit
+     * into the buffer(s). This way the overdraw of scattered updates is bounded by the tile size.
+     */
+    LV_DISPLAY_RENDER_MODE_TILED,
 } lv_display_render_mode_t;
 
 typedef enum {
@@ -234,7 +241,7 @@ int32_t lv_display_get_dpi(const lv_display_t * disp);
  * @param buf1              first buffer
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                             lv_display_render_mode_t render_mode);
@@ -249,7 +256,7 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
  * @param buf2              second buffer (can be `NULL`)
  * @param buf_size          buffer size in byte
  * @param stride            buffer stride in bytes
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_buffers_with_stride(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
                                         uint32_t stride, lv_display_render_mode_t render_mode);
@@ -267,7 +274,7 @@ void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_d
 /**
  * Set display render mode
  * @param disp              pointer to a display
- * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL
+ * @param render_mode       LV_DISPLAY_RENDER_MODE_PARTIAL/DIRECT/FULL/TILED
  */
 void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t render_mode);
 
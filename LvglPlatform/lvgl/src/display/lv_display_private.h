@@ -29,6 +29,14 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /**< Buffer size for invalid areas */
 #endif
 
+#ifndef LV_INV_TILE_SIZE
+#define LV_INV_TILE_SIZE 32 /**< Size of the tiles marking the invalid areas which don't fit into the buffer */
+#endif
+
+#ifndef LV_INV_TILE_JOIN_CNT
+#define LV_INV_TILE_JOIN_CNT 8 /**< Join the marked tiles to one area if at most this many unmarked tiles are added */
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -100,11 +108,20 @@ struct _lv_display_t {
     lv_color_format_t   color_format;
 
     /** Invalidated (marked to redraw) areas*/
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
+    lv_area_t * inv_areas;
+    uint8_t * inv_area_joined;
     uint32_t inv_p;
+    uint32_t inv_area_cap;          /**< Number of areas `inv_areas` and `inv_area_joined` have room for*/
     int32_t inv_en_cnt;
 
+    /** Invalidated areas after the first `LV_INV_BUF_SIZE` (all of them in tiled mode) are marked on a grid of
+     *  `LV_INV_TILE_SIZE` sized tiles, one byte per tile. 1: the tile needs to be redrawn*/
+    uint8_t * inv_tiles;
+    uint32_t inv_tile_cap;          /**< Number of tiles `inv_tiles` has room for*/
+    int32_t inv_tile_cols;
+    int32_t inv_tile_rows;
+    uint32_t inv_tiles_dirty : 1;   /**< 1: at least one tile is marked*/
+
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
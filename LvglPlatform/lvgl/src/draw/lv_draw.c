@@ -13,6 +13,13 @@
 #include "../misc/lv_area_private.h"
 #include "../misc/lv_assert.h"
 #include "lv_draw_private.h"
+#include "lv_draw_rect.h"
+#include "lv_draw_label.h"
+#include "lv_draw_image.h"
+#include "lv_draw_line.h"
+#include "lv_draw_arc.h"
+#include "lv_draw_triangle.h"
+#include "lv_draw_mask_private.h"
 #include "sw/lv_draw_sw.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
@@ -28,12 +35,32 @@
  *      TYPEDEFS
  **********************/
 
+/*A draw task with room for the draw descriptors of the built-in draw tasks*/
+typedef struct {
+    lv_draw_task_t task;
+    union {
+        lv_draw_fill_dsc_t fill;
+        lv_draw_border_dsc_t border;
+        lv_draw_box_shadow_dsc_t box_shadow;
+        lv_draw_label_dsc_t label;
+        lv_draw_letter_dsc_t letter;
+        lv_draw_image_dsc_t image;
+        lv_draw_line_dsc_t line;
+        lv_draw_arc_dsc_t arc;
+        lv_draw_triangle_dsc_t triangle;
+        lv_draw_mask_rect_dsc_t mask_rect;
+    } dsc;
+} draw_task_block_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
 static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
+static void release_dependents(lv_draw_task_t * t);
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer);
+static lv_draw_task_t * task_alloc(void);
+static void task_free(lv_draw_task_t * t);
 
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -76,6 +103,13 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+    while(_draw_info.task_pool) {
+        lv_draw_task_t * t = _draw_info.task_pool;
+        _draw_info.task_pool = t->next;
+        lv_free(t);
+    }
+    _draw_info.task_pool_cnt = 0;
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -95,8 +129,7 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_DRAW_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
-    LV_ASSERT_MALLOC(new_task);
+    lv_draw_task_t * new_task = task_alloc();
     new_task->area = *coords;
     new_task->_real_area = *coords;
     new_task->target_layer = layer;
@@ -106,21 +139,29 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 #endif
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
+    /*Append to the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        layer->draw_task_tail->next = new_task;
     }
+    layer->draw_task_tail = new_task;
 
     LV_PROFILER_DRAW_END;
     return new_task;
 }
 
+void * lv_draw_task_alloc_draw_dsc(lv_draw_task_t * t, size_t size)
+{
+    draw_task_block_t * block = (draw_task_block_t *)t;
+    if(size <= sizeof(block->dsc)) return &block->dsc;
+
+    void * dsc = lv_malloc(size);
+    LV_ASSERT_MALLOC(dsc);
+    return dsc;
+}
+
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_DRAW_BEGIN;
@@ -233,12 +274,15 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
     while(t) {
         t_next = t->next;
         if(t->state == LV_DRAW_TASK_STATE_READY) {
+            release_dependents(t);
             cleanup_task(t, disp);
             remove_task = true;
             if(t_prev != NULL)
                 t_prev->next = t_next;
             else
                 layer->draw_task_head = t_next;
+
+            if(layer->draw_task_tail == t) layer->draw_task_tail = t_prev;
         }
         else {
             t_prev = t;
@@ -518,25 +562,76 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
  */
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
 {
+    if(t_check->dep_independent) return true;
+
+    /*Still waiting for the same task*/
+    lv_draw_task_t * blocker = t_check->dep_blocker;
+    if(blocker && blocker->state != LV_DRAW_TASK_STATE_READY) return false;
+
     LV_PROFILER_DRAW_BEGIN;
+
+    /*Continue where the previous check stopped, the older tasks before that don't overlap.
+     *So every older task is compared only once, no matter how many times the task is checked.*/
     lv_draw_task_t * t = layer->draw_task_head;
+    if(blocker) {
+        t = blocker->next;
+        blocker->dep_ref_cnt--;
+        t_check->dep_blocker = NULL;
+    }
+    else if(t_check->dep_scan) {
+        t = t_check->dep_scan;
+        t->dep_ref_cnt--;
+        t_check->dep_scan = NULL;
+    }
 
-    /*If t_check is outside of the older tasks then it's independent*/
     while(t && t != t_check) {
         if(t->state != LV_DRAW_TASK_STATE_READY) {
             lv_area_t a;
             if(lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
+                t_check->dep_blocker = t;
+                t->dep_ref_cnt++;
                 LV_PROFILER_DRAW_END;
                 return false;
             }
         }
         t = t->next;
     }
+    t_check->dep_independent = 1;
     LV_PROFILER_DRAW_END;
 
     return true;
 }
 
+/**
+ * Let the newer tasks which wait for a finished task continue checking after it
+ * @param t         pointer to a finished draw task which is being removed from its layer
+ */
+static void release_dependents(lv_draw_task_t * t)
+{
+    /*It's not waiting anymore (e.g. it was taken without checking)*/
+    if(t->dep_blocker) t->dep_blocker->dep_ref_cnt--;
+    if(t->dep_scan) t->dep_scan->dep_ref_cnt--;
+
+    lv_draw_task_t * t_dep = t->next;
+    while(t_dep && t->dep_ref_cnt) {
+        if(t_dep->dep_blocker == t || t_dep->dep_scan == t) {
+            t_dep->dep_blocker = NULL;
+            t_dep->dep_scan = NULL;
+            t->dep_ref_cnt--;
+
+            /*Continue with the next task, unless it's the waiting task itself*/
+            if(t->next == t_dep) {
+                t_dep->dep_independent = 1;
+            }
+            else {
+                t_dep->dep_scan = t->next;
+                t->next->dep_ref_cnt++;
+            }
+        }
+        t_dep = t_dep->next;
+    }
+}
+
 /**
  * Clean-up resources allocated by a finished task
  * @param t         pointer to a draw task
@@ -591,11 +686,47 @@ static void cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
         draw_label_dsc->text = NULL;
     }
 
-    lv_free(t->draw_dsc);
-    lv_free(t);
+    if(t->draw_dsc != &((draw_task_block_t *)t)->dsc) lv_free(t->draw_dsc);
+    task_free(t);
     LV_PROFILER_DRAW_END;
 }
 
+/**
+ * Get a draw task from the pool of finished ones or allocate a new one
+ * @return      pointer to a zeroed draw task
+ */
+static lv_draw_task_t * task_alloc(void)
+{
+    lv_draw_task_t * t = _draw_info.task_pool;
+    if(t) {
+        _draw_info.task_pool = t->next;
+        _draw_info.task_pool_cnt--;
+    }
+    else {
+        t = lv_malloc(sizeof(draw_task_block_t));
+        LV_ASSERT_MALLOC(t);
+    }
+
+    lv_memzero(t, sizeof(lv_draw_task_t));
+    return t;
+}
+
+/**
+ * Put a finished draw task into the pool for reuse, or free it if the pool is full
+ * @param t     pointer to a draw task
+ */
+static void task_free(lv_draw_task_t * t)
+{
+    if(_draw_info.task_pool_cnt >= LV_DRAW_TASK_POOL_CNT) {
+        lv_free(t);
+        return;
+    }
+
+    t->next = _draw_info.task_pool;
+    _draw_info.task_pool = t;
+    _draw_info.task_pool_cnt++;
+}
+
 static lv_draw_task_t * get_first_available_task(lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
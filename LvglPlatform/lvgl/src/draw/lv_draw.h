@@ -110,6 +110,9 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** The last draw task, valid if `draw_task_head` is set*/
+    lv_draw_task_t * draw_task_tail;
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
@@ -169,6 +172,16 @@ void * lv_draw_create_unit(size_t size);
  */
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
+/**
+ * Allocate memory for the draw descriptor of a draw task created by `lv_draw_add_task`.
+ * The draw descriptors of the built-in draw tasks fit into the draw task itself,
+ * larger ones are allocated. The memory is freed with the draw task.
+ * @param t         pointer to a draw task
+ * @param size      size of the draw descriptor
+ * @return          pointer to the memory for the draw descriptor
+ */
+void * lv_draw_task_alloc_draw_dsc(lv_draw_task_t * t, size_t size);
+
 /**
  * Needs to be called when a draw task is created and configured.
  * It will send an event about the new draw task to the widget
@@ -43,6 +43,10 @@ typedef unsigned char cmd_state_t;
  *  STATIC PROTOTYPES
  **********************/
 static uint8_t hex_char_to_num(char hex);
+static bool lines_match(const lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t width);
+static lv_result_t lines_push(lv_array_t * array, const lv_draw_label_line_t * line);
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_lines_t * lines, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end);
 
 /**********************
  *  STATIC VARIABLES
@@ -110,7 +114,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_layer_t * layer, const lv_draw_label
     LV_PROFILER_DRAW_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LABEL;
@@ -193,7 +197,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_letter(lv_layer_t * layer, lv_draw_letter_dsc
 
     lv_draw_task_t * t = lv_draw_add_task(layer, &a);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LETTER;
@@ -202,6 +206,75 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_letter(lv_layer_t * layer, lv_draw_letter_dsc
     LV_PROFILER_DRAW_END;
 }
 
+void lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t width)
+{
+    LV_ASSERT_NULL(lines);
+    LV_ASSERT_NULL(dsc);
+
+    if(lines_match(lines, dsc, width)) return;
+    if(dsc->text == NULL || dsc->font == NULL) return;
+
+    LV_PROFILER_DRAW_BEGIN;
+
+    lines->valid = 0;
+    if(lines->lines.data == NULL) {
+        lv_array_init(&lines->lines, LV_ARRAY_DEFAULT_CAPACITY, sizeof(lv_draw_label_line_t));
+        if(lines->lines.data == NULL) {
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+    }
+    lv_array_clear(&lines->lines);
+
+    /*Break the lines the same way as `lv_draw_label_iterate_characters` does*/
+    const char * text = dsc->text;
+    uint32_t remaining_len = dsc->text_length;
+    lv_draw_label_line_t line = {0, 0};
+    while(remaining_len && text[line.start] != '\0') {
+        uint32_t line_len = lv_text_get_next_line(&text[line.start], remaining_len, dsc->font, dsc->letter_space, width,
+                                                  NULL, dsc->flag);
+        if(line_len == 0) break;
+        line.width = lv_text_get_width_with_flags(&text[line.start], line_len, dsc->font, dsc->letter_space, dsc->flag);
+        if(lines_push(&lines->lines, &line) != LV_RESULT_OK) {
+            LV_PROFILER_DRAW_END;
+            return;
+        }
+
+        line.start += line_len;
+        remaining_len -= line_len;
+    }
+
+    /*Closing entry to get the end of the last line*/
+    line.width = 0;
+    if(lines_push(&lines->lines, &line) != LV_RESULT_OK) {
+        LV_PROFILER_DRAW_END;
+        return;
+    }
+
+    lines->text = dsc->text;
+    lines->font = dsc->font;
+    lines->text_length = dsc->text_length;
+    lines->letter_space = dsc->letter_space;
+    lines->width = width;
+    lines->flag = dsc->flag;
+    lines->valid = 1;
+
+    LV_PROFILER_DRAW_END;
+}
+
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines)
+{
+    LV_ASSERT_NULL(lines);
+    lines->valid = 0;
+}
+
+void lv_draw_label_lines_deinit(lv_draw_label_lines_t * lines)
+{
+    LV_ASSERT_NULL(lines);
+    lv_array_deinit(&lines->lines);
+    lines->valid = 0;
+}
+
 void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_dsc_t * dsc,
                                       const lv_area_t * coords,
                                       lv_draw_glyph_cb_t cb)
@@ -218,8 +291,12 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     lv_bidi_calculate_align(&align, &base_dir, dsc->text);
 
-    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
-        /*Normally use the label's width as width*/
+    /*Use the stored lines only if they were made for this text and width*/
+    const lv_draw_label_lines_t * lines = dsc->lines;
+    if(lines && !lines_match(lines, dsc, lv_area_get_width(coords))) lines = NULL;
+
+    if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0 || lines) {
+        /*Normally use the label's width as width. (The stored lines don't need the width)*/
         w = lv_area_get_width(coords);
     }
     else {
@@ -248,7 +325,7 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     int32_t last_line_start = -1;
 
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    if(lines == NULL && dsc->hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -263,12 +340,30 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
     }
 
     uint32_t remaining_len = dsc->text_length;
+    uint32_t line_end;
+    uint32_t line_idx = 0;
+    uint32_t line_cnt = 0;
+
+    if(lines) {
+        /*Go the first visible line. The last entry only tells the end of the text*/
+        line_cnt = lv_array_size(&lines->lines) - 1;
+        while(line_idx < line_cnt && pos.y + line_height_font < t->clip_area.y1) {
+            line_idx++;
+            pos.y += line_height;
+        }
+        if(line_idx >= line_cnt) return;
 
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
-                                                           w, NULL, dsc->flag);
+        line_start = ((lv_draw_label_line_t *)lv_array_at(&lines->lines, line_idx))->start;
+        line_end = ((lv_draw_label_line_t *)lv_array_at(&lines->lines, line_idx + 1))->start;
+        remaining_len -= line_start;
+    }
+    else {
+        line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
+                                                      w, NULL, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < t->clip_area.y1) {
+    while(lines == NULL && pos.y + line_height_font < t->clip_area.y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
@@ -286,16 +381,14 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
+        line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space,
-                                                  dsc->flag);
+        line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -514,22 +607,25 @@ void lv_draw_label_iterate_characters(lv_draw_task_t * t, const lv_draw_label_ds
         /*Go to next line*/
         remaining_len -= line_end - line_start;
         line_start = line_end;
-        if(remaining_len) {
+        if(lines) {
+            line_idx++;
+            if(line_idx >= line_cnt) break;
+            line_end = ((lv_draw_label_line_t *)lv_array_at(&lines->lines, line_idx + 1))->start;
+        }
+        else if(remaining_len) {
             line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
         }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(dsc, lines, line_idx, line_start, line_end);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -635,3 +731,33 @@ void lv_draw_unit_draw_letter(lv_draw_task_t * t, lv_draw_glyph_dsc_t * dsc,  co
 
     LV_PROFILER_DRAW_END;
 }
+
+static bool lines_match(const lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t width)
+{
+    return lines->valid &&
+           lines->text == dsc->text &&
+           lines->font == dsc->font &&
+           lines->text_length == dsc->text_length &&
+           lines->letter_space == dsc->letter_space &&
+           lines->width == width &&
+           lines->flag == dsc->flag;
+}
+
+static lv_result_t lines_push(lv_array_t * array, const lv_draw_label_line_t * line)
+{
+    /*Grow exponentially, long texts have many lines*/
+    if(lv_array_is_full(array) && !lv_array_resize(array, lv_array_capacity(array) * 2)) {
+        return LV_RESULT_INVALID;
+    }
+
+    return lv_array_push_back(array, line);
+}
+
+static int32_t get_line_width(const lv_draw_label_dsc_t * dsc, const lv_draw_label_lines_t * lines, uint32_t line_idx,
+                              uint32_t line_start, uint32_t line_end)
+{
+    if(lines) return ((lv_draw_label_line_t *)lv_array_at(&lines->lines, line_idx))->width;
+
+    return lv_text_get_width_with_flags(&dsc->text[line_start], line_end - line_start, dsc->font, dsc->letter_space,
+                                        dsc->flag);
+}
@@ -101,6 +101,10 @@ typedef struct {
     /**Pointer to an externally stored struct where some data can be cached to speed up rendering*/
     lv_draw_label_hint_t * hint;
 
+    /**Line breaks and widths of `text` made by `lv_draw_label_lines_update()`.
+     * Used instead of measuring the text if they were made for the same text, font and width.*/
+    const lv_draw_label_lines_t * lines;
+
     /* Properties of the letter outlines */
     lv_opa_t outline_stroke_opa;
     lv_color_t outline_stroke_color;
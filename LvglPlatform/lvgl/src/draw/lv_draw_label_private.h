@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_draw_label.h"
+#include "../misc/lv_array.h"
 
 /*********************
  *      DEFINES
@@ -41,6 +42,32 @@ struct _lv_draw_label_hint_t {
     int32_t coord_y;
 };
 
+/** A line of a text in `lv_draw_label_lines_t`*/
+typedef struct {
+    uint32_t start;     /**< Byte index of the line's first character in the text*/
+    int32_t width;      /**< Width of the line in pixels*/
+} lv_draw_label_line_t;
+
+/** Line breaks and widths of a text.
+ * Breaking a text into lines requires measuring every letter before the visible lines
+ * and aligned lines are measured once more to get their width.
+ * An object whose text rarely changes can store the lines here and draw its text without measuring it.*/
+struct _lv_draw_label_lines_t {
+    /** `lv_draw_label_line_t` for each line and one more with the end of the text*/
+    lv_array_t lines;
+
+    /*The lines are valid only for these parameters*/
+    const char * text;
+    const lv_font_t * font;
+    uint32_t text_length;
+    int32_t letter_space;
+    int32_t width;
+    lv_text_flag_t flag;
+
+    /** 1: the lines belong to the parameters above; 0: they need to be made again*/
+    uint8_t valid : 1;
+};
+
 struct _lv_draw_glyph_dsc_t {
     const void *
     glyph_data;  /**< Depends on `format` field, it could be image source or draw buf of bitmap or vector data. */
@@ -63,6 +90,28 @@ struct _lv_draw_glyph_dsc_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Break the text of a label draw descriptor into lines and measure them,
+ * unless `lines` already belongs to the same text, font, letter space, flags and width.
+ * @param lines     pointer to a zero initialized or earlier used line store
+ * @param dsc       the label draw descriptor
+ * @param width     width of the area the text is drawn to
+ */
+void lv_draw_label_lines_update(lv_draw_label_lines_t * lines, const lv_draw_label_dsc_t * dsc, int32_t width);
+
+/**
+ * Mark the lines invalid, e.g. because the characters of the text have changed.
+ * The memory is kept to store the next lines.
+ * @param lines     pointer to a line store
+ */
+void lv_draw_label_lines_invalidate(lv_draw_label_lines_t * lines);
+
+/**
+ * Free the memory of a line store.
+ * @param lines     pointer to a line store
+ */
+void lv_draw_label_lines_deinit(lv_draw_label_lines_t * lines);
+
 /**********************
  *      MACROS
  **********************/
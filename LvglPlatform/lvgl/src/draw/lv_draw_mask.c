@@ -57,7 +57,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_mask_rect(lv_layer_t * layer, const lv_draw_m
 
     lv_draw_task_t * t = lv_draw_add_task(layer, &layer->buf_area);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_MASK_RECTANGLE;
@@ -81,6 +81,24 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * An older task in the layer which overlaps with this one, so this one needs to wait for it.
+     * Found when the task is checked for dispatching.
+     */
+    lv_draw_task_t * dep_blocker;
+
+    /**
+     * The older task where checking for overlaps should continue when `dep_blocker` is removed.
+     * The tasks before it don't overlap with this task. NULL: start from the first task.
+     */
+    lv_draw_task_t * dep_scan;
+
+    /** The number of newer tasks whose `dep_blocker` or `dep_scan` is this task*/
+    uint32_t dep_ref_cnt;
+
+    /** 1: none of the older tasks overlap with it anymore*/
+    uint8_t dep_independent;
+
 };
 
 struct _lv_draw_mask_t {
@@ -177,6 +195,8 @@ typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t unit_cnt;
     uint32_t used_memory_for_layers; /* measured as bytes */
+    lv_draw_task_t * task_pool;     /**< Finished draw tasks kept for reuse*/
+    uint32_t task_pool_cnt;
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
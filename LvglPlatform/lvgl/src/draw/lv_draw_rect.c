@@ -77,7 +77,7 @@ void lv_draw_fill(lv_layer_t * layer, const lv_draw_fill_dsc_t * dsc, const lv_a
     LV_PROFILER_DRAW_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_FILL;
@@ -106,7 +106,7 @@ void lv_draw_border(lv_layer_t * layer, const lv_draw_border_dsc_t * dsc, const
     LV_PROFILER_DRAW_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_BORDER;
@@ -134,7 +134,7 @@ void lv_draw_box_shadow(lv_layer_t * layer, const lv_draw_box_shadow_dsc_t * dsc
     LV_PROFILER_DRAW_BEGIN;
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(*dsc));
     LV_ASSERT_MALLOC(t->draw_dsc);
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_BOX_SHADOW;
@@ -196,7 +196,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
     if(has_shadow) {
         /*Check whether the shadow is visible*/
         t = lv_draw_add_task(layer, coords);
-        lv_draw_box_shadow_dsc_t * shadow_dsc = lv_malloc(sizeof(lv_draw_box_shadow_dsc_t));
+        lv_draw_box_shadow_dsc_t * shadow_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_box_shadow_dsc_t));
         LV_ASSERT_MALLOC(shadow_dsc);
         t->draw_dsc = shadow_dsc;
         lv_area_increase(&t->_real_area, dsc->shadow_spread, dsc->shadow_spread);
@@ -228,7 +228,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
         }
 
         t = lv_draw_add_task(layer, &bg_coords);
-        lv_draw_fill_dsc_t * bg_dsc = lv_malloc(sizeof(lv_draw_fill_dsc_t));
+        lv_draw_fill_dsc_t * bg_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_fill_dsc_t));
         LV_ASSERT_MALLOC(bg_dsc);
         lv_draw_fill_dsc_init(bg_dsc);
         t->draw_dsc = bg_dsc;
@@ -271,7 +271,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
                     t = lv_draw_add_task(layer, &a);
                 }
 
-                lv_draw_image_dsc_t * bg_image_dsc = lv_malloc(sizeof(lv_draw_image_dsc_t));
+                lv_draw_image_dsc_t * bg_image_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_image_dsc_t));
                 LV_ASSERT_MALLOC(bg_image_dsc);
                 lv_draw_image_dsc_init(bg_image_dsc);
                 t->draw_dsc = bg_image_dsc;
@@ -296,7 +296,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
                 lv_area_align(coords, &a, LV_ALIGN_CENTER, 0, 0);
                 t = lv_draw_add_task(layer, &a);
 
-                lv_draw_label_dsc_t * bg_label_dsc = lv_malloc(sizeof(lv_draw_label_dsc_t));
+                lv_draw_label_dsc_t * bg_label_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_label_dsc_t));
                 LV_ASSERT_MALLOC(bg_label_dsc);
                 lv_draw_label_dsc_init(bg_label_dsc);
                 t->draw_dsc = bg_label_dsc;
@@ -314,7 +314,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
     /*Border*/
     if(has_border) {
         t = lv_draw_add_task(layer, coords);
-        lv_draw_border_dsc_t * border_dsc = lv_malloc(sizeof(lv_draw_border_dsc_t));
+        lv_draw_border_dsc_t * border_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_border_dsc_t));
         LV_ASSERT_MALLOC(border_dsc);
         t->draw_dsc = border_dsc;
         border_dsc->base = dsc->base;
@@ -333,7 +333,7 @@ void lv_draw_rect(lv_layer_t * layer, const lv_draw_rect_dsc_t * dsc, const lv_a
         lv_area_t outline_coords = *coords;
         lv_area_increase(&outline_coords, dsc->outline_width + dsc->outline_pad, dsc->outline_width + dsc->outline_pad);
         t = lv_draw_add_task(layer, &outline_coords);
-        lv_draw_border_dsc_t * outline_dsc = lv_malloc(sizeof(lv_draw_border_dsc_t));
+        lv_draw_border_dsc_t * outline_dsc = lv_draw_task_alloc_draw_dsc(t, sizeof(lv_draw_border_dsc_t));
         LV_ASSERT_MALLOC(outline_dsc);
         t->draw_dsc = outline_dsc;
         lv_area_increase(&t->_real_area, dsc->outline_width, dsc->outline_width);
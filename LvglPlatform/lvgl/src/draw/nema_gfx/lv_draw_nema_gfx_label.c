@@ -849,6 +849,13 @@ static void _draw_letter(lv_draw_task_t * t, lv_draw_glyph_dsc_t * dsc,  const l
         nema_cl_wait(&(draw_nema_gfx_unit->cl));
         font->release_glyph(font, &g);
     }
+    else if(g.entry) {
+        /*The bitmap is in the glyph atlas, keep it until the GPU has read it*/
+        lv_draw_nema_gfx_unit_t * draw_nema_gfx_unit = (lv_draw_nema_gfx_unit_t *)t->draw_unit;
+        nema_cl_submit(&(draw_nema_gfx_unit->cl));
+        nema_cl_wait(&(draw_nema_gfx_unit->cl));
+        lv_font_glyph_release_draw_data(&g);
+    }
 
     LV_PROFILER_DRAW_END;
 }
@@ -0,0 +1,598 @@
+/**
+ * @file lv_blend_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_blend_sse2.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+
+#include "../../../../core/lv_global.h"
+#include "../../../../misc/lv_color.h"
+
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define isa_act LV_GLOBAL_DEFAULT()->draw_sw_blend_isa
+
+#if defined(_MSC_VER)
+    #define FORCE_INLINE __forceinline
+#else
+    #define FORCE_INLINE inline __attribute__((always_inline))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    SRC_COLOR,
+    SRC_ARGB8888,
+    SRC_XRGB8888,
+    SRC_RGB565,
+    SRC_RGB888,
+} blend_src_t;
+
+typedef enum {
+    DEST_ARGB8888,
+    DEST_XRGB8888,
+    DEST_RGB565,
+} blend_dest_t;
+
+typedef enum {
+    TRANSFORM_ARGB8888,
+    TRANSFORM_XRGB8888,
+    TRANSFORM_RGB888,
+    TRANSFORM_RGB565,
+    TRANSFORM_RGB565A8,
+} transform_src_t;
+
+/**
+ * The common parts of the fill and image descriptors
+ */
+typedef struct {
+    void * dest_buf;
+    int32_t dest_w;
+    int32_t dest_h;
+    int32_t dest_stride;
+    const void * src_buf;
+    int32_t src_stride;
+    uint32_t color;             /**< The fill color as ARGB8888, or RGB565 if drawn to RGB565*/
+    const lv_opa_t * mask_buf;
+    int32_t mask_stride;
+    lv_opa_t opa;
+} blend_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_result_t blend(const blend_dsc_t * dsc, blend_dest_t dest, blend_src_t src);
+static void fill_dsc_init(blend_dsc_t * bd, const lv_draw_sw_blend_fill_dsc_t * dsc);
+static void image_dsc_init(blend_dsc_t * bd, const lv_draw_sw_blend_image_dsc_t * dsc);
+static lv_result_t transform(const lv_draw_sw_transform_row_dsc_t * dsc, transform_src_t src);
+static lv_blend_sse2_isa_t get_cpu_isa(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_blend_sse2_init(void)
+{
+    isa_act = get_cpu_isa();
+}
+
+void lv_blend_sse2_set_isa(lv_blend_sse2_isa_t isa)
+{
+    lv_blend_sse2_isa_t cpu_isa = get_cpu_isa();
+    isa_act = isa > cpu_isa ? cpu_isa : isa;
+}
+
+lv_blend_sse2_isa_t lv_blend_sse2_get_isa(void)
+{
+    return isa_act;
+}
+
+lv_result_t lv_color_blend_to_rgb565_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_dsc_t bd;
+    fill_dsc_init(&bd, dsc);
+    bd.color = lv_color_to_u16(dsc->color);
+    return blend(&bd, DEST_RGB565, SRC_COLOR);
+}
+
+lv_result_t lv_color_blend_to_rgb888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_dsc_t bd;
+    fill_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_XRGB8888, SRC_COLOR);
+}
+
+lv_result_t lv_color_blend_to_argb8888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_dsc_t bd;
+    fill_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_ARGB8888, SRC_COLOR);
+}
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    /*A plain copy is done by `lv_memcpy`*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_RGB565, SRC_RGB565);
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_RGB565, SRC_ARGB8888);
+}
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                  uint32_t src_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    if(src_px_size == 3) return blend(&bd, DEST_XRGB8888, SRC_RGB888);
+
+    /*A plain copy of XRGB8888 pixels is done by `lv_memcpy`*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+    return blend(&bd, DEST_XRGB8888, SRC_XRGB8888);
+}
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_XRGB8888, SRC_ARGB8888);
+}
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    if(src_px_size == 3) return blend(&bd, DEST_ARGB8888, SRC_RGB888);
+
+    /*A plain copy of XRGB8888 pixels is done by `lv_memcpy`*/
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+    return blend(&bd, DEST_ARGB8888, SRC_XRGB8888);
+}
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_sse2(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_dsc_t bd;
+    image_dsc_init(&bd, dsc);
+    return blend(&bd, DEST_ARGB8888, SRC_ARGB8888);
+}
+
+lv_result_t lv_transform_argb8888_sse2(const lv_draw_sw_transform_row_dsc_t * dsc)
+{
+    return transform(dsc, TRANSFORM_ARGB8888);
+}
+
+lv_result_t lv_transform_rgb888_sse2(const lv_draw_sw_transform_row_dsc_t * dsc, uint32_t src_px_size)
+{
+    return transform(dsc, src_px_size == 3 ? TRANSFORM_RGB888 : TRANSFORM_XRGB8888);
+}
+
+lv_result_t lv_transform_rgb565a8_sse2(const lv_draw_sw_transform_row_dsc_t * dsc, bool src_has_a8)
+{
+    return transform(dsc, src_has_a8 ? TRANSFORM_RGB565A8 : TRANSFORM_RGB565);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/*The pixel by pixel parts, with the same results as the C implementation*/
+
+static FORCE_INLINE lv_opa_t px_opa(blend_src_t src, uint32_t fg, lv_opa_t opa, lv_opa_t mask,
+                                    bool has_opa, bool has_mask)
+{
+    if(src == SRC_ARGB8888) {
+        lv_opa_t a = fg >> 24;
+        if(has_opa && has_mask) return LV_OPA_MIX3(a, opa, mask);
+        else if(has_opa) return LV_OPA_MIX2(a, opa);
+        else if(has_mask) return LV_OPA_MIX2(a, mask);
+        else return a;
+    }
+    else {
+        if(has_opa && has_mask) return LV_OPA_MIX2(mask, opa);
+        else if(has_opa) return opa;
+        else return mask;
+    }
+}
+
+static FORCE_INLINE uint32_t blend_argb8888_px(uint32_t fg, uint32_t bg)
+{
+    lv_color32_t fg_c = {.blue = fg & 0xFF, .green = (fg >> 8) & 0xFF, .red = (fg >> 16) & 0xFF, .alpha = fg >> 24};
+    lv_color32_t bg_c = {.blue = bg & 0xFF, .green = (bg >> 8) & 0xFF, .red = (bg >> 16) & 0xFF, .alpha = bg >> 24};
+    lv_color32_t res = lv_color_over32(fg_c, bg_c);
+    return ((uint32_t)res.alpha << 24) | ((uint32_t)res.red << 16) | ((uint32_t)res.green << 8) | res.blue;
+}
+
+static FORCE_INLINE uint16_t blend_argb8888_to_rgb565_px(uint32_t fg, uint16_t bg, lv_opa_t mix)
+{
+    if(mix == 0) return bg;
+
+    uint32_t r = (fg >> 16) & 0xFF;
+    uint32_t g = (fg >> 8) & 0xFF;
+    uint32_t b = fg & 0xFF;
+    if(mix == 255) return ((r & 0xF8) << 8) + ((g & 0xFC) << 3) + ((b & 0xF8) >> 3);
+
+    lv_opa_t mix_inv = 255 - mix;
+    return ((((r >> 3) * mix + ((bg >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((g >> 2) * mix + ((bg >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((b >> 3) * mix + (bg & 0x1F) * mix_inv) >> 8);
+}
+
+static FORCE_INLINE void blend_px(blend_dest_t dest, blend_src_t src, uint8_t * dest_row, int32_t x, uint32_t fg,
+                                  lv_opa_t a)
+{
+    if(dest == DEST_ARGB8888) {
+        uint32_t * dest_px = (uint32_t *)dest_row + x;
+        *dest_px = blend_argb8888_px((fg & 0x00FFFFFF) | ((uint32_t)a << 24), *dest_px);
+    }
+    else if(dest == DEST_XRGB8888) {
+        uint8_t * dest_px = dest_row + x * 4;
+        if(a == 0) return;
+
+        uint32_t i;
+        for(i = 0; i < 3; i++) {
+            uint32_t c = (fg >> (i * 8)) & 0xFF;
+            dest_px[i] = a >= LV_OPA_MAX ? c : (c * a + dest_px[i] * (255 - a)) >> 8;
+        }
+    }
+    else {
+        uint16_t * dest_px = (uint16_t *)dest_row + x;
+        if(src == SRC_ARGB8888) *dest_px = blend_argb8888_to_rgb565_px(fg, *dest_px, a);
+        else *dest_px = lv_color_16_16_mix((uint16_t)fg, *dest_px, a);
+    }
+}
+
+/*SSE2: 4 pixels at once*/
+
+#define FN(name)                name##_sse2
+#define TARGET
+#define vec_t                   __m128i
+#define PX                      4
+#define V_LOAD(p)               _mm_loadu_si128((const __m128i *)(p))
+#define V_STORE(p, v)           _mm_storeu_si128((__m128i *)(p), v)
+#define V_ZERO()                _mm_setzero_si128()
+#define V_SET1_16(x)            _mm_set1_epi16((int16_t)(x))
+#define V_SET1_32(x)            _mm_set1_epi32((int32_t)(x))
+#define V_AND(a, b)             _mm_and_si128(a, b)
+#define V_OR(a, b)              _mm_or_si128(a, b)
+#define V_ANDNOT(a, b)          _mm_andnot_si128(a, b)
+#define V_ADD16(a, b)           _mm_add_epi16(a, b)
+#define V_SUB16(a, b)           _mm_sub_epi16(a, b)
+#define V_ADD32(a, b)           _mm_add_epi32(a, b)
+#define V_SUB32(a, b)           _mm_sub_epi32(a, b)
+#define V_MULLO16(a, b)         _mm_mullo_epi16(a, b)
+#define V_MULHI16(a, b)         _mm_mulhi_epu16(a, b)
+#define V_SRLI16(a, n)          _mm_srli_epi16(a, n)
+#define V_SLLI32(a, n)          _mm_slli_epi32(a, n)
+#define V_SRLI32(a, n)          _mm_srli_epi32(a, n)
+#define V_SRAI32(a, n)          _mm_srai_epi32(a, n)
+#define V_MUL32_U16(a, b)       mul32_u16_sse2(a, b)
+#define V_CMPEQ32(a, b)         _mm_cmpeq_epi32(a, b)
+#define V_CMPGT32(a, b)         _mm_cmpgt_epi32(a, b)
+#define V_UNPACKLO8(a, b)       _mm_unpacklo_epi8(a, b)
+#define V_UNPACKHI8(a, b)       _mm_unpackhi_epi8(a, b)
+#define V_UNPACKLO32(a, b)      _mm_unpacklo_epi32(a, b)
+#define V_UNPACKHI32(a, b)      _mm_unpackhi_epi32(a, b)
+#define V_PACKUS16(a, b)        _mm_packus_epi16(a, b)
+#define V_MOVEMASK8(a)          _mm_movemask_epi8(a)
+
+static FORCE_INLINE __m128i load_mask_sse2(const lv_opa_t * mask)
+{
+    uint32_t m = mask[0] | ((uint32_t)mask[1] << 8) | ((uint32_t)mask[2] << 16) | ((uint32_t)mask[3] << 24);
+    __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int32_t)m), zero), zero);
+}
+
+static FORCE_INLINE __m128i load_rgb565_sse2(const uint16_t * px)
+{
+    return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)px), _mm_setzero_si128());
+}
+
+/*Only the 12 bytes of the 4 pixels are read, as they can be at the end of the buffer*/
+static FORCE_INLINE __m128i load_rgb888_sse2(const uint8_t * px)
+{
+    __m128i lo = _mm_loadl_epi64((const __m128i *)px);
+    __m128i hi = _mm_cvtsi32_si128(*(const int32_t *)(px + 8));
+    __m128i px01 = _mm_unpacklo_epi32(lo, _mm_srli_epi64(lo, 24));
+    __m128i px23 = _mm_unpacklo_epi32(_mm_or_si128(_mm_srli_epi64(lo, 48), _mm_slli_epi64(hi, 16)),
+                                      _mm_srli_epi32(hi, 8));
+    return _mm_and_si128(_mm_unpacklo_epi64(px01, px23), _mm_set1_epi32(0x00FFFFFF));
+}
+
+static FORCE_INLINE void store_rgb565_sse2(uint16_t * px, __m128i v)
+{
+    /*Sign extend the lower 16 bits to not saturate when packing*/
+    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+    _mm_storel_epi64((__m128i *)px, _mm_packs_epi32(v, v));
+}
+
+static FORCE_INLINE void store_a8_sse2(uint8_t * px, __m128i v)
+{
+    v = _mm_packs_epi32(v, v);
+    uint32_t a = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+    px[0] = (uint8_t)a;
+    px[1] = (uint8_t)(a >> 8);
+    px[2] = (uint8_t)(a >> 16);
+    px[3] = (uint8_t)(a >> 24);
+}
+
+/*32 bit multiplication from 16 bit ones as SSE2 has no `mullo_epi32`*/
+static FORCE_INLINE __m128i mul32_u16_sse2(__m128i a, __m128i b)
+{
+    __m128i b2 = _mm_or_si128(b, _mm_slli_epi32(b, 16));
+    return _mm_add_epi32(_mm_mullo_epi16(a, b2), _mm_slli_epi32(_mm_mulhi_epu16(a, b2), 16));
+}
+
+/*SSE2 has no gather instruction, load the pixels one by one*/
+static FORCE_INLINE __m128i gather32_sse2(const uint8_t * base, __m128i ofs)
+{
+    int32_t ofs_arr[4];
+    _mm_storeu_si128((__m128i *)ofs_arr, ofs);
+    return _mm_set_epi32(*(const int32_t *)(base + ofs_arr[3]), *(const int32_t *)(base + ofs_arr[2]),
+                         *(const int32_t *)(base + ofs_arr[1]), *(const int32_t *)(base + ofs_arr[0]));
+}
+
+#include "lv_blend_sse2_template.h"
+#include "lv_transform_sse2_template.h"
+
+#undef FN
+#undef TARGET
+#undef vec_t
+#undef PX
+#undef V_LOAD
+#undef V_STORE
+#undef V_ZERO
+#undef V_SET1_16
+#undef V_SET1_32
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ADD16
+#undef V_SUB16
+#undef V_ADD32
+#undef V_SUB32
+#undef V_MULLO16
+#undef V_MULHI16
+#undef V_SRLI16
+#undef V_SLLI32
+#undef V_SRLI32
+#undef V_SRAI32
+#undef V_MUL32_U16
+#undef V_CMPEQ32
+#undef V_CMPGT32
+#undef V_UNPACKLO8
+#undef V_UNPACKHI8
+#undef V_UNPACKLO32
+#undef V_UNPACKHI32
+#undef V_PACKUS16
+#undef V_MOVEMASK8
+
+/*AVX2: 8 pixels at once. The unpack and pack operations work in 128 bit lanes,
+ *which keeps the pixel order as they are always used in pairs*/
+
+#define FN(name)                name##_avx2
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define TARGET
+#else
+    #define TARGET              __attribute__((target("avx2")))
+#endif
+#define vec_t                   __m256i
+#define PX                      8
+#define V_LOAD(p)               _mm256_loadu_si256((const __m256i *)(p))
+#define V_STORE(p, v)           _mm256_storeu_si256((__m256i *)(p), v)
+#define V_ZERO()                _mm256_setzero_si256()
+#define V_SET1_16(x)            _mm256_set1_epi16((int16_t)(x))
+#define V_SET1_32(x)            _mm256_set1_epi32((int32_t)(x))
+#define V_AND(a, b)             _mm256_and_si256(a, b)
+#define V_OR(a, b)              _mm256_or_si256(a, b)
+#define V_ANDNOT(a, b)          _mm256_andnot_si256(a, b)
+#define V_ADD16(a, b)           _mm256_add_epi16(a, b)
+#define V_SUB16(a, b)           _mm256_sub_epi16(a, b)
+#define V_ADD32(a, b)           _mm256_add_epi32(a, b)
+#define V_SUB32(a, b)           _mm256_sub_epi32(a, b)
+#define V_MULLO16(a, b)         _mm256_mullo_epi16(a, b)
+#define V_MULHI16(a, b)         _mm256_mulhi_epu16(a, b)
+#define V_SRLI16(a, n)          _mm256_srli_epi16(a, n)
+#define V_SLLI32(a, n)          _mm256_slli_epi32(a, n)
+#define V_SRLI32(a, n)          _mm256_srli_epi32(a, n)
+#define V_SRAI32(a, n)          _mm256_srai_epi32(a, n)
+#define V_MUL32_U16(a, b)       _mm256_mullo_epi32(a, b)
+#define V_CMPEQ32(a, b)         _mm256_cmpeq_epi32(a, b)
+#define V_CMPGT32(a, b)         _mm256_cmpgt_epi32(a, b)
+#define V_UNPACKLO8(a, b)       _mm256_unpacklo_epi8(a, b)
+#define V_UNPACKHI8(a, b)       _mm256_unpackhi_epi8(a, b)
+#define V_UNPACKLO32(a, b)      _mm256_unpacklo_epi32(a, b)
+#define V_UNPACKHI32(a, b)      _mm256_unpackhi_epi32(a, b)
+#define V_PACKUS16(a, b)        _mm256_packus_epi16(a, b)
+#define V_MOVEMASK8(a)          _mm256_movemask_epi8(a)
+
+static FORCE_INLINE TARGET __m256i load_mask_avx2(const lv_opa_t * mask)
+{
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+}
+
+static FORCE_INLINE TARGET __m256i load_rgb565_avx2(const uint16_t * px)
+{
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)px));
+}
+
+/*Load the 24 bytes of 8 pixels without reading past them, move 12 bytes into each lane,
+ *and spread them to 4 bytes per pixel*/
+static FORCE_INLINE TARGET __m256i load_rgb888_avx2(const uint8_t * px)
+{
+    __m256i v = _mm256_maskload_epi32((const int *)px, _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0));
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 5));
+    return _mm256_shuffle_epi8(v, _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                   0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+}
+
+static FORCE_INLINE TARGET void store_rgb565_avx2(uint16_t * px, __m256i v)
+{
+    /*Sign extend the lower 16 bits to not saturate when packing, and put the two halves together*/
+    v = _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+    v = _mm256_permute4x64_epi64(_mm256_packs_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128((__m128i *)px, _mm256_castsi256_si128(v));
+}
+
+static FORCE_INLINE TARGET void store_a8_avx2(uint8_t * px, __m256i v)
+{
+    /*The packing works in 128 bit lanes, put the 4 values of both lanes together*/
+    v = _mm256_packs_epi32(v, v);
+    v = _mm256_packus_epi16(v, v);
+    __m128i a = _mm_unpacklo_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64((__m128i *)px, a);
+}
+
+static FORCE_INLINE TARGET __m256i gather32_avx2(const uint8_t * base, __m256i ofs)
+{
+    return _mm256_i32gather_epi32((const int *)base, ofs, 1);
+}
+
+#include "lv_blend_sse2_template.h"
+#include "lv_transform_sse2_template.h"
+
+#undef FN
+#undef TARGET
+#undef vec_t
+#undef PX
+#undef V_LOAD
+#undef V_STORE
+#undef V_ZERO
+#undef V_SET1_16
+#undef V_SET1_32
+#undef V_AND
+#undef V_OR
+#undef V_ANDNOT
+#undef V_ADD16
+#undef V_SUB16
+#undef V_ADD32
+#undef V_SUB32
+#undef V_MULLO16
+#undef V_MULHI16
+#undef V_SRLI16
+#undef V_SLLI32
+#undef V_SRLI32
+#undef V_SRAI32
+#undef V_MUL32_U16
+#undef V_CMPEQ32
+#undef V_CMPGT32
+#undef V_UNPACKLO8
+#undef V_UNPACKHI8
+#undef V_UNPACKLO32
+#undef V_UNPACKHI32
+#undef V_PACKUS16
+#undef V_MOVEMASK8
+
+static lv_result_t blend(const blend_dsc_t * dsc, blend_dest_t dest, blend_src_t src)
+{
+    switch(isa_act) {
+        case LV_BLEND_SSE2_ISA_AVX2:
+            blend_avx2(dsc, dest, src);
+            return LV_RESULT_OK;
+        case LV_BLEND_SSE2_ISA_SSE2:
+            blend_sse2(dsc, dest, src);
+            return LV_RESULT_OK;
+        default:
+            return LV_RESULT_INVALID;
+    }
+}
+
+static lv_result_t transform(const lv_draw_sw_transform_row_dsc_t * dsc, transform_src_t src)
+{
+    switch(isa_act) {
+        case LV_BLEND_SSE2_ISA_AVX2:
+            transform_avx2(dsc, src);
+            return LV_RESULT_OK;
+        case LV_BLEND_SSE2_ISA_SSE2:
+            transform_sse2(dsc, src);
+            return LV_RESULT_OK;
+        default:
+            return LV_RESULT_INVALID;
+    }
+}
+
+static void fill_dsc_init(blend_dsc_t * bd, const lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    bd->dest_buf = dsc->dest_buf;
+    bd->dest_w = dsc->dest_w;
+    bd->dest_h = dsc->dest_h;
+    bd->dest_stride = dsc->dest_stride;
+    bd->src_buf = NULL;
+    bd->src_stride = 0;
+    bd->color = lv_color_to_u32(dsc->color);
+    bd->mask_buf = dsc->mask_buf;
+    bd->mask_stride = dsc->mask_stride;
+    bd->opa = dsc->opa;
+}
+
+static void image_dsc_init(blend_dsc_t * bd, const lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    bd->dest_buf = dsc->dest_buf;
+    bd->dest_w = dsc->dest_w;
+    bd->dest_h = dsc->dest_h;
+    bd->dest_stride = dsc->dest_stride;
+    bd->src_buf = dsc->src_buf;
+    bd->src_stride = dsc->src_stride;
+    bd->color = 0;
+    bd->mask_buf = dsc->mask_buf;
+    bd->mask_stride = dsc->mask_stride;
+    bd->opa = dsc->opa;
+}
+
+static lv_blend_sse2_isa_t get_cpu_isa(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] >= 7) {
+        __cpuid(info, 1);
+        /*OSXSAVE and AVX, and the OS saves the YMM registers*/
+        bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        if(avx && (info[1] & (1 << 5))) return LV_BLEND_SSE2_ISA_AVX2;
+    }
+#else
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) return LV_BLEND_SSE2_ISA_AVX2;
+#endif
+    return LV_BLEND_SSE2_ISA_SSE2;
+}
+
+#endif /*LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE*/
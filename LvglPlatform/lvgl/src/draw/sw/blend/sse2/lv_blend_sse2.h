@@ -0,0 +1,301 @@
+/**
+ * @file lv_blend_sse2.h
+ *
+ */
+
+#ifndef LV_BLEND_SSE2_H
+#define LV_BLEND_SSE2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+/* detect whether SSE2 is available based on the x86 compilers' standard */
+#if LV_USE_DRAW_SW && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define LV_BLEND_SSE2_AVAILABLE 1
+#else
+#define LV_BLEND_SSE2_AVAILABLE 0
+#endif
+
+#if LV_BLEND_SSE2_AVAILABLE
+
+#include "../lv_draw_sw_blend_private.h"
+#include "../../lv_draw_sw_private.h"
+
+#ifdef LV_DRAW_SW_SSE2_CUSTOM_INCLUDE
+#include LV_DRAW_SW_SSE2_CUSTOM_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The functions blend with and without opacity and mask, and return
+ *LV_RESULT_INVALID if the C implementation should be used instead*/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    lv_color_blend_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_color_blend_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_color_blend_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_color_blend_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_rgb565_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_rgb565_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888(dsc, dst_px_size) \
+    lv_color_blend_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA(dsc, dst_px_size) \
+    lv_color_blend_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK(dsc, dst_px_size) \
+    lv_color_blend_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size) \
+    lv_color_blend_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888(dsc, dst_px_size, src_px_size)  \
+    lv_rgb888_blend_normal_to_rgb888_sse2(dsc, dst_px_size, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dst_px_size, src_px_size)  \
+    lv_rgb888_blend_normal_to_rgb888_sse2(dsc, dst_px_size, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dst_px_size, src_px_size)  \
+    lv_rgb888_blend_normal_to_rgb888_sse2(dsc, dst_px_size, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size, src_px_size)  \
+    lv_rgb888_blend_normal_to_rgb888_sse2(dsc, dst_px_size, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888(dsc, dst_px_size)  \
+    lv_argb8888_blend_normal_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dst_px_size)  \
+    lv_argb8888_blend_normal_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dst_px_size)  \
+    lv_argb8888_blend_normal_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size)  \
+    lv_argb8888_blend_normal_to_rgb888_sse2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888(dsc) \
+    lv_color_blend_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    lv_color_blend_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    lv_color_blend_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    lv_color_blend_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888(dsc, src_px_size)  \
+    lv_rgb888_blend_normal_to_argb8888_sse2(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc, src_px_size)  \
+    lv_rgb888_blend_normal_to_argb8888_sse2(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc, src_px_size)  \
+    lv_rgb888_blend_normal_to_argb8888_sse2(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_RGB888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc, src_px_size)  \
+    lv_rgb888_blend_normal_to_argb8888_sse2(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    lv_argb8888_blend_normal_to_argb8888_sse2(dsc)
+#endif
+
+/*The image transformations of the inner parts of the rows*/
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+#define LV_DRAW_SW_TRANSFORM_ARGB8888(dsc)  \
+    lv_transform_argb8888_sse2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB888
+#define LV_DRAW_SW_TRANSFORM_RGB888(dsc, src_px_size)  \
+    lv_transform_rgb888_sse2(dsc, src_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+#define LV_DRAW_SW_TRANSFORM_RGB565A8(dsc, src_has_a8)  \
+    lv_transform_rgb565a8_sse2(dsc, src_has_a8)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    LV_BLEND_SSE2_ISA_NONE,     /**< Use the C implementation*/
+    LV_BLEND_SSE2_ISA_SSE2,
+    LV_BLEND_SSE2_ISA_AVX2,
+} lv_blend_sse2_isa_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Select the best instruction set supported by the CPU.
+ * Called by `lv_draw_sw_init()`.
+ */
+void lv_blend_sse2_init(void);
+
+/**
+ * Set the instruction set used for blending, e.g. to compare it with the others.
+ * @param isa   an instruction set, it's lowered to the best one supported by the CPU
+ */
+void lv_blend_sse2_set_isa(lv_blend_sse2_isa_t isa);
+
+/**
+ * Get the instruction set used for blending.
+ * @return      the instruction set
+ */
+lv_blend_sse2_isa_t lv_blend_sse2_get_isa(void);
+
+lv_result_t lv_color_blend_to_rgb565_sse2(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_color_blend_to_rgb888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+
+lv_result_t lv_color_blend_to_argb8888_sse2(lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_rgb565_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_argb8888_blend_normal_to_rgb565_sse2(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_rgb888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size,
+                                                  uint32_t src_px_size);
+
+lv_result_t lv_argb8888_blend_normal_to_rgb888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+
+lv_result_t lv_rgb888_blend_normal_to_argb8888_sse2(lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size);
+
+lv_result_t lv_argb8888_blend_normal_to_argb8888_sse2(lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_transform_argb8888_sse2(const lv_draw_sw_transform_row_dsc_t * dsc);
+
+lv_result_t lv_transform_rgb888_sse2(const lv_draw_sw_transform_row_dsc_t * dsc, uint32_t src_px_size);
+
+lv_result_t lv_transform_rgb565a8_sse2(const lv_draw_sw_transform_row_dsc_t * dsc, bool src_has_a8);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_BLEND_SSE2_AVAILABLE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_SSE2_H*/
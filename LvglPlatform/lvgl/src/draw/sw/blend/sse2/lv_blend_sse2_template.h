@@ -0,0 +1,274 @@
+/**
+ * @file lv_blend_sse2_template.h
+ *
+ * The blend loops of `lv_blend_sse2.c`, included once for each instruction set.
+ * Before including it define
+ * - `FN(name)`: to add a suffix to the name of the functions
+ * - `TARGET`: attribute to compile the functions for the instruction set
+ * - `vec_t` and `PX`: the vector type and the number of 32 bit pixels in it
+ * - the `V_...` operations, and `FN(load_mask)`, `FN(load_rgb565)`, `FN(load_rgb888)`, `FN(store_rgb565)`
+ */
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define V_SELECT(m, a, b)   V_OR(V_AND(m, a), V_ANDNOT(m, b))
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Mix 32 bit pixels channel by channel with `LV_UDIV255(fg * a + bg * (255 - a))`,
+ * or `>> 8` instead of the division if `div255 == false`.
+ */
+static FORCE_INLINE TARGET vec_t FN(mix_channels)(vec_t fg, vec_t bg, vec_t a, bool div255)
+{
+    vec_t zero = V_ZERO();
+    vec_t a2 = V_OR(a, V_SLLI32(a, 16));
+    vec_t a_lo = V_UNPACKLO32(a2, a2);
+    vec_t a_hi = V_UNPACKHI32(a2, a2);
+    vec_t v255 = V_SET1_16(255);
+
+    vec_t lo = V_ADD16(V_MULLO16(V_UNPACKLO8(fg, zero), a_lo),
+                       V_MULLO16(V_UNPACKLO8(bg, zero), V_SUB16(v255, a_lo)));
+    vec_t hi = V_ADD16(V_MULLO16(V_UNPACKHI8(fg, zero), a_hi),
+                       V_MULLO16(V_UNPACKHI8(bg, zero), V_SUB16(v255, a_hi)));
+
+    if(div255) {
+        vec_t udiv = V_SET1_16(0x8081);
+        lo = V_SRLI16(V_MULHI16(lo, udiv), 7);
+        hi = V_SRLI16(V_MULHI16(hi, udiv), 7);
+    }
+    else {
+        lo = V_SRLI16(lo, 8);
+        hi = V_SRLI16(hi, 8);
+    }
+
+    return V_PACKUS16(lo, hi);
+}
+
+/**
+ * Mix RGB565 pixels (stored in 32 bit) like `lv_color_16_16_mix()`.
+ * The upper 16 bits of the result are not cleared.
+ */
+static FORCE_INLINE TARGET vec_t FN(mix_rgb565)(vec_t fg, vec_t bg, vec_t a)
+{
+    vec_t mask = V_SET1_32(0x07E0F81F);
+    vec_t m = V_SRLI32(V_ADD32(a, V_SET1_32(4)), 3);
+    vec_t m2 = V_OR(m, V_SLLI32(m, 16));
+    vec_t fgx = V_AND(V_OR(fg, V_SLLI32(fg, 16)), mask);
+    vec_t bgx = V_AND(V_OR(bg, V_SLLI32(bg, 16)), mask);
+
+    /*32 bit multiplication from 16 bit ones as SSE2 has no `mullo_epi32`*/
+    vec_t d = V_SUB32(fgx, bgx);
+    vec_t dm = V_ADD32(V_MULLO16(d, m2), V_SLLI32(V_MULHI16(d, m2), 16));
+
+    vec_t res = V_AND(V_ADD32(V_SRLI32(dm, 5), bgx), mask);
+    return V_OR(res, V_SRLI32(res, 16));
+}
+
+/**
+ * Mix ARGB8888 pixels to RGB565 pixels (stored in 32 bit) like `lv_color_24_16_mix()`.
+ */
+static FORCE_INLINE TARGET vec_t FN(mix_argb8888_to_rgb565)(vec_t fg, vec_t bg, vec_t a)
+{
+    vec_t inv = V_SUB32(V_SET1_32(255), a);
+    vec_t m5 = V_SET1_32(0x1F);
+    vec_t m6 = V_SET1_32(0x3F);
+
+    vec_t r = V_ADD32(V_MULLO16(V_AND(V_SRLI32(fg, 19), m5), a), V_MULLO16(V_AND(V_SRLI32(bg, 11), m5), inv));
+    vec_t g = V_ADD32(V_MULLO16(V_AND(V_SRLI32(fg, 10), m6), a), V_MULLO16(V_AND(V_SRLI32(bg, 5), m6), inv));
+    vec_t b = V_ADD32(V_MULLO16(V_AND(V_SRLI32(fg, 3), m5), a), V_MULLO16(V_AND(bg, m5), inv));
+    vec_t mixed = V_OR(V_OR(V_AND(V_SLLI32(r, 3), V_SET1_32(0xF800)), V_AND(V_SRLI32(g, 3), V_SET1_32(0x07E0))),
+                       V_SRLI32(b, 8));
+
+    vec_t conv = V_OR(V_OR(V_AND(V_SRLI32(fg, 8), V_SET1_32(0xF800)), V_AND(V_SRLI32(fg, 5), V_SET1_32(0x07E0))),
+                      V_AND(V_SRLI32(fg, 3), m5));
+
+    mixed = V_SELECT(V_CMPEQ32(a, V_ZERO()), bg, mixed);
+    return V_SELECT(V_CMPEQ32(a, V_SET1_32(255)), conv, mixed);
+}
+
+/**
+ * Blend all rows of an area. `dest`, `src`, `has_opa` and `has_mask` are constants
+ * at each call, so an optimized loop is inlined for each combination.
+ */
+static FORCE_INLINE TARGET void FN(blend_rows)(const blend_dsc_t * dsc, blend_dest_t dest, blend_src_t src,
+                                               bool has_opa, bool has_mask)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint8_t * dest_row = dsc->dest_buf;
+    const uint8_t * src_row = dsc->src_buf;
+    const lv_opa_t * mask_row = dsc->mask_buf;
+    lv_opa_t opa = dsc->opa;
+
+    vec_t v_color = V_SET1_32((int32_t)dsc->color);
+    vec_t v_opa = V_SET1_32(opa);
+    vec_t v_rgb = V_SET1_32(0x00FFFFFF);
+    vec_t v_alpha = V_SET1_32((int32_t)0xFF000000);
+    vec_t v_2 = V_SET1_32(LV_OPA_MIN);
+    vec_t v_3 = V_SET1_32(LV_OPA_MIN + 1);
+    vec_t v_252 = V_SET1_32(LV_OPA_MAX - 1);
+    vec_t v_255 = V_SET1_32(255);
+
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x = 0;
+        for(; x <= w - PX; x += PX) {
+            vec_t fg;
+            vec_t a;
+            if(src == SRC_COLOR) fg = v_color;
+            else if(src == SRC_RGB565) fg = FN(load_rgb565)((const uint16_t *)src_row + x);
+            else if(src == SRC_RGB888) fg = FN(load_rgb888)(src_row + x * 3);
+            else fg = V_LOAD((const uint32_t *)src_row + x);
+
+            /*Without opacity and mask the RGB888 pixels are only copied, e.g. the rows of horizontal gradients*/
+            if(src == SRC_RGB888 && !has_opa && !has_mask) {
+                uint32_t * dest_px = (uint32_t *)dest_row + x;
+                if(dest == DEST_ARGB8888) V_STORE(dest_px, V_OR(fg, v_alpha));
+                else V_STORE(dest_px, V_OR(fg, V_AND(V_LOAD(dest_px), v_alpha)));
+                continue;
+            }
+
+            vec_t mask = has_mask ? FN(load_mask)(mask_row + x) : v_255;
+            if(src == SRC_ARGB8888) {
+                a = V_SRLI32(fg, 24);
+                if(has_opa && has_mask) a = V_MULHI16(V_MULLO16(a, mask), v_opa);
+                else if(has_opa) a = V_SRLI32(V_MULLO16(a, v_opa), 8);
+                else if(has_mask) a = V_SRLI32(V_MULLO16(a, mask), 8);
+            }
+            else {
+                if(has_opa && has_mask) a = V_SRLI32(V_MULLO16(mask, v_opa), 8);
+                else if(has_opa) a = v_opa;
+                else a = mask;
+            }
+
+            if(dest == DEST_ARGB8888) {
+                uint32_t * dest_px = (uint32_t *)dest_row + x;
+                vec_t bg = V_LOAD(dest_px);
+                vec_t bg_a = V_SRLI32(bg, 24);
+                vec_t fg_a = V_OR(V_AND(fg, v_rgb), V_SLLI32(a, 24));
+
+                /*Semi transparent background: blend the pixels one by one with division*/
+                vec_t semi_bg = V_ANDNOT(V_CMPEQ32(bg_a, v_255), V_CMPGT32(bg_a, v_2));
+                if(V_MOVEMASK8(semi_bg)) {
+                    uint32_t fg_arr[PX];
+                    V_STORE(fg_arr, fg_a);
+                    int32_t i;
+                    for(i = 0; i < PX; i++) {
+                        dest_px[i] = blend_argb8888_px(fg_arr[i], dest_px[i]);
+                    }
+                    continue;
+                }
+
+                vec_t res = V_OR(FN(mix_channels)(fg, bg, a, true), v_alpha);
+                res = V_SELECT(V_CMPGT32(v_3, a), bg, res);
+                res = V_SELECT(V_OR(V_CMPGT32(a, v_252), V_CMPGT32(v_3, bg_a)), fg_a, res);
+                V_STORE(dest_px, res);
+            }
+            else if(dest == DEST_XRGB8888) {
+                uint32_t * dest_px = (uint32_t *)dest_row + x;
+                vec_t bg = V_LOAD(dest_px);
+                vec_t res = FN(mix_channels)(fg, bg, a, false);
+                res = V_SELECT(V_CMPEQ32(a, V_ZERO()), bg, res);
+                res = V_SELECT(V_CMPGT32(a, v_252), fg, res);
+                V_STORE(dest_px, V_OR(V_AND(res, v_rgb), V_AND(bg, v_alpha)));
+            }
+            else {
+                uint16_t * dest_px = (uint16_t *)dest_row + x;
+                vec_t bg = FN(load_rgb565)(dest_px);
+                vec_t res;
+                if(src == SRC_ARGB8888) res = FN(mix_argb8888_to_rgb565)(fg, bg, a);
+                else res = FN(mix_rgb565)(fg, bg, a);
+                FN(store_rgb565)(dest_px, res);
+            }
+        }
+
+        for(; x < w; x++) {
+            uint32_t fg;
+            if(src == SRC_COLOR) fg = dsc->color;
+            else if(src == SRC_RGB565) fg = ((const uint16_t *)src_row)[x];
+            else if(src == SRC_RGB888) fg = src_row[x * 3] | ((uint32_t)src_row[x * 3 + 1] << 8) |
+                                                ((uint32_t)src_row[x * 3 + 2] << 16);
+            else fg = ((const uint32_t *)src_row)[x];
+
+            lv_opa_t a = px_opa(src, fg, opa, has_mask ? mask_row[x] : LV_OPA_COVER, has_opa, has_mask);
+            blend_px(dest, src, dest_row, x, fg, a);
+        }
+
+        dest_row += dsc->dest_stride;
+        if(src != SRC_COLOR) src_row += dsc->src_stride;
+        if(has_mask) mask_row += dsc->mask_stride;
+    }
+}
+
+static FORCE_INLINE TARGET void FN(fill)(const blend_dsc_t * dsc, blend_dest_t dest)
+{
+    int32_t w = dsc->dest_w;
+    int32_t h = dsc->dest_h;
+    uint8_t * dest_row = dsc->dest_buf;
+
+    int32_t y;
+    if(dest == DEST_RGB565) {
+        uint16_t color16 = (uint16_t)dsc->color;
+        vec_t v_color = V_SET1_16((int16_t)color16);
+        for(y = 0; y < h; y++) {
+            uint16_t * dest_px = (uint16_t *)dest_row;
+            int32_t x = 0;
+            for(; x <= w - 2 * PX; x += 2 * PX) V_STORE(dest_px + x, v_color);
+            for(; x < w; x++) dest_px[x] = color16;
+            dest_row += dsc->dest_stride;
+        }
+    }
+    else {
+        vec_t v_color = V_SET1_32((int32_t)dsc->color);
+        for(y = 0; y < h; y++) {
+            uint32_t * dest_px = (uint32_t *)dest_row;
+            int32_t x = 0;
+            for(; x <= w - PX; x += PX) V_STORE(dest_px + x, v_color);
+            for(; x < w; x++) dest_px[x] = dsc->color;
+            dest_row += dsc->dest_stride;
+        }
+    }
+}
+
+#define BLEND_CASE(dest, src) \
+    case (dest) * 8 + (src): \
+        if(has_opa && has_mask) FN(blend_rows)(dsc, dest, src, true, true); \
+        else if(has_opa) FN(blend_rows)(dsc, dest, src, true, false); \
+        else if(has_mask) FN(blend_rows)(dsc, dest, src, false, true); \
+        else FN(blend_rows)(dsc, dest, src, false, false); \
+        break;
+
+static TARGET void FN(blend)(const blend_dsc_t * dsc, blend_dest_t dest, blend_src_t src)
+{
+    bool has_opa = dsc->opa < LV_OPA_MAX;
+    bool has_mask = dsc->mask_buf != NULL;
+
+    if(src == SRC_COLOR && !has_opa && !has_mask) {
+        FN(fill)(dsc, dest);
+        return;
+    }
+
+    switch(dest * 8 + src) {
+        BLEND_CASE(DEST_ARGB8888, SRC_COLOR)
+        BLEND_CASE(DEST_ARGB8888, SRC_ARGB8888)
+        BLEND_CASE(DEST_ARGB8888, SRC_XRGB8888)
+        BLEND_CASE(DEST_ARGB8888, SRC_RGB888)
+        BLEND_CASE(DEST_XRGB8888, SRC_COLOR)
+        BLEND_CASE(DEST_XRGB8888, SRC_ARGB8888)
+        BLEND_CASE(DEST_XRGB8888, SRC_XRGB8888)
+        BLEND_CASE(DEST_XRGB8888, SRC_RGB888)
+        BLEND_CASE(DEST_RGB565, SRC_COLOR)
+        BLEND_CASE(DEST_RGB565, SRC_ARGB8888)
+        BLEND_CASE(DEST_RGB565, SRC_RGB565)
+        default:
+            break;
+    }
+}
+
+#undef BLEND_CASE
+#undef V_SELECT
@@ -0,0 +1,286 @@
+/**
+ * @file lv_transform_sse2_template.h
+ *
+ * The image transformation loops of `lv_blend_sse2.c`, included once for each instruction set
+ * after `lv_blend_sse2_template.h`. Besides the macros of that template it needs
+ * - `V_SRAI32(a, n)` and `V_MUL32_U16(a, b)` (32 bit multiplication, `b` is below 65536)
+ * - `FN(gather32)` to load 32 bit pixels from byte offsets, and `FN(store_a8)` to store 8 bit values
+ */
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define V_SELECT(m, a, b)   V_OR(V_AND(m, a), V_ANDNOT(m, b))
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Load a pixel for each byte offset.
+ * Only 32 bit pixels are loaded together, the others would read past the end of the image.
+ */
+static FORCE_INLINE TARGET vec_t FN(gather)(const uint8_t * base, vec_t ofs, uint32_t px_size)
+{
+    if(px_size == 4) return FN(gather32)(base, ofs);
+
+    int32_t ofs_arr[PX];
+    uint32_t px_arr[PX];
+    V_STORE(ofs_arr, ofs);
+
+    int32_t i;
+    for(i = 0; i < PX; i++) {
+        const uint8_t * p = base + ofs_arr[i];
+        if(px_size == 3) px_arr[i] = p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+        else if(px_size == 2) px_arr[i] = *(const uint16_t *)p;
+        else px_arr[i] = p[0];
+    }
+
+    return V_LOAD(px_arr);
+}
+
+/**
+ * Mix the channels of the pixels like `lv_color_mix32()`, and the alpha channel with `>> 8`
+ * like the C implementation mixes the alpha of ARGB8888 pixels.
+ */
+static FORCE_INLINE TARGET vec_t FN(mix_transform)(vec_t fg, vec_t bg, vec_t a)
+{
+    vec_t zero = V_ZERO();
+    vec_t a2 = V_OR(a, V_SLLI32(a, 16));
+    vec_t a_lo = V_UNPACKLO32(a2, a2);
+    vec_t a_hi = V_UNPACKHI32(a2, a2);
+    vec_t v255 = V_SET1_16(255);
+
+    vec_t lo = V_ADD16(V_MULLO16(V_UNPACKLO8(fg, zero), a_lo),
+                       V_MULLO16(V_UNPACKLO8(bg, zero), V_SUB16(v255, a_lo)));
+    vec_t hi = V_ADD16(V_MULLO16(V_UNPACKHI8(fg, zero), a_hi),
+                       V_MULLO16(V_UNPACKHI8(bg, zero), V_SUB16(v255, a_hi)));
+
+    vec_t udiv = V_SET1_16(0x8081);
+    vec_t rgb = V_PACKUS16(V_SRLI16(V_MULHI16(lo, udiv), 7), V_SRLI16(V_MULHI16(hi, udiv), 7));
+    vec_t alpha = V_PACKUS16(V_SRLI16(lo, 8), V_SRLI16(hi, 8));
+    return V_SELECT(V_SET1_32(0x00FFFFFF), rgb, alpha);
+}
+
+/**
+ * Mix a neighbor into ARGB8888 pixels with the same special cases as `transform_argb8888()`.
+ * @param c     the pixels
+ * @param n     the neighbors
+ * @param f     the weight of the neighbors (0..127)
+ */
+static FORCE_INLINE TARGET vec_t FN(mix_neighbor_argb8888)(vec_t c, vec_t n, vec_t f)
+{
+    vec_t zero = V_ZERO();
+    vec_t mixed = FN(mix_transform)(n, c, f);
+
+    /*A transparent neighbor or a small weight doesn't change the color.
+     *The alpha is not changed by the same neighbor or if it's zero.*/
+    vec_t keep_rgb = V_OR(V_CMPEQ32(V_SRLI32(n, 24), zero), V_CMPGT32(V_SET1_32(LV_OPA_MIN + 1), f));
+    vec_t keep_a = V_OR(V_CMPEQ32(c, n), V_CMPEQ32(V_SRLI32(c, 24), zero));
+    vec_t keep = V_OR(V_AND(keep_rgb, V_SET1_32(0x00FFFFFF)), V_AND(keep_a, V_SET1_32((int32_t)0xFF000000)));
+    return V_SELECT(keep, c, mixed);
+}
+
+/**
+ * Transform `PX` pixels whose neighbors are inside the image too.
+ * @param dsc       the row
+ * @param src       the color format of the image
+ * @param aa        true: mix the neighbors
+ * @param acc_x     `xs_step * x` for each pixel
+ * @param acc_y     `ys_step * x` for each pixel
+ * @param color     store ARGB8888 pixels, or RGB565 pixels in 32 bit here
+ * @param alpha     store the opacity of RGB565 pixels here
+ */
+static FORCE_INLINE TARGET void FN(transform_px)(const lv_draw_sw_transform_row_dsc_t * dsc, transform_src_t src,
+                                                 bool aa, vec_t acc_x, vec_t acc_y, vec_t * color, vec_t * alpha)
+{
+    uint32_t px_size;
+    if(src == TRANSFORM_RGB888) px_size = 3;
+    else if(src == TRANSFORM_RGB565 || src == TRANSFORM_RGB565A8) px_size = 2;
+    else px_size = 4;
+
+    int32_t stride = dsc->src_stride;
+    vec_t xs = V_ADD32(V_SET1_32(dsc->xs_ups), V_SRAI32(acc_x, 8));
+    vec_t ys = V_ADD32(V_SET1_32(dsc->ys_ups), V_SRAI32(acc_y, 8));
+    vec_t xs_int = V_SRAI32(xs, 8);
+    vec_t ys_int = V_SRAI32(ys, 8);
+
+    vec_t xs_ofs;
+    if(px_size == 4) xs_ofs = V_SLLI32(xs_int, 2);
+    else if(px_size == 3) xs_ofs = V_ADD32(V_SLLI32(xs_int, 1), xs_int);
+    else xs_ofs = V_SLLI32(xs_int, 1);
+    vec_t ofs = V_ADD32(V_MUL32_U16(V_SET1_32(stride), ys_int), xs_ofs);
+    vec_t c = FN(gather)(dsc->src, ofs, px_size);
+
+    /*The alpha map of RGB565A8 images is after the pixels with half stride*/
+    const uint8_t * src_a8 = dsc->src + stride * dsc->src_h;
+    int32_t a8_stride = stride / 2;
+    vec_t a8_ofs = V_ZERO();
+    if(src == TRANSFORM_RGB565A8) a8_ofs = V_ADD32(V_MUL32_U16(V_SET1_32(a8_stride), ys_int), xs_int);
+
+    vec_t v_alpha = V_SET1_32((int32_t)0xFF000000);
+    vec_t v_255 = V_SET1_32(255);
+
+    if(!aa) {
+        if(src == TRANSFORM_ARGB8888) {
+            *color = c;
+        }
+        else if(src == TRANSFORM_XRGB8888 || src == TRANSFORM_RGB888) {
+            *color = V_OR(c, v_alpha);
+        }
+        else {
+            *color = c;
+            *alpha = src == TRANSFORM_RGB565A8 ? FN(gather)(src_a8, a8_ofs, 1) : v_255;
+        }
+        return;
+    }
+
+    /*The neighbors are in the direction of the nearer pixels, `fract` is their weight in 0..127*/
+    vec_t v_7f = V_SET1_32(0x7F);
+    vec_t v_80 = V_SET1_32(0x80);
+    vec_t xs_fract = V_AND(xs, v_255);
+    vec_t ys_fract = V_AND(ys, v_255);
+    vec_t x_next_pos = V_CMPGT32(xs_fract, v_7f);
+    vec_t y_next_pos = V_CMPGT32(ys_fract, v_7f);
+    xs_fract = V_SELECT(x_next_pos, V_SUB32(xs_fract, v_80), V_SUB32(v_7f, xs_fract));
+    ys_fract = V_SELECT(y_next_pos, V_SUB32(ys_fract, v_80), V_SUB32(v_7f, ys_fract));
+
+    vec_t hor_ofs = V_ADD32(ofs, V_SELECT(x_next_pos, V_SET1_32(px_size), V_SET1_32(-(int32_t)px_size)));
+    vec_t ver_ofs = V_ADD32(ofs, V_SELECT(y_next_pos, V_SET1_32(stride), V_SET1_32(-stride)));
+    vec_t px_hor = FN(gather)(dsc->src, hor_ofs, px_size);
+    vec_t px_ver = FN(gather)(dsc->src, ver_ofs, px_size);
+
+    if(src == TRANSFORM_ARGB8888) {
+        c = FN(mix_neighbor_argb8888)(c, px_ver, ys_fract);
+        *color = FN(mix_neighbor_argb8888)(c, px_hor, xs_fract);
+    }
+    else if(src == TRANSFORM_XRGB8888 || src == TRANSFORM_RGB888) {
+        /*The same neighbor doesn't change the color, so only the small weights are special*/
+        vec_t v_3 = V_SET1_32(LV_OPA_MIN + 1);
+        c = V_SELECT(V_CMPGT32(v_3, ys_fract), c, FN(mix_transform)(px_ver, c, ys_fract));
+        c = V_SELECT(V_CMPGT32(v_3, xs_fract), c, FN(mix_transform)(px_hor, c, xs_fract));
+        *color = V_OR(c, v_alpha);
+    }
+    else {
+        /*The weights are in 0..254 for RGB565*/
+        xs_fract = V_SLLI32(xs_fract, 1);
+        ys_fract = V_SLLI32(ys_fract, 1);
+
+        vec_t a;
+        if(src == TRANSFORM_RGB565A8) {
+            vec_t v_256 = V_SET1_32(256);
+            vec_t a_hor_ofs = V_ADD32(a8_ofs, V_SELECT(x_next_pos, V_SET1_32(1), V_SET1_32(-1)));
+            vec_t a_ver_ofs = V_ADD32(a8_ofs, V_SELECT(y_next_pos, V_SET1_32(a8_stride), V_SET1_32(-a8_stride)));
+            a = FN(gather)(src_a8, a8_ofs, 1);
+            vec_t a_hor = FN(gather)(src_a8, a_hor_ofs, 1);
+            vec_t a_ver = FN(gather)(src_a8, a_ver_ofs, 1);
+            a_ver = V_SRLI32(V_ADD32(V_MULLO16(a_ver, ys_fract), V_MULLO16(a, V_SUB32(v_256, ys_fract))), 8);
+            a_hor = V_SRLI32(V_ADD32(V_MULLO16(a_hor, xs_fract), V_MULLO16(a, V_SUB32(v_256, xs_fract))), 8);
+            a = V_SRLI32(V_ADD32(a_ver, a_hor), 1);
+        }
+        else {
+            a = v_255;
+        }
+
+        vec_t v_ffff = V_SET1_32(0xFFFF);
+        vec_t ver = V_AND(FN(mix_rgb565)(px_ver, c, ys_fract), v_ffff);
+        vec_t hor = V_AND(FN(mix_rgb565)(px_hor, c, xs_fract), v_ffff);
+        vec_t mixed = FN(mix_rgb565)(hor, ver, V_SET1_32(LV_OPA_50));
+
+        /*Fully transparent pixels keep the original color*/
+        *color = V_SELECT(V_CMPEQ32(a, V_ZERO()), c, mixed);
+        *alpha = a;
+    }
+}
+
+/**
+ * Transform the pixels of a row from `x_start` to `x_end`. `src` and `aa` are constants
+ * at each call, so an optimized loop is inlined for each combination.
+ */
+static FORCE_INLINE TARGET void FN(transform_row)(const lv_draw_sw_transform_row_dsc_t * dsc, transform_src_t src,
+                                                  bool aa)
+{
+    bool rgb565 = src == TRANSFORM_RGB565 || src == TRANSFORM_RGB565A8;
+    uint32_t * dest32 = dsc->dest_buf;
+    uint16_t * dest16 = dsc->dest_buf;
+    int32_t x = dsc->x_start;
+    int32_t x_end = dsc->x_end;
+
+    int32_t acc_x_arr[PX];
+    int32_t acc_y_arr[PX];
+    int32_t i;
+    for(i = 0; i < PX; i++) {
+        acc_x_arr[i] = dsc->xs_step * (x + i);
+        acc_y_arr[i] = dsc->ys_step * (x + i);
+    }
+
+    vec_t acc_x = V_LOAD(acc_x_arr);
+    vec_t acc_y = V_LOAD(acc_y_arr);
+    vec_t acc_x_step = V_SET1_32(dsc->xs_step * PX);
+    vec_t acc_y_step = V_SET1_32(dsc->ys_step * PX);
+    vec_t color;
+    vec_t alpha = V_ZERO();
+
+    for(; x <= x_end - PX; x += PX) {
+        FN(transform_px)(dsc, src, aa, acc_x, acc_y, &color, &alpha);
+        if(rgb565) {
+            FN(store_rgb565)(dest16 + x, color);
+            FN(store_a8)(dsc->alpha_buf + x, alpha);
+        }
+        else {
+            V_STORE(dest32 + x, color);
+        }
+
+        acc_x = V_ADD32(acc_x, acc_x_step);
+        acc_y = V_ADD32(acc_y, acc_y_step);
+    }
+
+    if(x == x_end) return;
+
+    /*Fill the vector of the last pixels by repeating the last one*/
+    int32_t last_cnt = x_end - x;
+    for(i = 0; i < PX; i++) {
+        int32_t x_act = x + LV_MIN(i, last_cnt - 1);
+        acc_x_arr[i] = dsc->xs_step * x_act;
+        acc_y_arr[i] = dsc->ys_step * x_act;
+    }
+
+    FN(transform_px)(dsc, src, aa, V_LOAD(acc_x_arr), V_LOAD(acc_y_arr), &color, &alpha);
+
+    uint32_t color_arr[PX];
+    uint32_t alpha_arr[PX];
+    V_STORE(color_arr, color);
+    V_STORE(alpha_arr, alpha);
+    for(i = 0; i < last_cnt; i++) {
+        if(rgb565) {
+            dest16[x + i] = (uint16_t)color_arr[i];
+            dsc->alpha_buf[x + i] = (uint8_t)alpha_arr[i];
+        }
+        else {
+            dest32[x + i] = color_arr[i];
+        }
+    }
+}
+
+#define TRANSFORM_CASE(src) \
+    case src: \
+        if(dsc->aa) FN(transform_row)(dsc, src, true); \
+        else FN(transform_row)(dsc, src, false); \
+        break;
+
+static TARGET void FN(transform)(const lv_draw_sw_transform_row_dsc_t * dsc, transform_src_t src)
+{
+    switch(src) {
+        TRANSFORM_CASE(TRANSFORM_ARGB8888)
+        TRANSFORM_CASE(TRANSFORM_XRGB8888)
+        TRANSFORM_CASE(TRANSFORM_RGB888)
+        TRANSFORM_CASE(TRANSFORM_RGB565)
+        TRANSFORM_CASE(TRANSFORM_RGB565A8)
+        default:
+            break;
+    }
+}
+
+#undef TRANSFORM_CASE
+#undef V_SELECT
@@ -11,6 +11,7 @@
 #if LV_USE_DRAW_SW
 
 #include "../../core/lv_refr.h"
+#include "../../misc/lv_area_private.h"
 #include "../../display/lv_display_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
@@ -25,6 +26,8 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+    #include "blend/sse2/lv_blend_sse2.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -38,6 +41,12 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+#if LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_BAND_HEIGHT
+    #define DRAW_SW_SPLIT       1
+#else
+    #define DRAW_SW_SPLIT       0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -47,6 +56,14 @@
  **********************/
 #if LV_USE_OS
     static void render_thread_cb(void * ptr);
+    static lv_draw_sw_unit_t * get_sw_unit(void);
+#endif
+
+#if DRAW_SW_SPLIT
+    static bool split_start(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t);
+    static bool split_join(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc);
+    static bool split_draw(lv_draw_sw_thread_dsc_t * thread_dsc);
+    static bool image_is_used_directly(const void * src);
 #endif
 
 static void execute_drawing(lv_draw_task_t * t);
@@ -76,6 +93,13 @@ void lv_draw_sw_init(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_init();
+    lv_draw_sw_shadow_cache_init(LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE);
+#endif
+
+    lv_draw_sw_grad_cache_init(LV_DRAW_SW_GRAD_CACHE_DEF_SIZE);
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+    lv_blend_sse2_init();
 #endif
 
     lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -85,6 +109,11 @@ void lv_draw_sw_init(void)
     draw_sw_unit->base_unit.name = "SW";
 
 #if LV_USE_OS
+    draw_sw_unit->thread_cnt = LV_DRAW_SW_DRAW_UNIT_CNT;
+#if DRAW_SW_SPLIT
+    lv_mutex_init(&draw_sw_unit->split_lock);
+#endif
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
@@ -115,7 +144,10 @@ void lv_draw_sw_deinit(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
+    lv_draw_sw_shadow_cache_deinit();
 #endif
+
+    lv_draw_sw_grad_cache_deinit();
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -136,6 +168,10 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
         lv_thread_delete(&thread_dsc->thread);
     }
 
+#if DRAW_SW_SPLIT
+    lv_mutex_delete(&draw_sw_unit->split_lock);
+#endif
+
     return 0;
 #else
     LV_UNUSED(draw_unit);
@@ -143,6 +179,27 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
 #endif
 }
 
+void lv_draw_sw_set_thread_cnt(uint32_t cnt)
+{
+#if LV_USE_OS
+    lv_draw_sw_unit_t * draw_sw_unit = get_sw_unit();
+    if(draw_sw_unit == NULL) return;
+
+    draw_sw_unit->thread_cnt = LV_CLAMP(1, cnt, LV_DRAW_SW_DRAW_UNIT_CNT);
+#else
+    LV_UNUSED(cnt);
+#endif
+}
+
+uint32_t lv_draw_sw_get_thread_cnt(void)
+{
+#if LV_USE_OS
+    lv_draw_sw_unit_t * draw_sw_unit = get_sw_unit();
+    if(draw_sw_unit) return draw_sw_unit->thread_cnt;
+#endif
+    return 1;
+}
+
 bool lv_draw_sw_register_blend_handler(lv_draw_sw_custom_blend_handler_t * handler)
 {
     lv_draw_sw_custom_blend_handler_t * existing_handler = NULL;
@@ -200,6 +257,16 @@ lv_draw_sw_blend_handler_t lv_draw_sw_get_blend_handler(lv_color_format_t dest_c
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_OS
+static lv_draw_sw_unit_t * get_sw_unit(void)
+{
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u && u->dispatch_cb != dispatch) u = u->next;
+
+    return (lv_draw_sw_unit_t *)u;
+}
+#endif
+
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
 {
     LV_UNUSED(draw_unit);
@@ -261,12 +328,21 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     }
 
     lv_draw_task_t * t = NULL;
-    for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
+    for(i = 0; i < draw_sw_unit->thread_cnt; i++) {
         lv_draw_sw_thread_dsc_t * thread_dsc = &draw_sw_unit->thread_dscs[i];
 
         /*Do nothing if busy*/
         if(thread_dsc->task_act) continue;
 
+#if DRAW_SW_SPLIT
+        /*Help to finish the large task drawn in bands first, as the tasks above it wait for it*/
+        if(split_join(draw_sw_unit, thread_dsc)) {
+            all_idle = false;
+            if(thread_dsc->inited) lv_thread_sync_signal(&thread_dsc->sync);
+            continue;
+        }
+#endif
+
         /*Find an available task. Start from the previously taken task.*/
         t = lv_draw_get_next_available_task(layer, t, DRAW_UNIT_ID_SW);
 
@@ -287,6 +363,9 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         all_idle = false;
         taken_cnt++;
         t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+#if DRAW_SW_SPLIT
+        thread_dsc->task_act_split = split_start(draw_sw_unit, t);
+#endif
         thread_dsc->task_act = t;
 
         /*Let the render thread work*/
@@ -353,11 +432,23 @@ static void render_thread_cb(void * ptr)
             break;
         }
 
-        execute_drawing(thread_dsc->task_act);
+        bool finished = true;
+#if DRAW_SW_SPLIT
+        if(thread_dsc->task_act_split) {
+            /*Only the last thread drawing the bands finishes the task*/
+            finished = split_draw(thread_dsc);
+            thread_dsc->task_act_split = false;
+        }
+        else
+#endif
+        {
+            execute_drawing(thread_dsc->task_act);
 #if LV_USE_PARALLEL_DRAW_DEBUG
-        parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
+            parallel_debug_draw(thread_dsc->task_act, thread_dsc->idx);
 #endif
-        thread_dsc->task_act->state = LV_DRAW_TASK_STATE_READY;
+        }
+
+        if(finished) thread_dsc->task_act->state = LV_DRAW_TASK_STATE_READY;
         thread_dsc->task_act = NULL;
 
         /*The draw unit is free now. Request a new dispatching as it can get a new task*/
@@ -371,6 +462,147 @@ static void render_thread_cb(void * ptr)
 }
 #endif
 
+#if DRAW_SW_SPLIT
+/**
+ * Start drawing a large task in bands, so the idle threads can help.
+ * Only one task is split at a time.
+ * @param draw_sw_unit  pointer to the SW draw unit
+ * @param t             pointer to the task just taken by a thread
+ * @return              true: the task will be drawn in bands
+ */
+static bool split_start(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_task_t * t)
+{
+    if(draw_sw_unit->thread_cnt < 2) return false;
+
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+        case LV_DRAW_TASK_TYPE_LAYER: {
+                /*The bitmap mask is applied on the whole layer, and a file would be decoded for each band*/
+                lv_draw_image_dsc_t * draw_dsc = t->draw_dsc;
+                if(draw_dsc->bitmap_mask_src) return false;
+                if(t->type == LV_DRAW_TASK_TYPE_IMAGE && !image_is_used_directly(draw_dsc->src)) return false;
+            }
+            break;
+        default:
+            return false;
+    }
+
+    lv_area_t split_area;
+    if(!lv_area_intersect(&split_area, &t->_real_area, &t->clip_area)) return false;
+    if(lv_area_get_height(&split_area) < 2 * LV_DRAW_SW_BAND_HEIGHT) return false;
+
+    bool started = false;
+    lv_mutex_lock(&draw_sw_unit->split_lock);
+    if(draw_sw_unit->split_task == NULL) {
+        draw_sw_unit->split_task = t;
+        draw_sw_unit->split_area = split_area;
+        draw_sw_unit->split_next_y = split_area.y1;
+        draw_sw_unit->split_thread_cnt = 1;
+        started = true;
+    }
+    lv_mutex_unlock(&draw_sw_unit->split_lock);
+
+    return started;
+}
+
+/**
+ * Let an idle thread draw the remaining bands of the split task too
+ * @param draw_sw_unit  pointer to the SW draw unit
+ * @param thread_dsc    pointer to an idle thread
+ * @return              true: the thread got the split task
+ */
+static bool split_join(lv_draw_sw_unit_t * draw_sw_unit, lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    bool joined = false;
+    lv_mutex_lock(&draw_sw_unit->split_lock);
+    if(draw_sw_unit->split_task && draw_sw_unit->split_next_y <= draw_sw_unit->split_area.y2) {
+        draw_sw_unit->split_thread_cnt++;
+        thread_dsc->task_act_split = true;
+        thread_dsc->task_act = draw_sw_unit->split_task;
+        joined = true;
+    }
+    lv_mutex_unlock(&draw_sw_unit->split_lock);
+
+    return joined;
+}
+
+/**
+ * Draw bands of the split task until none is left
+ * @param thread_dsc    pointer to a thread drawing the split task
+ * @return              true: it was the last thread drawing the task, so the task is ready
+ */
+/**
+ * Check whether an image source is drawn straight from its data. Files, compressed images and formats
+ * the blender can't read would be decoded again for each band whenever the image cache misses.
+ * @param src   the image source
+ * @return      true: the image can be drawn in bands
+ */
+static bool image_is_used_directly(const void * src)
+{
+    if(lv_image_src_get_type(src) != LV_IMAGE_SRC_VARIABLE) return false;
+
+    const lv_image_dsc_t * img_dsc = src;
+    if(img_dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) return false;
+
+    switch(img_dsc->header.cf) {
+        case LV_COLOR_FORMAT_A8:
+        case LV_COLOR_FORMAT_L8:
+        case LV_COLOR_FORMAT_AL88:
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool split_draw(lv_draw_sw_thread_dsc_t * thread_dsc)
+{
+    lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *)thread_dsc->draw_unit;
+
+    /*Draw a copy of the task clipped to the band*/
+    lv_draw_task_t band_task = *thread_dsc->task_act;
+
+    /*Complex gradients keep their state in the fill descriptor while drawing, so each thread needs its own*/
+    lv_draw_fill_dsc_t fill_dsc;
+    if(band_task.type == LV_DRAW_TASK_TYPE_FILL) {
+        fill_dsc = *(lv_draw_fill_dsc_t *)band_task.draw_dsc;
+        band_task.draw_dsc = &fill_dsc;
+    }
+
+    lv_area_t split_area = draw_sw_unit->split_area;
+
+    while(1) {
+        lv_mutex_lock(&draw_sw_unit->split_lock);
+        int32_t y1 = draw_sw_unit->split_next_y;
+        draw_sw_unit->split_next_y += LV_DRAW_SW_BAND_HEIGHT;
+        lv_mutex_unlock(&draw_sw_unit->split_lock);
+        if(y1 > split_area.y2) break;
+
+        band_task.clip_area = split_area;
+        band_task.clip_area.y1 = y1;
+        band_task.clip_area.y2 = LV_MIN(y1 + LV_DRAW_SW_BAND_HEIGHT - 1, split_area.y2);
+        execute_drawing(&band_task);
+#if LV_USE_PARALLEL_DRAW_DEBUG
+        parallel_debug_draw(&band_task, thread_dsc->idx);
+#endif
+    }
+
+    lv_mutex_lock(&draw_sw_unit->split_lock);
+    draw_sw_unit->split_thread_cnt--;
+    bool last = draw_sw_unit->split_thread_cnt == 0;
+    if(last) draw_sw_unit->split_task = NULL;
+    lv_mutex_unlock(&draw_sw_unit->split_lock);
+
+    return last;
+}
+#endif /*DRAW_SW_SPLIT*/
+
 static void execute_drawing(lv_draw_task_t * t)
 {
     LV_PROFILER_DRAW_BEGIN;
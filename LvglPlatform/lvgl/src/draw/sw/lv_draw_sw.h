@@ -49,6 +49,19 @@ void lv_draw_sw_init(void);
  */
 void lv_draw_sw_deinit(void);
 
+/**
+ * Set how many of the `LV_DRAW_SW_DRAW_UNIT_CNT` rendering threads can take draw tasks.
+ * Has effect only if an OS is enabled.
+ * @param cnt       the number of threads, clamped to 1..`LV_DRAW_SW_DRAW_UNIT_CNT`
+ */
+void lv_draw_sw_set_thread_cnt(uint32_t cnt);
+
+/**
+ * Get how many rendering threads can take draw tasks
+ * @return          the number of threads
+ */
+uint32_t lv_draw_sw_get_thread_cnt(void);
+
 /**
  * Fill an area using SW render. Handle gradient and radius.
  * @param t             pointer to a draw task
@@ -73,6 +86,104 @@ void lv_draw_sw_border(lv_draw_task_t * t, const lv_draw_border_dsc_t * dsc, con
  */
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
 
+/**
+ * Initialize the shadow cache. Called internally.
+ * It keeps the blurred corners of box shadows so that shadows with the same
+ * radius, width and similar size are not blurred again in every frame.
+ * @param size      max size of the cache in bytes
+ */
+void lv_draw_sw_shadow_cache_init(uint32_t size);
+
+/**
+ * Deinitialize the shadow cache and free the corners. Called internally.
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+
+/**
+ * Resize the shadow cache. If set to 0, the cache is disabled.
+ * @param size      new max size of the cache in bytes
+ * @param evict_now true: evict the corners which don't fit into the new size now, false: on the next insertion
+ */
+void lv_draw_sw_shadow_cache_resize(uint32_t size, bool evict_now);
+
+/**
+ * Drop all corners from the shadow cache
+ */
+void lv_draw_sw_shadow_cache_drop_all(void);
+
+/**
+ * Return true if the shadow cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_draw_sw_shadow_cache_is_enabled(void);
+
+/**
+ * Get the number of shadows drawn with cached corners since `lv_init()`.
+ * @return the number of cache hits
+ */
+uint32_t lv_draw_sw_shadow_cache_get_hit_cnt(void);
+
+/**
+ * Get the number of shadow corners blurred and added to the cache since `lv_init()`.
+ * @return the number of cache misses
+ */
+uint32_t lv_draw_sw_shadow_cache_get_miss_cnt(void);
+
+/**
+ * Get the number of bytes used by the corners in the shadow cache.
+ * @return the used size in bytes
+ */
+uint32_t lv_draw_sw_shadow_cache_get_size(void);
+
+/**
+ * Initialize the gradient cache. Called internally.
+ * It keeps the colors of horizontal and vertical gradients and the color maps of
+ * complex gradients so that they are not calculated again in every frame.
+ * @param size      max size of the cache in bytes
+ */
+void lv_draw_sw_grad_cache_init(uint32_t size);
+
+/**
+ * Deinitialize the gradient cache and free the colors. Called internally.
+ */
+void lv_draw_sw_grad_cache_deinit(void);
+
+/**
+ * Resize the gradient cache. If set to 0, the cache is disabled.
+ * @param size      new max size of the cache in bytes
+ * @param evict_now true: evict the gradients which don't fit into the new size now, false: on the next insertion
+ */
+void lv_draw_sw_grad_cache_resize(uint32_t size, bool evict_now);
+
+/**
+ * Drop all gradients from the gradient cache
+ */
+void lv_draw_sw_grad_cache_drop_all(void);
+
+/**
+ * Return true if the gradient cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_draw_sw_grad_cache_is_enabled(void);
+
+/**
+ * Get the number of gradients taken from the cache since `lv_init()`.
+ * @return the number of cache hits
+ */
+uint32_t lv_draw_sw_grad_cache_get_hit_cnt(void);
+
+/**
+ * Get the number of gradients calculated and added to the cache since `lv_init()`.
+ * @return the number of cache misses
+ */
+uint32_t lv_draw_sw_grad_cache_get_miss_cnt(void);
+
+/**
+ * Get the number of bytes used by the gradients in the gradient cache.
+ * @return the used size in bytes
+ */
+uint32_t lv_draw_sw_grad_cache_get_size(void);
+
 /**
  * Draw an image with SW render. It handles image decoding, tiling, transformations, and recoloring.
  * @param t             pointer to a draw task
@@ -20,6 +20,8 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "../../stdlib/lv_string.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/lv_cache_private.h"
 #include "../lv_draw_mask.h"
 
 /*********************
@@ -28,20 +30,41 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
-#endif
+#define CACHE_NAME  "SW_SHADOW"
+
+#define shadow_cache_p (LV_GLOBAL_DEFAULT()->sw_shadow_cache)
+#define shadow_cache_hit_cnt (LV_GLOBAL_DEFAULT()->sw_shadow_cache_hit_cnt)
+#define shadow_cache_miss_cnt (LV_GLOBAL_DEFAULT()->sw_shadow_cache_miss_cnt)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    /*Key*/
+    int32_t r;          /*The clamped radius of the blurred rectangle*/
+    int32_t sw;         /*Shadow width*/
+    int32_t core_w;     /*Size of the blurred rectangle, see `shadow_corner_get()`*/
+    int32_t core_h;
+
+    /*Data*/
+    lv_opa_t * corner_buf;
+} shadow_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_opa_t * shadow_corner_get(const lv_area_t * core_area, int32_t sw, int32_t r, lv_cache_entry_t ** entry);
+static void shadow_corner_release(lv_opa_t * corner_buf, lv_cache_entry_t * entry);
+static lv_opa_t * shadow_corner_create(const lv_area_t * core_area, int32_t sw, int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static bool shadow_cache_create_cb(shadow_cache_data_t * node, void * user_data);
+static void shadow_cache_free_cb(shadow_cache_data_t * node, void * user_data);
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs);
 
 /**********************
  *  STATIC VARIABLES
@@ -55,6 +78,69 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_draw_sw_shadow_cache_init(uint32_t size)
+{
+    if(shadow_cache_p != NULL) return;
+
+    shadow_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(shadow_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb
+    });
+
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_set_name(shadow_cache_p, CACHE_NAME);
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_destroy(shadow_cache_p, NULL);
+    shadow_cache_p = NULL;
+}
+
+void lv_draw_sw_shadow_cache_resize(uint32_t size, bool evict_now)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_set_max_size(shadow_cache_p, size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(shadow_cache_p, size, NULL);
+    }
+}
+
+void lv_draw_sw_shadow_cache_drop_all(void)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_drop_all(shadow_cache_p, NULL);
+}
+
+bool lv_draw_sw_shadow_cache_is_enabled(void)
+{
+    return shadow_cache_p != NULL && lv_cache_is_enabled(shadow_cache_p);
+}
+
+uint32_t lv_draw_sw_shadow_cache_get_hit_cnt(void)
+{
+    return shadow_cache_hit_cnt;
+}
+
+uint32_t lv_draw_sw_shadow_cache_get_miss_cnt(void)
+{
+    return shadow_cache_miss_cnt;
+}
+
+uint32_t lv_draw_sw_shadow_cache_get_size(void)
+{
+    if(shadow_cache_p == NULL) return 0;
+
+    return (uint32_t)lv_cache_get_size(shadow_cache_p, NULL);
+}
+
 void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -97,34 +183,11 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        LV_ASSERT_MALLOC(sh_buf);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        LV_ASSERT_MALLOC(sh_buf);
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
-    }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    LV_ASSERT_MALLOC(sh_buf);
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    /*The top right corner followed by the top left one*/
+    lv_cache_entry_t * corner_entry;
+    lv_opa_t * corner_buf = shadow_corner_get(&core_area, dsc->width, r_sh, &corner_entry);
+    if(corner_buf == NULL) return;
+    lv_opa_t * sh_buf = corner_buf;
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -382,22 +445,8 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
         }
     }
 
-    /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*Use the horizontally mirrored corner on the left side*/
+    sh_buf = corner_buf + corner_size * corner_size;
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -555,7 +604,7 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+    shadow_corner_release(corner_buf, corner_entry);
     lv_free(mask_buf);
 }
 
@@ -563,6 +612,92 @@ void lv_draw_sw_box_shadow(lv_draw_task_t * t, const lv_draw_box_shadow_dsc_t *
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the blurred corners of a shadow from the shadow cache or calculate them.
+ * @param core_area the rectangle which is blurred
+ * @param sw        shadow width
+ * @param r         the radius of `core_area`, clamped to the half of its shorter side
+ * @param entry     set to the cache entry of the corners or NULL if they are not cached
+ * @return          `(sw + r)^2` bytes of the top right corner followed by the horizontally mirrored
+ *                  top left corner, or NULL on out of memory. Release it with `shadow_corner_release()`.
+ */
+static lv_opa_t * shadow_corner_get(const lv_area_t * core_area, int32_t sw, int32_t r, lv_cache_entry_t ** entry)
+{
+    int32_t corner_size = sw + r;
+    uint32_t buf_size = (uint32_t)corner_size * corner_size * 2;
+
+    *entry = NULL;
+
+    /*Don't let a single huge shadow evict all the others*/
+    if(lv_draw_sw_shadow_cache_is_enabled() && buf_size <= lv_cache_get_max_size(shadow_cache_p, NULL) / 4) {
+        shadow_cache_data_t search_key;
+        search_key.slot.size = buf_size;
+        search_key.r = r;
+        search_key.sw = sw;
+        /*The far edges of a rectangle larger than twice the corner size don't reach into the corner,
+         *so shadows with different spread or object size can share the corners*/
+        search_key.core_w = LV_MIN(lv_area_get_width(core_area), corner_size * 2);
+        search_key.core_h = LV_MIN(lv_area_get_height(core_area), corner_size * 2);
+        search_key.corner_buf = NULL;
+
+        /*Shadows are drawn by several draw units, count under the cache's lock*/
+        lv_mutex_lock(&shadow_cache_p->lock);
+        bool created = false;
+        *entry = lv_cache_acquire_or_create(shadow_cache_p, &search_key, &created);
+        if(*entry != NULL) {
+            if(created) shadow_cache_miss_cnt++;
+            else shadow_cache_hit_cnt++;
+        }
+        lv_mutex_unlock(&shadow_cache_p->lock);
+
+        if(*entry != NULL) {
+            shadow_cache_data_t * cached_data = lv_cache_entry_get_data(*entry);
+            return cached_data->corner_buf;
+        }
+    }
+
+    return shadow_corner_create(core_area, sw, r);
+}
+
+static void shadow_corner_release(lv_opa_t * corner_buf, lv_cache_entry_t * entry)
+{
+    if(entry) lv_cache_release(shadow_cache_p, entry, NULL);
+    else lv_free(corner_buf);
+}
+
+/**
+ * Calculate the blurred top right corner and mirror it into the top left corner
+ * @param core_area the rectangle which is blurred
+ * @param sw        shadow width
+ * @param r         the clamped radius of `core_area`
+ * @return          a new buffer with the two corners, see `shadow_corner_get()`
+ */
+static lv_opa_t * shadow_corner_create(const lv_area_t * core_area, int32_t sw, int32_t r)
+{
+    int32_t corner_size = sw + r;
+
+    /*The calculation needs the 16 bit buffer, it's large enough for the two 8 bit corners too*/
+    lv_opa_t * corner_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(corner_buf);
+    if(corner_buf == NULL) return NULL;
+
+    shadow_draw_corner_buf(core_area, (uint16_t *)corner_buf, sw, r);
+
+    int32_t y;
+    const lv_opa_t * src = corner_buf;
+    lv_opa_t * dest = corner_buf + corner_size * corner_size;
+    for(y = 0; y < corner_size; y++) {
+        int32_t x;
+        for(x = 0; x < corner_size; x++) {
+            dest[x] = src[corner_size - 1 - x];
+        }
+        src += corner_size;
+        dest += corner_size;
+    }
+
+    return corner_buf;
+}
+
 /**
  * Calculate a blurred corner
  * @param coords Coordinates of the shadow
@@ -730,6 +865,44 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+static bool shadow_cache_create_cb(shadow_cache_data_t * node, void * user_data)
+{
+    /*The clamped size results in the same corners as the real one*/
+    lv_area_t core_area = {0, 0, node->core_w - 1, node->core_h - 1};
+    node->corner_buf = shadow_corner_create(&core_area, node->sw, node->r);
+    if(node->corner_buf == NULL) return false;
+
+    *(bool *)user_data = true;
+    return true;
+}
+
+static void shadow_cache_free_cb(shadow_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->corner_buf);
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs)
+{
+    if(lhs->r != rhs->r) {
+        return lhs->r > rhs->r ? 1 : -1;
+    }
+
+    if(lhs->sw != rhs->sw) {
+        return lhs->sw > rhs->sw ? 1 : -1;
+    }
+
+    if(lhs->core_w != rhs->core_w) {
+        return lhs->core_w > rhs->core_w ? 1 : -1;
+    }
+
+    if(lhs->core_h != rhs->core_h) {
+        return lhs->core_h > rhs->core_h ? 1 : -1;
+    }
+
+    return 0;
+}
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
@@ -12,6 +12,10 @@
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "../../core/lv_global.h"
+#include "../../stdlib/lv_string.h"
+#include "../../misc/cache/lv_cache.h"
+#include "../../misc/cache/lv_cache_private.h"
 
 /*********************
  *      DEFINES
@@ -19,6 +23,12 @@
 #define GRAD_CM(r,g,b) lv_color_make(r,g,b)
 #define GRAD_CONV(t, x) t = x
 
+#define CACHE_NAME  "SW_GRAD"
+
+#define grad_cache_p (LV_GLOBAL_DEFAULT()->sw_grad_cache)
+#define grad_cache_hit_cnt (LV_GLOBAL_DEFAULT()->sw_grad_cache_hit_cnt)
+#define grad_cache_miss_cnt (LV_GLOBAL_DEFAULT()->sw_grad_cache_miss_cnt)
+
 #undef ALIGN
 #if defined(LV_ARCH_64)
     #define ALIGN(X)    (((X) + 7) & ~7)
@@ -30,6 +40,18 @@
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    /*Key*/
+    uint32_t size;                                  /*Number of colors*/
+    uint8_t stops_count;
+    lv_grad_stop_t stops[LV_GRADIENT_MAX_STOPS];    /*Only the first `stops_count` are used*/
+
+    /*Data*/
+    lv_draw_sw_grad_calc_t * item;
+} grad_cache_data_t;
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 typedef struct {
@@ -73,7 +95,12 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_draw_sw_grad_calc_t * c, void * ctx);
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static lv_draw_sw_grad_calc_t * grad_calculate(const lv_grad_dsc_t * g, uint32_t size, bool shared);
+static lv_draw_sw_grad_calc_t * allocate_item(uint32_t size);
+static void fill_item(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item);
+static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data);
+static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data);
+static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs);
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
@@ -89,23 +116,55 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+/**
+ * Get the colors of a gradient from the gradient cache or calculate them.
+ * @param g         the gradient descriptor, only its stops are used
+ * @param size      number of colors to calculate
+ * @param shared    true: the colors are only read and can be taken from the cache
+ * @return          the colors or NULL on out of memory
+ */
+static lv_draw_sw_grad_calc_t * grad_calculate(const lv_grad_dsc_t * g, uint32_t size, bool shared)
 {
-    int32_t size;
-    switch(g->dir) {
-        case LV_GRAD_DIR_HOR:
-        case LV_GRAD_DIR_LINEAR:
-        case LV_GRAD_DIR_RADIAL:
-        case LV_GRAD_DIR_CONICAL:
-            size = w;
-            break;
-        case LV_GRAD_DIR_VER:
-            size = h;
-            break;
-        default:
-            size = 64;
+    uint32_t req_size = ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) +
+                        ALIGN(size * sizeof(lv_opa_t));
+
+    /*Don't let a single huge gradient evict all the others*/
+    if(shared && lv_draw_sw_grad_cache_is_enabled() && req_size <= lv_cache_get_max_size(grad_cache_p, NULL) / 4) {
+        grad_cache_data_t search_key;
+        search_key.slot.size = req_size;
+        search_key.size = size;
+        search_key.stops_count = g->stops_count;
+        lv_memcpy(search_key.stops, g->stops, g->stops_count * sizeof(lv_grad_stop_t));
+        search_key.item = NULL;
+
+        /*Gradients are drawn by several draw units, count under the cache's lock*/
+        lv_mutex_lock(&grad_cache_p->lock);
+        bool created = false;
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(grad_cache_p, &search_key, &created);
+        if(entry != NULL) {
+            if(created) grad_cache_miss_cnt++;
+            else grad_cache_hit_cnt++;
+        }
+        lv_mutex_unlock(&grad_cache_p->lock);
+
+        if(entry != NULL) {
+            grad_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+            return cached_data->item;
+        }
+    }
+
+    lv_draw_sw_grad_calc_t * item = allocate_item(size);
+    if(item == NULL) {
+        LV_LOG_WARN("Failed to allocate item for the gradient");
+        return item;
     }
 
+    fill_item(g, item);
+    return item;
+}
+
+static lv_draw_sw_grad_calc_t * allocate_item(uint32_t size)
+{
     size_t req_size = ALIGN(sizeof(lv_draw_sw_grad_calc_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(
                                                                                                            lv_opa_t));
     lv_draw_sw_grad_calc_t * item  = lv_malloc(req_size);
@@ -116,9 +175,61 @@ static lv_draw_sw_grad_calc_t * allocate_item(const lv_grad_dsc_t * g, int32_t w
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->cache_entry = NULL;
     return item;
 }
 
+static void fill_item(const lv_grad_dsc_t * g, lv_draw_sw_grad_calc_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data)
+{
+    node->item = allocate_item(node->size);
+    if(node->item == NULL) return false;
+
+    /*Only the stops are used to calculate the colors*/
+    lv_grad_dsc_t g;
+    lv_memzero(&g, sizeof(g));
+    lv_memcpy(g.stops, node->stops, node->stops_count * sizeof(lv_grad_stop_t));
+    g.stops_count = node->stops_count;
+    fill_item(&g, node->item);
+
+    /*Let `lv_draw_sw_grad_cleanup()` release the entry instead of freeing the colors*/
+    node->item->cache_entry = lv_cache_entry_get_entry(node, grad_cache_p->node_size);
+
+    *(bool *)user_data = true;
+    return true;
+}
+
+static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->item);
+}
+
+static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs)
+{
+    if(lhs->size != rhs->size) {
+        return lhs->size > rhs->size ? 1 : -1;
+    }
+
+    if(lhs->stops_count != rhs->stops_count) {
+        return lhs->stops_count > rhs->stops_count ? 1 : -1;
+    }
+
+    int cmp_res = lv_memcmp(lhs->stops, rhs->stops, lhs->stops_count * sizeof(lv_grad_stop_t));
+    if(cmp_res != 0) {
+        return cmp_res > 0 ? 1 : -1;
+    }
+
+    return 0;
+}
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -142,24 +253,93 @@ static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
  *     FUNCTIONS
  **********************/
 
+void lv_draw_sw_grad_cache_init(uint32_t size)
+{
+    if(grad_cache_p != NULL) return;
+
+    grad_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(grad_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) grad_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) grad_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) grad_cache_free_cb
+    });
+
+    if(grad_cache_p == NULL) return;
+
+    lv_cache_set_name(grad_cache_p, CACHE_NAME);
+}
+
+void lv_draw_sw_grad_cache_deinit(void)
+{
+    if(grad_cache_p == NULL) return;
+
+    lv_cache_destroy(grad_cache_p, NULL);
+    grad_cache_p = NULL;
+}
+
+void lv_draw_sw_grad_cache_resize(uint32_t size, bool evict_now)
+{
+    if(grad_cache_p == NULL) return;
+
+    lv_cache_set_max_size(grad_cache_p, size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(grad_cache_p, size, NULL);
+    }
+}
+
+void lv_draw_sw_grad_cache_drop_all(void)
+{
+    if(grad_cache_p == NULL) return;
+
+    lv_cache_drop_all(grad_cache_p, NULL);
+}
+
+bool lv_draw_sw_grad_cache_is_enabled(void)
+{
+    return grad_cache_p != NULL && lv_cache_is_enabled(grad_cache_p);
+}
+
+uint32_t lv_draw_sw_grad_cache_get_hit_cnt(void)
+{
+    return grad_cache_hit_cnt;
+}
+
+uint32_t lv_draw_sw_grad_cache_get_miss_cnt(void)
+{
+    return grad_cache_miss_cnt;
+}
+
+uint32_t lv_draw_sw_grad_cache_get_size(void)
+{
+    if(grad_cache_p == NULL) return 0;
+
+    return (uint32_t)lv_cache_get_size(grad_cache_p, NULL);
+}
+
 lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
 {
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 1: Search cache for the given key */
-    lv_draw_sw_grad_calc_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
-        return item;
+    int32_t size;
+    switch(g->dir) {
+        case LV_GRAD_DIR_HOR:
+        case LV_GRAD_DIR_LINEAR:
+        case LV_GRAD_DIR_RADIAL:
+        case LV_GRAD_DIR_CONICAL:
+            size = w;
+            break;
+        case LV_GRAD_DIR_VER:
+            size = h;
+            break;
+        default:
+            size = 64;
     }
 
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_draw_sw_grad_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
-    return item;
+    /*The colors of horizontal and vertical gradients are only read, so they can be shared.
+     *The other directions use them as a buffer to calculate the lines.*/
+    bool shared = g->dir == LV_GRAD_DIR_HOR || g->dir == LV_GRAD_DIR_VER;
+    return grad_calculate(g, size, shared);
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
@@ -217,7 +397,8 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t *
 
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad)
 {
-    lv_free(grad);
+    if(grad->cache_entry) lv_cache_release(grad_cache_p, grad->cache_entry, NULL);
+    else lv_free(grad);
 }
 
 
@@ -295,7 +476,7 @@ void lv_draw_sw_grad_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = grad_calculate(dsc, 256, true);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -464,7 +645,7 @@ void lv_draw_sw_grad_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = grad_calculate(dsc, 256, true);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -492,7 +673,7 @@ void lv_draw_sw_grad_linear_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
@@ -539,7 +720,7 @@ void lv_draw_sw_grad_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_draw_sw_grad_get(dsc, 256, 0);
+    state->cgrad = grad_calculate(dsc, 256, true);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -564,7 +745,7 @@ void lv_draw_sw_grad_conical_cleanup(lv_grad_dsc_t * dsc)
     if(state == NULL)
         return;
     if(state->cgrad)
-        lv_free(state->cgrad);
+        lv_draw_sw_grad_cleanup(state->cgrad);
     lv_free(state);
 }
 
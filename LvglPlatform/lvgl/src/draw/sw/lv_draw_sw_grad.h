@@ -30,6 +30,7 @@ typedef struct {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_cache_entry_t * cache_entry;     /*The entry in the gradient cache or NULL if not cached*/
 } lv_draw_sw_grad_calc_t;
 
 
@@ -49,11 +50,20 @@ typedef struct {
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_grad_color_calculate(const lv_grad_dsc_t * dsc, int32_t range,
                                                                  int32_t frac, lv_color_t * color_out, lv_opa_t * opa_out);
 
-/** Get a gradient cache from the given parameters */
+/**
+ * Get the colors of a gradient from the given parameters.
+ * Horizontal and vertical gradients are taken from the gradient cache if it's enabled,
+ * so their colors must not be modified. Other gradients are only used as a buffer for
+ * `lv_draw_sw_grad_..._get_line()`.
+ * @param gradient  the gradient descriptor
+ * @param w         the width of the area to fill
+ * @param h         the height of the area to fill
+ * @return          the colors or NULL if there is no gradient. Free it with `lv_draw_sw_grad_cleanup()`.
+ */
 lv_draw_sw_grad_calc_t * lv_draw_sw_grad_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h);
 
 /**
- * Clean up the gradient item after it was get with `lv_grad_get_from_cache`.
+ * Clean up the gradient item after it was get with `lv_draw_sw_grad_get`.
  * @param grad      pointer to a gradient
  */
 void lv_draw_sw_grad_cleanup(lv_draw_sw_grad_calc_t * grad);
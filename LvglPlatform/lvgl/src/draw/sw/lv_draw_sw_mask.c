@@ -21,10 +21,35 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 #define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
 #define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define circle_cache_overflow           LV_GLOBAL_DEFAULT()->sw_circle_cache_overflow
+
+/*The cached circles are never changed or freed while drawing, so the draw threads can find them
+ *without locking. A new circle is published with an atomic compare-and-swap.*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define CIRCLE_CACHE_LOCK_FREE      1
+    #define CIRCLE_LOAD(slot)           __atomic_load_n(&(slot), __ATOMIC_ACQUIRE)
+    #define CIRCLE_CAS(slot, exp, c)    __atomic_compare_exchange_n(&(slot), &(exp), c, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    /*Volatile reads have acquire semantics on x86 (/volatile:ms)*/
+    #define CIRCLE_CACHE_LOCK_FREE      1
+    #define CIRCLE_LOAD(slot)           (*(lv_draw_sw_mask_radius_circle_dsc_t * volatile *)&(slot))
+    #define CIRCLE_CAS(slot, exp, c)    circle_cas_msvc((void * volatile *)&(slot), (void **)&(exp), c)
+#else
+    #define CIRCLE_CACHE_LOCK_FREE      0
+    #define CIRCLE_LOAD(slot)           (slot)
+    #define CIRCLE_CAS(slot, exp, c)    ((slot) = (c), true)   /*Called only on empty slots with the mutex locked*/
+#endif
+
+#if CIRCLE_CACHE_LOCK_FREE
+    #define CIRCLE_CACHE_LOCK()
+    #define CIRCLE_CACHE_UNLOCK()
+#else
+    #define CIRCLE_CACHE_LOCK()         lv_mutex_lock(&circle_cache_mutex)
+    #define CIRCLE_CACHE_UNLOCK()       lv_mutex_unlock(&circle_cache_mutex)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -61,6 +86,13 @@ static lv_draw_sw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ line_mask_steep(lv_opa_
 static void circ_init(lv_point_t * c, int32_t * tmp, int32_t radius);
 static bool circ_cont(lv_point_t * c);
 static void circ_next(lv_point_t * c, int32_t * tmp);
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius);
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_create(int32_t radius);
+static void circle_delete(lv_draw_sw_mask_radius_circle_dsc_t * c);
+static void circle_cache_drop_all(void);
+#if defined(_MSC_VER) && !defined(__clang__) && CIRCLE_CACHE_LOCK_FREE
+    static bool circle_cas_msvc(void * volatile * slot, void ** expected, void * c);
+#endif
 static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius);
 static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
@@ -85,6 +117,7 @@ void lv_draw_sw_mask_init(void)
 
 void lv_draw_sw_mask_deinit(void)
 {
+    circle_cache_drop_all();
     lv_mutex_delete(&circle_cache_mutex);
 }
 
@@ -109,32 +142,23 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
-        if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+        if(radius_p->circle && !radius_p->circle->cached) {
+            circle_delete(radius_p->circle);
         }
+        radius_p->circle = NULL;
     }
-
-    lv_mutex_unlock(&circle_cache_mutex);
 }
 
 void lv_draw_sw_mask_cleanup(void)
 {
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
-        }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
+    /*Make room for the circles which didn't fit into the cache.
+     *No draw task is running now, so no one uses the cached circles*/
+    if(circle_cache_overflow) {
+        circle_cache_drop_all();
+        circle_cache_overflow = false;
     }
 }
 
@@ -311,47 +335,7 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
-
-    uint32_t i;
-
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
-            return;
-        }
-    }
-
-    /*If not cached use the free entry with lowest life*/
-    lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
-    }
-
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
-    }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
-    }
-
-    param->circle = entry;
-
-    circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
-
+    param->circle = circle_cache_get(radius);
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -1068,14 +1052,99 @@ static void circ_next(lv_point_t * c, int32_t * tmp)
     c->y++;
 }
 
+#if defined(_MSC_VER) && !defined(__clang__) && CIRCLE_CACHE_LOCK_FREE
+static bool circle_cas_msvc(void * volatile * slot, void ** expected, void * c)
+{
+    void * act = _InterlockedCompareExchangePointer(slot, c, *expected);
+    if(act == *expected) return true;
+
+    *expected = act;
+    return false;
+}
+#endif
+
+/**
+ * Get the circle of a radius from the cache, or calculate and add it to the cache.
+ * The circles are stored in an open addressing hash table by radius and stay there until the
+ * table overflows. Then it's cleared by `lv_draw_sw_mask_cleanup()` when no drawing is in progress.
+ * @param radius    the radius of the circle
+ * @return          the circle. If it's not `cached` it needs to be freed.
+ */
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_cache_get(int32_t radius)
+{
+    lv_draw_sw_mask_radius_circle_dsc_t * new_c = NULL;
+
+    CIRCLE_CACHE_LOCK();
+
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    uint32_t start = (uint32_t)radius % LV_DRAW_SW_CIRCLE_CACHE_SIZE;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        lv_draw_sw_mask_radius_circle_dsc_t ** slot = &_circle_cache[(start + i) % LV_DRAW_SW_CIRCLE_CACHE_SIZE];
+        lv_draw_sw_mask_radius_circle_dsc_t * c = CIRCLE_LOAD(*slot);
+
+        /*Circles are not removed while drawing, so the radius is not cached if there is an empty slot.
+         *Add it there, unless another thread has just added a circle to the same slot.*/
+        if(c == NULL) {
+            if(new_c == NULL) new_c = circle_create(radius);
+            if(CIRCLE_CAS(*slot, c, new_c)) {
+                CIRCLE_CACHE_UNLOCK();
+                return new_c;
+            }
+        }
+
+        if(c->radius == radius) {
+            CIRCLE_CACHE_UNLOCK();
+            if(new_c) circle_delete(new_c);
+            return c;
+        }
+    }
+
+    circle_cache_overflow = true;
+#endif
+
+    CIRCLE_CACHE_UNLOCK();
+
+    /*There is no room in the cache, use the circle only for this mask*/
+    if(new_c == NULL) new_c = circle_create(radius);
+    new_c->cached = false;
+    return new_c;
+}
+
+static lv_draw_sw_mask_radius_circle_dsc_t * circle_create(int32_t radius)
+{
+    lv_draw_sw_mask_radius_circle_dsc_t * c = lv_malloc_zeroed(sizeof(lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(c);
+    circ_calc_aa4(c, radius);
+    c->cached = true;
+    return c;
+}
+
+static void circle_delete(lv_draw_sw_mask_radius_circle_dsc_t * c)
+{
+    lv_free(c->buf);
+    lv_free(c);
+}
+
+static void circle_cache_drop_all(void)
+{
+#if LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+        if(_circle_cache[i]) {
+            circle_delete(_circle_cache[i]);
+            _circle_cache[i] = NULL;
+        }
+    }
+#endif
+}
+
 static void circ_calc_aa4(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radius)
 {
     if(radius == 0) return;
     c->radius = radius;
 
     /*Allocate buffers*/
-    if(c->buf) lv_free(c->buf);
-
     c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
@@ -31,9 +31,8 @@ typedef struct  {
     lv_opa_t * cir_opa;         /**< Opacity of values on the circumference of an 1/4 circle */
     uint16_t * x_start_on_y;    /**< The x coordinate of the circle for each y value */
     uint16_t * opa_start_on_y;  /**< The index of `cir_opa` for each y value */
-    int32_t life;               /**< How many times the entry way used */
-    uint32_t used_cnt;          /**< Like a semaphore to count the referencing masks */
     int32_t radius;             /**< The radius of the entry */
+    bool cached;                /**< false: not in the cache, freed with the mask */
 } lv_draw_sw_mask_radius_circle_dsc_t;
 
 struct _lv_draw_sw_mask_common_dsc_t {
@@ -132,15 +131,15 @@ struct _lv_draw_sw_mask_map_param_t {
     } cfg;
 };
 
-typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
+typedef lv_draw_sw_mask_radius_circle_dsc_t * lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
 
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Called by LVGL when the rendering of a screen is ready.
+ * Clears the circle cache if some radii didn't fit into it, so that the next frames can cache them.
  */
 void lv_draw_sw_mask_cleanup(void);
 
@@ -33,6 +33,7 @@ extern "C" {
 
 typedef struct {
     lv_draw_task_t * task_act;
+    bool task_act_split;            /*`task_act` is drawn in bands together with other threads*/
     lv_thread_t thread;
     lv_thread_sync_t sync;
     lv_draw_unit_t * draw_unit;
@@ -41,23 +42,43 @@ typedef struct {
     volatile bool exit_status;
 } lv_draw_sw_thread_dsc_t;
 
+/**
+ * A row of a transformed image, for the instruction set specific kernels.
+ * The pixels from `x_start` to `x_end` and their neighbors are all inside the source image.
+ */
+typedef struct {
+    const uint8_t * src;
+    int32_t src_w;
+    int32_t src_h;
+    int32_t src_stride;
+    int32_t xs_ups;             /**< Source X coordinate of the first pixel of the row in 1/256 pixels*/
+    int32_t ys_ups;             /**< Source Y coordinate of the first pixel of the row in 1/256 pixels*/
+    int32_t xs_step;            /**< Change of `xs_ups` from pixel to pixel in 1/256 units*/
+    int32_t ys_step;            /**< Change of `ys_ups` from pixel to pixel in 1/256 units*/
+    int32_t x_start;            /**< The first pixel to transform*/
+    int32_t x_end;              /**< The pixel after the last one to transform*/
+    void * dest_buf;            /**< The first pixel of the row*/
+    uint8_t * alpha_buf;        /**< The first pixel of the alpha row for RGB565 and RGB565A8 images*/
+    bool aa;
+} lv_draw_sw_transform_row_dsc_t;
+
 struct _lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
 #if LV_USE_OS
     lv_draw_sw_thread_dsc_t thread_dscs[LV_DRAW_SW_DRAW_UNIT_CNT];
+    uint32_t thread_cnt;            /*The number of threads which can take tasks*/
+#if LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_BAND_HEIGHT
+    lv_mutex_t split_lock;          /*Protects the `split_...` fields*/
+    lv_draw_task_t * split_task;    /*A large task drawn in bands by the idle threads*/
+    lv_area_t split_area;           /*The area of `split_task` to draw*/
+    int32_t split_next_y;           /*The first row of the next band no thread has taken yet*/
+    uint32_t split_thread_cnt;      /*The number of threads still drawing the bands of `split_task`*/
+#endif
 #else
     lv_draw_task_t * task_act;
 #endif
 };
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
-#endif
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -6,7 +6,7 @@
 /*********************
  *      INCLUDES
  *********************/
-#include "lv_draw_sw.h"
+#include "lv_draw_sw_private.h"
 #if LV_USE_DRAW_SW
 
 #include "../../misc/lv_assert.h"
@@ -15,10 +15,35 @@
 #include "../../misc/lv_color.h"
 #include "../../stdlib/lv_string.h"
 
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+    #include "blend/neon/lv_blend_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "blend/helium/lv_blend_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+    #include "blend/sse2/lv_blend_sse2.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
+    #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 
+/*The kernels transform the inner part of a row and return LV_RESULT_INVALID
+ *if the C implementation should be used instead*/
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+    #define LV_DRAW_SW_TRANSFORM_ARGB8888(...)                  LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB888
+    #define LV_DRAW_SW_TRANSFORM_RGB888(...)                    LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+    #define LV_DRAW_SW_TRANSFORM_RGB565A8(...)                  LV_RESULT_INVALID
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -51,22 +76,28 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
+#if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888 || LV_DRAW_SW_SUPPORT_ARGB8888 || LV_DRAW_SW_SUPPORT_RGB565A8
+static void row_dsc_init(lv_draw_sw_transform_row_dsc_t * row, const uint8_t * src, int32_t src_w, int32_t src_h,
+                         int32_t src_stride, int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                         int32_t x_end, void * dest_buf, uint8_t * alpha_buf, bool aa);
+#endif
+
 #if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_ARGB8888
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa);
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_RGB565A8
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
 #endif
 
 #if LV_DRAW_SW_SUPPORT_A8
@@ -201,11 +232,29 @@ void lv_draw_sw_transform(const lv_area_t * dest_area, const void * src_buf,
         ys_ups_start = ys1_ups + 0x80;
     }
 
+    /*Without rotation and anti-aliasing the rows from the same source row are the same,
+     *e.g. when zooming by an integer factor. Copy them instead of transforming them again.*/
+    int32_t ys_int_prev = -1;
+    bool copy_rows = is_rotated == false && aa == false;
+    lv_draw_sw_transform_row_dsc_t row_dsc;
+    LV_UNUSED(row_dsc);
+
     int32_t y;
     for(y = 0; y < dest_h; y++) {
         if(is_rotated == false) {
             ys_ups = ys_ups_start + ((ys_step_256_original * y) >> 8);
             ys_step_256 = 0;
+
+            /*On the first and last source rows the vertical neighbors are mixed in too*/
+            int32_t ys_int = ys_ups >> 8;
+            if(copy_rows && ys_int == ys_int_prev && ys_int > 0 && ys_int < src_h - 1) {
+                lv_memcpy(dest_buf, (uint8_t *)dest_buf - dest_stride, dest_stride);
+                if(alpha_buf) lv_memcpy(alpha_buf, alpha_buf - dest_stride_a8, dest_stride_a8);
+                dest_buf = (uint8_t *)dest_buf + dest_stride;
+                if(alpha_buf) alpha_buf += dest_stride_a8;
+                continue;
+            }
+            ys_int_prev = ys_int;
         }
         else {
             int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
@@ -226,16 +275,26 @@ void lv_draw_sw_transform(const lv_area_t * dest_area, const void * src_buf,
         }
 
         switch(src_cf) {
+#if LV_DRAW_SW_SUPPORT_XRGB8888 || LV_DRAW_SW_SUPPORT_RGB888
 #if LV_DRAW_SW_SUPPORT_XRGB8888
             case LV_COLOR_FORMAT_XRGB8888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 4);
-                break;
 #endif
 #if LV_DRAW_SW_SUPPORT_RGB888
             case LV_COLOR_FORMAT_RGB888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 3);
+#endif
+                {
+                    uint32_t px_size = src_cf == LV_COLOR_FORMAT_RGB888 ? 3 : 4;
+                    row_dsc_init(&row_dsc, src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                 dest_w, dest_buf, NULL, aa);
+                    if(LV_RESULT_INVALID == LV_DRAW_SW_TRANSFORM_RGB888(&row_dsc, px_size)) {
+                        row_dsc.x_start = dest_w;
+                        row_dsc.x_end = dest_w;
+                    }
+                    transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                     0, row_dsc.x_start, dest_buf, aa, px_size);
+                    transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                     row_dsc.x_end, dest_w, dest_buf, aa, px_size);
+                }
                 break;
 #endif
 #if LV_DRAW_SW_SUPPORT_A8
@@ -245,21 +304,36 @@ void lv_draw_sw_transform(const lv_area_t * dest_area, const void * src_buf,
 #endif
 #if LV_DRAW_SW_SUPPORT_ARGB8888
             case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
+                row_dsc_init(&row_dsc, src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                             dest_w, dest_buf, NULL, aa);
+                if(LV_RESULT_INVALID == LV_DRAW_SW_TRANSFORM_ARGB8888(&row_dsc)) {
+                    row_dsc.x_start = dest_w;
+                    row_dsc.x_end = dest_w;
+                }
+                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                   0, row_dsc.x_start, dest_buf, aa);
+                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                   row_dsc.x_end, dest_w, dest_buf, aa);
                 break;
 #endif
-#if LV_DRAW_SW_SUPPORT_RGB565 && LV_DRAW_SW_SUPPORT_RGB565A8
+#if LV_DRAW_SW_SUPPORT_RGB565A8
+#if LV_DRAW_SW_SUPPORT_RGB565
             case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
-                break;
 #endif
-#if LV_DRAW_SW_SUPPORT_RGB565A8
             case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
+                {
+                    bool src_has_a8 = src_cf == LV_COLOR_FORMAT_RGB565A8;
+                    row_dsc_init(&row_dsc, src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                 dest_w, dest_buf, alpha_buf, aa);
+                    if(LV_RESULT_INVALID == LV_DRAW_SW_TRANSFORM_RGB565A8(&row_dsc, src_has_a8)) {
+                        row_dsc.x_start = dest_w;
+                        row_dsc.x_end = dest_w;
+                    }
+                    transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                       0, row_dsc.x_start, dest_buf, alpha_buf, src_has_a8, aa);
+                    transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                       row_dsc.x_end, dest_w, dest_buf, alpha_buf, src_has_a8, aa);
+                }
                 break;
 #endif
 
@@ -285,18 +359,63 @@ void lv_draw_sw_transform(const lv_area_t * dest_area, const void * src_buf,
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888 || LV_DRAW_SW_SUPPORT_ARGB8888 || LV_DRAW_SW_SUPPORT_RGB565A8
+
+/**
+ * Initialize the descriptor of a row for the kernels, and find the range of pixels whose
+ * neighbors are inside the source image too. Only the pixels outside of this range need
+ * the checks of the C implementation.
+ */
+static void row_dsc_init(lv_draw_sw_transform_row_dsc_t * row, const uint8_t * src, int32_t src_w, int32_t src_h,
+                         int32_t src_stride, int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                         int32_t x_end, void * dest_buf, uint8_t * alpha_buf, bool aa)
+{
+    row->src = src;
+    row->src_w = src_w;
+    row->src_h = src_h;
+    row->src_stride = src_stride;
+    row->xs_ups = xs_ups;
+    row->ys_ups = ys_ups;
+    row->xs_step = xs_step;
+    row->ys_step = ys_step;
+    row->dest_buf = dest_buf;
+    row->alpha_buf = alpha_buf;
+    row->aa = aa;
+
+    /*The source coordinates change monotonically along the row, so the inner pixels are next to each other*/
+    int32_t x_start = 0;
+    while(x_start < x_end) {
+        int32_t xs_int = (xs_ups + ((xs_step * x_start) >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + ((ys_step * x_start) >> 8)) >> 8;
+        if(xs_int >= 1 && xs_int < src_w - 1 && ys_int >= 1 && ys_int < src_h - 1) break;
+        x_start++;
+    }
+
+    while(x_end > x_start) {
+        int32_t xs_int = (xs_ups + ((xs_step * (x_end - 1)) >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + ((ys_step * (x_end - 1)) >> 8)) >> 8;
+        if(xs_int >= 1 && xs_int < src_w - 1 && ys_int >= 1 && ys_int < src_h - 1) break;
+        x_end--;
+    }
+
+    row->x_start = x_start;
+    row->x_end = x_end;
+}
+
+#endif
+
 #if LV_DRAW_SW_SUPPORT_RGB888 || LV_DRAW_SW_SUPPORT_XRGB8888
 
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -389,14 +508,14 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa)
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -482,7 +601,7 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
@@ -493,7 +612,7 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
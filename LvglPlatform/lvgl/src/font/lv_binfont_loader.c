@@ -121,6 +121,12 @@ void lv_binfont_destroy(lv_font_t * font)
     const lv_font_fmt_txt_dsc_t * dsc = font->dsc;
     if(dsc == NULL) return;
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    lv_font_fmt_txt_glyph_index_remove(dsc);
+#endif
+    lv_font_glyph_cache_drop_all();
+    lv_font_glyph_atlas_drop_all();
+
     if(dsc->kern_classes == 0) {
         const lv_font_fmt_txt_kern_pair_t * kern_dsc = dsc->kern_dsc;
         if(NULL != kern_dsc) {
@@ -8,10 +8,13 @@
  *********************/
 
 #include "lv_font.h"
+#include "lv_font_fmt_txt.h"
 #include "../misc/lv_text_private.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
+#include "../misc/cache/lv_font_glyph_cache.h"
+#include "../misc/cache/lv_font_glyph_atlas.h"
 #include "../stdlib/lv_string.h"
 
 /*********************
@@ -26,6 +29,9 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static bool resolve_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                              uint32_t letter_next);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -52,6 +58,13 @@ const void * lv_font_get_glyph_bitmap(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t
 {
     const lv_font_t * font_p = g_dsc->resolved_font;
     LV_ASSERT_NULL(font_p);
+
+    /*Unpack the bitmaps of built-in format fonts only once*/
+    if(font_p->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt && lv_font_glyph_atlas_is_enabled()) {
+        const lv_draw_buf_t * atlas_buf = lv_font_glyph_atlas_get(g_dsc);
+        if(atlas_buf) return atlas_buf;
+    }
+
     return font_p->get_glyph_bitmap(g_dsc, draw_buf);
 }
 
@@ -67,6 +80,9 @@ void lv_font_glyph_release_draw_data(lv_font_glyph_dsc_t * g_dsc)
     if(font != NULL && font->release_glyph) {
         font->release_glyph(font, g_dsc);
     }
+    else if(font != NULL && font->get_glyph_bitmap == lv_font_get_bitmap_fmt_txt) {
+        lv_font_glyph_atlas_release(g_dsc);
+    }
 }
 
 bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
@@ -76,6 +92,65 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
     LV_ASSERT_NULL(font_p);
     LV_ASSERT_NULL(dsc_out);
 
+    /*Built-in format fonts find a glyph faster than the cache could*/
+    if(font_p->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt || !lv_font_glyph_cache_is_enabled()) {
+        return resolve_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    }
+
+    /*Without kerning the next letter doesn't matter, so don't store a descriptor for each pair*/
+    if(font_p->kerning == LV_FONT_KERNING_NONE && font_p->fallback == NULL) letter_next = 0;
+
+    bool found;
+    if(lv_font_glyph_cache_get(font_p, letter, letter_next, dsc_out, &found)) {
+        return found;
+    }
+
+    found = resolve_glyph_dsc(font_p, dsc_out, letter, letter_next);
+    lv_font_glyph_cache_add(font_p, letter, letter_next, dsc_out, found);
+    return found;
+}
+
+uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    LV_ASSERT_NULL(font);
+    lv_font_glyph_dsc_t g;
+
+    /*Return zero if letter is marker*/
+    if(lv_text_is_marker(letter)) return 0;
+
+    lv_font_get_glyph_dsc(font, &g, letter, letter_next);
+    return g.adv_w;
+}
+
+void lv_font_set_kerning(lv_font_t * font, lv_font_kerning_t kerning)
+{
+    LV_ASSERT_NULL(font);
+    if(font->kerning == kerning) return;
+
+    font->kerning = kerning;
+
+    /*The cached advances of this font and of every font using it as a fallback were kerned the old way*/
+    if(lv_font_glyph_cache_is_enabled()) lv_font_glyph_cache_drop_all();
+}
+
+int32_t lv_font_get_line_height(const lv_font_t * font)
+{
+    return font->line_height;
+}
+
+
+const lv_font_t * lv_font_get_default(void)
+{
+    return lv_font_default;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool resolve_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                              uint32_t letter_next)
+{
 #if LV_USE_FONT_PLACEHOLDER
     const lv_font_t * placeholder_font = NULL;
 #endif
@@ -126,36 +201,3 @@ bool lv_font_get_glyph_dsc(const lv_font_t * font_p, lv_font_glyph_dsc_t * dsc_o
 
     return false;
 }
-
-uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
-{
-    LV_ASSERT_NULL(font);
-    lv_font_glyph_dsc_t g;
-
-    /*Return zero if letter is marker*/
-    if(lv_text_is_marker(letter)) return 0;
-
-    lv_font_get_glyph_dsc(font, &g, letter, letter_next);
-    return g.adv_w;
-}
-
-void lv_font_set_kerning(lv_font_t * font, lv_font_kerning_t kerning)
-{
-    LV_ASSERT_NULL(font);
-    font->kerning = kerning;
-}
-
-int32_t lv_font_get_line_height(const lv_font_t * font)
-{
-    return font->line_height;
-}
-
-
-const lv_font_t * lv_font_get_default(void)
-{
-    return lv_font_default;
-}
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
@@ -169,7 +169,8 @@ uint16_t lv_font_get_glyph_width(const lv_font_t * font, uint32_t letter, uint32
 int32_t lv_font_get_line_height(const lv_font_t * font);
 
 /**
- * Configure the use of kerning information stored in a font
+ * Configure the use of kerning information stored in a font.
+ * A change drops the glyph descriptor cache.
  * @param font    pointer to a font
  * @param kerning `LV_FONT_KERNING_NORMAL` (default) or `LV_FONT_KERNING_NONE`
  */
@@ -22,6 +22,40 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    #define glyph_index_state LV_GLOBAL_DEFAULT()->font_fmt_txt_glyph_index
+    #define GLYPH_INDEX_PAGE_SHIFT  8
+    #define GLYPH_INDEX_PAGE_SIZE   (1 << GLYPH_INDEX_PAGE_SHIFT)
+
+/*Lookups don't lock, they are only counted. A removed index is freed once the lookups that could
+ *still read it are finished: lookups of other fonts in the same cluster of slots might.
+ *Removing doesn't wait for them, the index is retired and freed by a later removal instead.*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define GLYPH_INDEX_LOCK_FREE           1
+    #define GLYPH_INDEX_LOAD(slot)          __atomic_load_n(&(slot), __ATOMIC_SEQ_CST)
+    #define GLYPH_INDEX_STORE(slot, index)  __atomic_store_n(&(slot), index, __ATOMIC_SEQ_CST)
+    #define GLYPH_INDEX_LOAD_CNT(cnt)       __atomic_load_n(&(cnt), __ATOMIC_SEQ_CST)
+    #define GLYPH_INDEX_INC(cnt)            __atomic_add_fetch(&(cnt), 1, __ATOMIC_SEQ_CST)
+    #define GLYPH_INDEX_DEC(cnt)            __atomic_sub_fetch(&(cnt), 1, __ATOMIC_RELEASE)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    /*Volatile reads have acquire semantics on x86 (/volatile:ms), the interlocked functions are full barriers*/
+    #define GLYPH_INDEX_LOCK_FREE           1
+    #define GLYPH_INDEX_LOAD(slot)          (*(lv_font_fmt_txt_glyph_index_t * volatile *)&(slot))
+    #define GLYPH_INDEX_STORE(slot, index)  _InterlockedExchangePointer((void * volatile *)&(slot), index)
+    #define GLYPH_INDEX_LOAD_CNT(cnt)       (*(volatile long *)&(cnt))
+    #define GLYPH_INDEX_INC(cnt)            _InterlockedIncrement(&(cnt))
+    #define GLYPH_INDEX_DEC(cnt)            _InterlockedDecrement(&(cnt))
+#else
+    /*Lookups lock the mutex instead, so they are never counted*/
+    #define GLYPH_INDEX_LOCK_FREE           0
+    #define GLYPH_INDEX_LOAD(slot)          (slot)
+    #define GLYPH_INDEX_STORE(slot, index)  ((slot) = (index))
+    #define GLYPH_INDEX_LOAD_CNT(cnt)       (cnt)
+    #define GLYPH_INDEX_INC(cnt)            (++(cnt))
+#endif
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -30,10 +64,35 @@ typedef struct {
     uint32_t gid_right;
 } kern_pair_ref_t;
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+/**
+ * Two level codepoint to glyph ID table of a font. Codepoints are split into pages of
+ * `GLYPH_INDEX_PAGE_SIZE` and only pages with characters get a row of glyph IDs.
+ */
+struct _lv_font_fmt_txt_glyph_index_t {
+    const lv_font_fmt_txt_dsc_t * dsc;
+    uint32_t page_cnt;      /**< Pages up to the last character. 0 if the font can't be indexed.*/
+    uint16_t * page_map;    /**< Row of each page in `glyph_ids` plus one, 0 for pages without characters*/
+    uint16_t * glyph_ids;   /**< `GLYPH_INDEX_PAGE_SIZE` glyph IDs for each page with characters*/
+    lv_font_fmt_txt_glyph_index_t * next_retired;   /**< Next removed index waiting to be freed*/
+    uint32_t retired_epoch; /**< Lookups of this epoch (0 or 1) might still read the removed index*/
+};
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static inline uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    static const lv_font_fmt_txt_glyph_index_t * get_glyph_index(const lv_font_fmt_txt_dsc_t * fdsc);
+    static lv_font_fmt_txt_glyph_index_t * build_glyph_index(const lv_font_fmt_txt_dsc_t * fdsc);
+    static void insert_glyph_index(lv_font_fmt_txt_glyph_index_t * index);
+    static uint32_t glyph_index_read_begin(void);
+    static void glyph_index_read_end(uint32_t epoch);
+    static void free_retired_glyph_indexes(void);
+    static uint32_t glyph_index_slot(const lv_font_fmt_txt_dsc_t * fdsc);
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
@@ -251,15 +310,104 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+
+void lv_font_fmt_txt_glyph_index_init(void)
+{
+    lv_mutex_init(&glyph_index_state.mutex);
+}
+
+void lv_font_fmt_txt_glyph_index_deinit(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT; i++) {
+        lv_free(glyph_index_state.indexes[i]);
+        glyph_index_state.indexes[i] = NULL;
+    }
+
+    while(glyph_index_state.retired) {
+        lv_font_fmt_txt_glyph_index_t * index = glyph_index_state.retired;
+        glyph_index_state.retired = index->next_retired;
+        lv_free(index);
+    }
+
+    lv_mutex_delete(&glyph_index_state.mutex);
+}
+
+void lv_font_fmt_txt_glyph_index_remove(const lv_font_fmt_txt_dsc_t * dsc)
+{
+    lv_mutex_lock(&glyph_index_state.mutex);
+
+    lv_font_fmt_txt_glyph_index_t ** indexes = glyph_index_state.indexes;
+    lv_font_fmt_txt_glyph_index_t * removed = NULL;
+    uint32_t i = glyph_index_slot(dsc);
+    uint32_t n;
+    for(n = 0; n < LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT && indexes[i]; n++) {
+        if(indexes[i]->dsc == dsc) {
+            removed = indexes[i];
+            GLYPH_INDEX_STORE(indexes[i], NULL);
+
+            /*Insert the rest of the cluster again so that lookups of these fonts don't stop at the gap.
+             *A lookup missing a font meanwhile waits for the mutex to build its index and finds it then.*/
+            i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+            while(indexes[i]) {
+                lv_font_fmt_txt_glyph_index_t * index = indexes[i];
+                GLYPH_INDEX_STORE(indexes[i], NULL);
+                insert_glyph_index(index);
+                i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+            }
+            break;
+        }
+        i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+    }
+
+    if(removed) {
+        /*Lookups starting from now can't find it anymore and are counted in the other epoch*/
+        removed->retired_epoch = (GLYPH_INDEX_INC(glyph_index_state.epoch) - 1) & 1;
+        removed->next_retired = glyph_index_state.retired;
+        glyph_index_state.retired = removed;
+    }
+    free_retired_glyph_indexes();
+
+    lv_mutex_unlock(&glyph_index_state.mutex);
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+static inline uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
-    if(letter == '\0') return 0;
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
 
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    uint32_t glyph_id = 0;
+
+    uint32_t epoch = glyph_index_read_begin();
+    const lv_font_fmt_txt_glyph_index_t * index = get_glyph_index(fdsc);
+    if(index == NULL) {
+        glyph_id = search_glyph_dsc_id(fdsc, letter);
+    }
+    else {
+        uint32_t page = letter >> GLYPH_INDEX_PAGE_SHIFT;
+        uint32_t row = page < index->page_cnt ? index->page_map[page] : 0;
+        if(row != 0) {
+            glyph_id = index->glyph_ids[((row - 1) << GLYPH_INDEX_PAGE_SHIFT) + (letter & (GLYPH_INDEX_PAGE_SIZE - 1))];
+        }
+    }
+    glyph_index_read_end(epoch);
+
+    return glyph_id;
+#else
+    return search_glyph_dsc_id(fdsc, letter);
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
+}
+
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    if(letter == '\0') return 0;
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -308,6 +456,216 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
 }
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+
+/**
+ * Find the glyph index of a font in the slots, or build it on the first call.
+ * Must be called between `glyph_index_read_begin()` and `glyph_index_read_end()`, the index can be
+ * used until the latter. An index is only published once it's complete and isn't changed afterwards.
+ * @param fdsc  descriptor of the font
+ * @return      the index, or NULL if the font can't be indexed, all slots are used by other fonts or out of memory
+ */
+static const lv_font_fmt_txt_glyph_index_t * get_glyph_index(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t i = glyph_index_slot(fdsc);
+    uint32_t n;
+    for(n = 0; n < LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT; n++) {
+        const lv_font_fmt_txt_glyph_index_t * index = GLYPH_INDEX_LOAD(glyph_index_state.indexes[i]);
+        if(index == NULL) break;
+        if(index->dsc == fdsc) {
+            if(index->page_cnt == 0) return NULL;
+            return index;
+        }
+        i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+    }
+
+    /*All slots are used, keep searching the character maps of this font*/
+    if(n == LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT) return NULL;
+
+    /*Build outside the lock, draw units of other fonts shouldn't wait for it*/
+    lv_font_fmt_txt_glyph_index_t * new_index = build_glyph_index(fdsc);
+    if(new_index == NULL) return NULL;
+
+    lv_mutex_lock(&glyph_index_state.mutex);
+
+    const lv_font_fmt_txt_glyph_index_t * index = NULL;
+    i = glyph_index_slot(fdsc);
+    for(n = 0; n < LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT; n++) {
+        lv_font_fmt_txt_glyph_index_t * slot_index = glyph_index_state.indexes[i];
+        if(slot_index == NULL) {
+            GLYPH_INDEX_STORE(glyph_index_state.indexes[i], new_index);
+            index = new_index;
+            break;
+        }
+        /*Another thread was faster*/
+        if(slot_index->dsc == fdsc) {
+            index = slot_index;
+            break;
+        }
+        i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+    }
+
+    lv_mutex_unlock(&glyph_index_state.mutex);
+
+    if(index != new_index) lv_free(new_index);
+    if(index == NULL || index->page_cnt == 0) return NULL;
+
+    return index;
+}
+
+/**
+ * Create the codepoint to glyph ID table of a font.
+ * The table is filled with `search_glyph_dsc_id()` so it gives exactly the same results.
+ * @param fdsc  descriptor of the font
+ * @return      the new index, allocated as a single block, or NULL if out of memory.
+ *              `page_cnt` is 0 if the glyph IDs don't fit into the table.
+ */
+static lv_font_fmt_txt_glyph_index_t * build_glyph_index(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    uint32_t page_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0) continue;
+        uint32_t last = cmap->range_start + cmap->range_length - 1;
+        page_cnt = LV_MAX(page_cnt, (last >> GLYPH_INDEX_PAGE_SHIFT) + 1);
+    }
+
+    /*Mark the pages with characters. Sparse maps can span many empty pages, so only their listed characters count*/
+    uint16_t * page_map = lv_malloc_zeroed(page_cnt * sizeof(uint16_t));
+    if(page_map == NULL) return NULL;
+
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0) continue;
+        if(cmap->unicode_list == NULL) {
+            uint32_t last = cmap->range_start + cmap->range_length - 1;
+            uint32_t page;
+            for(page = cmap->range_start >> GLYPH_INDEX_PAGE_SHIFT; page <= last >> GLYPH_INDEX_PAGE_SHIFT; page++) {
+                page_map[page] = 1;
+            }
+        }
+        else {
+            uint32_t k;
+            for(k = 0; k < cmap->list_length; k++) {
+                page_map[(cmap->range_start + cmap->unicode_list[k]) >> GLYPH_INDEX_PAGE_SHIFT] = 1;
+            }
+        }
+    }
+
+    uint32_t row_cnt = 0;
+    uint32_t page;
+    for(page = 0; page < page_cnt; page++) {
+        if(page_map[page]) page_map[page] = (uint16_t)++row_cnt;
+    }
+
+    size_t map_size = LV_ALIGN_UP(page_cnt * sizeof(uint16_t), sizeof(void *));
+    size_t ids_size = row_cnt * GLYPH_INDEX_PAGE_SIZE * sizeof(uint16_t);
+    lv_font_fmt_txt_glyph_index_t * index = lv_malloc(sizeof(lv_font_fmt_txt_glyph_index_t) + map_size + ids_size);
+    if(index == NULL) {
+        lv_free(page_map);
+        return NULL;
+    }
+
+    index->dsc = fdsc;
+    index->page_cnt = page_cnt;
+    index->page_map = (uint16_t *)(index + 1);
+    index->glyph_ids = (uint16_t *)((uint8_t *)index->page_map + map_size);
+    lv_memcpy(index->page_map, page_map, page_cnt * sizeof(uint16_t));
+    lv_free(page_map);
+
+    for(page = 0; page < page_cnt; page++) {
+        uint32_t row = index->page_map[page];
+        if(row == 0) continue;
+
+        uint16_t * ids = &index->glyph_ids[(row - 1) << GLYPH_INDEX_PAGE_SHIFT];
+        uint32_t c;
+        for(c = 0; c < GLYPH_INDEX_PAGE_SIZE; c++) {
+            uint32_t gid = search_glyph_dsc_id(fdsc, (page << GLYPH_INDEX_PAGE_SHIFT) + c);
+            if(gid > UINT16_MAX) {
+                LV_LOG_WARN("glyph IDs don't fit into the glyph index, searching the character maps");
+                index->page_cnt = 0;
+                return index;
+            }
+            ids[c] = (uint16_t)gid;
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Put an index into the first free slot of its probe sequence. There must be a free slot.
+ * @param index     the index to insert
+ */
+static void insert_glyph_index(lv_font_fmt_txt_glyph_index_t * index)
+{
+    uint32_t i = glyph_index_slot(index->dsc);
+    while(glyph_index_state.indexes[i]) i = (i + 1) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT;
+    GLYPH_INDEX_STORE(glyph_index_state.indexes[i], index);
+}
+
+/**
+ * Start a lookup in the glyph indexes, so that no index it finds is freed until `glyph_index_read_end()`.
+ * @return      the epoch the lookup is counted in
+ */
+static uint32_t glyph_index_read_begin(void)
+{
+#if GLYPH_INDEX_LOCK_FREE
+    while(1) {
+        uint32_t epoch = GLYPH_INDEX_LOAD_CNT(glyph_index_state.epoch) & 1;
+        GLYPH_INDEX_INC(glyph_index_state.readers[epoch]);
+        /*If the epoch has just changed count it in the new one, so that the previous one drains*/
+        if((GLYPH_INDEX_LOAD_CNT(glyph_index_state.epoch) & 1) == epoch) return epoch;
+        GLYPH_INDEX_DEC(glyph_index_state.readers[epoch]);
+    }
+#else
+    /*The mutex is recursive, so an index can still be built during the lookup*/
+    lv_mutex_lock(&glyph_index_state.mutex);
+    return 0;
+#endif
+}
+
+/**
+ * Finish a lookup started by `glyph_index_read_begin()`
+ * @param epoch the value returned by `glyph_index_read_begin()`
+ */
+static void glyph_index_read_end(uint32_t epoch)
+{
+#if GLYPH_INDEX_LOCK_FREE
+    GLYPH_INDEX_DEC(glyph_index_state.readers[epoch]);
+#else
+    LV_UNUSED(epoch);
+    lv_mutex_unlock(&glyph_index_state.mutex);
+#endif
+}
+
+/**
+ * Free the removed indexes no lookup can read anymore. The mutex must be locked.
+ */
+static void free_retired_glyph_indexes(void)
+{
+    lv_font_fmt_txt_glyph_index_t ** next = &glyph_index_state.retired;
+    while(*next) {
+        lv_font_fmt_txt_glyph_index_t * index = *next;
+        if(GLYPH_INDEX_LOAD_CNT(glyph_index_state.readers[index->retired_epoch]) == 0) {
+            *next = index->next_retired;
+            lv_free(index);
+        }
+        else {
+            next = &index->next_retired;
+        }
+    }
+}
+
+static uint32_t glyph_index_slot(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*Descriptors are at least 4 byte aligned and usually much further apart*/
+    return (uint32_t)(((lv_uintptr_t)fdsc >> 4) % LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT);
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_INDEX*/
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
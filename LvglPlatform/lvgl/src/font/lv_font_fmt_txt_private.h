@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 
 #include "lv_font_fmt_txt.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -41,10 +42,43 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+typedef struct _lv_font_fmt_txt_glyph_index_t lv_font_fmt_txt_glyph_index_t;
+
+typedef struct {
+    /** Open addressing table of the indexed fonts, a slot is chosen by the address of the font's descriptor*/
+    lv_font_fmt_txt_glyph_index_t * indexes[LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT];
+    lv_font_fmt_txt_glyph_index_t * retired;        /**< Removed indexes that lookups might still read*/
+    long readers[2];    /**< Lookups in progress in each epoch*/
+    long epoch;         /**< Incremented by each removal, lookups are counted in `readers[epoch & 1]`*/
+    lv_mutex_t mutex;   /**< Protects adding and removing indexes*/
+} lv_font_fmt_txt_glyph_index_state_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+/**
+ * Initialize the glyph indexes of fonts in the built-in format
+ */
+void lv_font_fmt_txt_glyph_index_init(void);
+
+/**
+ * Free the glyph indexes of all fonts
+ */
+void lv_font_fmt_txt_glyph_index_deinit(void);
+
+/**
+ * Free the glyph index of a font. Must be called before a font descriptor created at runtime is freed,
+ * else a later font allocated at the same address would find the stale index.
+ * If other threads are looking up glyphs, the memory is released by a later call or on deinit.
+ * @param dsc   descriptor of the font
+ */
+void lv_font_fmt_txt_glyph_index_remove(const lv_font_fmt_txt_dsc_t * dsc);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -200,6 +200,7 @@ void lv_freetype_font_delete(lv_font_t * font)
     }
 
     lv_freetype_drop_face_id(dsc->context, dsc->face_id);
+    lv_font_glyph_cache_drop_all();
 
     /* invalidate magic number */
     lv_memzero(dsc, sizeof(lv_freetype_font_dsc_t));
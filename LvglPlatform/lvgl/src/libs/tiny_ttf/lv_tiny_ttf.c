@@ -146,6 +146,7 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
     }
 
     lv_tiny_ttf_cache_create(dsc);
+    lv_font_glyph_cache_drop_all();
 }
 
 void lv_tiny_ttf_destroy(lv_font_t * font)
@@ -165,6 +166,8 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
         font->dsc = NULL;
     }
 
+    lv_font_glyph_cache_drop_all();
+
     lv_free(font);
 }
 
@@ -28,6 +28,7 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 #define LV_NEMA_HAL_CUSTOM          0
@@ -366,6 +367,16 @@
     #endif
 #endif
 
+/** The number of finished draw tasks kept for reuse, so that drawing doesn't allocate them every frame.
+ *  Each one has room for its draw descriptor too. Set it to 0 to always free them. */
+#ifndef LV_DRAW_TASK_POOL_CNT
+    #ifdef CONFIG_LV_DRAW_TASK_POOL_CNT
+        #define LV_DRAW_TASK_POOL_CNT CONFIG_LV_DRAW_TASK_POOL_CNT
+    #else
+        #define LV_DRAW_TASK_POOL_CNT    256
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -520,6 +531,17 @@
         #endif
     #endif
 
+    /** Split large fills, images and layers into horizontal bands of this many rows,
+     *  so idle rendering threads can help drawing them. 0: don't split.
+     *  Used only if `LV_DRAW_SW_DRAW_UNIT_CNT > 1`. */
+    #ifndef LV_DRAW_SW_BAND_HEIGHT
+        #ifdef CONFIG_LV_DRAW_SW_BAND_HEIGHT
+            #define LV_DRAW_SW_BAND_HEIGHT CONFIG_LV_DRAW_SW_BAND_HEIGHT
+        #else
+            #define LV_DRAW_SW_BAND_HEIGHT      0
+        #endif
+    #endif
+
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -554,20 +576,22 @@
     #endif
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /** Allow buffering some shadow calculation.
-         *  LV_DRAW_SW_SHADOW_CACHE_SIZE is the maximum shadow size to buffer, where shadow size is
-         *  `shadow_width + radius`.  Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost. */
-        #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
-            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
-                #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
+        /** Size of the shadow cache in bytes. It keeps the blurred corners of box shadows, so shadows with
+         *  the same radius and width are not blurred again in every frame.
+         *  A shadow needs `2 * (shadow_width + radius)^2` bytes. Shadows larger than a quarter of the cache are not stored.
+         *  - 0: disables caching */
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE
+                #define LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE
             #else
-                #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+                #define LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE 0
             #endif
         #endif
 
         /** Set number of maximally-cached circle data.
          *  The circumference of 1/4 circle are saved for anti-aliasing.
-         *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
+         *  `radius * 6` bytes are used per circle. The circles are kept between frames, and the cache
+         *  is cleared after a frame that used more radii. The drawing threads find the circles without locking.
          *  - 0: disables caching */
         #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
             #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
@@ -605,6 +629,18 @@
         #endif
     #endif
 
+    /** Size of the gradient cache in bytes. It keeps the colors of horizontal and vertical gradients
+     *  and the color maps of complex gradients, so they are not calculated again in every frame.
+     *  A gradient needs `4 * length` bytes. Gradients larger than a quarter of the cache are not stored.
+     *  - 0: disables caching */
+    #ifndef LV_DRAW_SW_GRAD_CACHE_DEF_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_GRAD_CACHE_DEF_SIZE
+            #define LV_DRAW_SW_GRAD_CACHE_DEF_SIZE CONFIG_LV_DRAW_SW_GRAD_CACHE_DEF_SIZE
+        #else
+            #define LV_DRAW_SW_GRAD_CACHE_DEF_SIZE 0
+        #endif
+    #endif
+
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -1272,6 +1308,31 @@
     #endif
 #endif
 
+/** Default number of glyph descriptor cache entries. An entry stores the metrics of a letter and its kerning
+ *  with the next letter, as returned by `lv_font_get_glyph_dsc()`. Measuring, wrapping and drawing a text
+ *  look up the same letter pairs again, so with the cache these are resolved only once.
+ *  Worth it for fonts with a slow lookup, like TinyTTF, FreeType and image fonts.
+ *  Fonts in the built-in format find a glyph faster than the cache and don't use it.
+ *  If 0, the cache is disabled. */
+#ifndef LV_FONT_GLYPH_CACHE_DEF_CNT
+    #ifdef CONFIG_LV_FONT_GLYPH_CACHE_DEF_CNT
+        #define LV_FONT_GLYPH_CACHE_DEF_CNT CONFIG_LV_FONT_GLYPH_CACHE_DEF_CNT
+    #else
+        #define LV_FONT_GLYPH_CACHE_DEF_CNT 0
+    #endif
+#endif
+
+/** Default size of the glyph atlas in bytes. The atlas keeps the unpacked A8 bitmaps of the glyphs of
+ *  built-in format fonts, so letters drawn again skip expanding 1..4 bpp pixels and decompressing.
+ *  A 14 px glyph needs about 150 bytes. If 0, the atlas is disabled. */
+#ifndef LV_FONT_GLYPH_ATLAS_DEF_SIZE
+    #ifdef CONFIG_LV_FONT_GLYPH_ATLAS_DEF_SIZE
+        #define LV_FONT_GLYPH_ATLAS_DEF_SIZE CONFIG_LV_FONT_GLYPH_ATLAS_DEF_SIZE
+    #else
+        #define LV_FONT_GLYPH_ATLAS_DEF_SIZE 0
+    #endif
+#endif
+
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -1305,6 +1366,16 @@
     #endif
 #endif
 
+/** Add 2 x 16-bit variables to each `lv_obj_t` to cache if it covers its inner area.
+ *  It makes finding the top object of the redrawn areas cheaper. */
+#ifndef LV_OBJ_COVER_CACHE
+    #ifdef CONFIG_LV_OBJ_COVER_CACHE
+        #define LV_OBJ_COVER_CACHE CONFIG_LV_OBJ_COVER_CACHE
+    #else
+        #define LV_OBJ_COVER_CACHE      0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1833,6 +1904,28 @@
     #endif
 #endif
 
+/** Build a codepoint to glyph ID table for each font in the built-in format on its first use.
+ *  Finding a glyph then takes a table lookup instead of a search through the font's character maps.
+ *  Costs 2 bytes per 256 codepoints up to the font's last character,
+ *  plus 512 bytes for each block of 256 codepoints that contains characters. */
+#ifndef LV_FONT_FMT_TXT_GLYPH_INDEX
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_INDEX
+        #define LV_FONT_FMT_TXT_GLYPH_INDEX CONFIG_LV_FONT_FMT_TXT_GLYPH_INDEX
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_INDEX 0
+    #endif
+#endif
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    /** Maximum number of fonts with a glyph index. Further fonts search their character maps. */
+    #ifndef LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT
+        #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT
+            #define LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT CONFIG_LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT
+        #else
+            #define LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT 16
+        #endif
+    #endif
+#endif
+
 /** Enables/disables support for compressed fonts. */
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -2232,6 +2325,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1    /**< Store some extra info in labels to speed up drawing of very long text */
         #endif
     #endif
+    #ifndef LV_LABEL_LINE_CACHE
+        #ifdef CONFIG_LV_LABEL_LINE_CACHE
+            #define LV_LABEL_LINE_CACHE CONFIG_LV_LABEL_LINE_CACHE
+        #else
+            #define LV_LABEL_LINE_CACHE 0       /**< Store the line breaks and line widths of labels to draw them without measuring the text again */
+        #endif
+    #endif
     #ifndef LV_LABEL_WAIT_CHAR_COUNT
         #ifdef CONFIG_LV_LABEL_WAIT_CHAR_COUNT
             #define LV_LABEL_WAIT_CHAR_COUNT CONFIG_LV_LABEL_WAIT_CHAR_COUNT
@@ -4374,6 +4474,10 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #endif
 #endif
 
+#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
+    #warning "LV_DRAW_SW_SHADOW_CACHE_SIZE was replaced by LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE which is the size of the cache in bytes. Please update lv_conf.h or run menuconfig again."
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
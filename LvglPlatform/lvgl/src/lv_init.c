@@ -34,6 +34,8 @@
 #include "draw/lv_draw.h"
 #include "misc/lv_async.h"
 #include "misc/lv_fs_private.h"
+#include "misc/cache/lv_font_glyph_cache.h"
+#include "misc/cache/lv_font_glyph_atlas.h"
 #include "widgets/span/lv_span.h"
 #include "themes/simple/lv_theme_simple.h"
 #include "misc/lv_fs.h"
@@ -141,11 +143,6 @@ static inline void lv_global_init(lv_global_t * global)
     void LV_LOG_PRINT_CB(lv_log_level_t, const char * txt);
     global->custom_log_print_cb = LV_LOG_PRINT_CB;
 #endif
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void lv_cleanup_devices(lv_global_t * global)
@@ -195,6 +192,10 @@ void lv_init(void)
     lv_span_stack_init();
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    lv_font_fmt_txt_glyph_index_init();
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
     lv_profiler_builtin_config_t profiler_config;
     lv_profiler_builtin_config_init(&profiler_config);
@@ -278,6 +279,8 @@ void lv_init(void)
 #endif
 
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
+    lv_font_glyph_cache_init(LV_FONT_GLYPH_CACHE_DEF_CNT);
+    lv_font_glyph_atlas_init(LV_FONT_GLYPH_ATLAS_DEF_SIZE);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
 #if LV_USE_DRAW_VG_LITE
@@ -424,6 +427,10 @@ void lv_deinit(void)
     lv_span_stack_deinit();
 #endif
 
+#if LV_FONT_FMT_TXT_GLYPH_INDEX
+    lv_font_fmt_txt_glyph_index_deinit();
+#endif
+
 #if LV_USE_FREETYPE
     lv_freetype_uninit();
 #endif
@@ -441,6 +448,8 @@ void lv_deinit(void)
 #endif
 
     lv_image_decoder_deinit();
+    lv_font_glyph_cache_deinit();
+    lv_font_glyph_atlas_deinit();
 
     lv_refr_deinit();
 
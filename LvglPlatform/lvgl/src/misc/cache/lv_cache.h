@@ -20,6 +20,7 @@ extern "C" {
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
+#include "lv_font_glyph_cache.h"
 
 /*********************
  *      DEFINES
@@ -0,0 +1,238 @@
+/**
+* @file lv_font_glyph_atlas.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_assert.h"
+#include "../../core/lv_global.h"
+#include "../../font/lv_font.h"
+#include "../../font/lv_font_fmt_txt.h"
+#include "../../draw/lv_draw_buf.h"
+
+#include "lv_font_glyph_atlas.h"
+#include "lv_cache.h"
+#include "lv_cache_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_NAME  "FONT_GLYPH_ATLAS"
+
+#define font_glyph_atlas_p (LV_GLOBAL_DEFAULT()->font_glyph_atlas)
+#define font_glyph_atlas_hit_cnt (LV_GLOBAL_DEFAULT()->font_glyph_atlas_hit_cnt)
+#define font_glyph_atlas_miss_cnt (LV_GLOBAL_DEFAULT()->font_glyph_atlas_miss_cnt)
+#define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+
+    /*Key*/
+    const lv_font_t * font;
+    uint32_t gid;
+
+    /*Data*/
+    lv_draw_buf_t * draw_buf;
+} font_glyph_atlas_data_t;
+
+typedef struct {
+    lv_font_glyph_dsc_t * g_dsc;
+    bool created;
+} font_glyph_atlas_create_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool needs_unpacking(const lv_font_glyph_dsc_t * g_dsc);
+static bool font_glyph_atlas_create_cb(font_glyph_atlas_data_t * node, font_glyph_atlas_create_ctx_t * ctx);
+static void font_glyph_atlas_free_cb(font_glyph_atlas_data_t * node, void * user_data);
+static lv_cache_compare_res_t font_glyph_atlas_compare_cb(const font_glyph_atlas_data_t * lhs,
+                                                          const font_glyph_atlas_data_t * rhs);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_font_glyph_atlas_init(uint32_t size)
+{
+    if(font_glyph_atlas_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    font_glyph_atlas_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(font_glyph_atlas_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) font_glyph_atlas_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) font_glyph_atlas_create_cb,
+        .free_cb = (lv_cache_free_cb_t) font_glyph_atlas_free_cb
+    });
+
+    if(font_glyph_atlas_p == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_cache_set_name(font_glyph_atlas_p, CACHE_NAME);
+    return LV_RESULT_OK;
+}
+
+void lv_font_glyph_atlas_deinit(void)
+{
+    if(font_glyph_atlas_p == NULL) return;
+
+    lv_cache_destroy(font_glyph_atlas_p, NULL);
+    font_glyph_atlas_p = NULL;
+}
+
+void lv_font_glyph_atlas_resize(uint32_t size, bool evict_now)
+{
+    lv_cache_set_max_size(font_glyph_atlas_p, size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(font_glyph_atlas_p, size, NULL);
+    }
+}
+
+void lv_font_glyph_atlas_drop_all(void)
+{
+    if(font_glyph_atlas_p == NULL) return;
+
+    lv_cache_drop_all(font_glyph_atlas_p, NULL);
+}
+
+bool lv_font_glyph_atlas_is_enabled(void)
+{
+    return font_glyph_atlas_p != NULL && lv_cache_is_enabled(font_glyph_atlas_p);
+}
+
+const lv_draw_buf_t * lv_font_glyph_atlas_get(lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_ASSERT_NULL(g_dsc);
+
+    if(!needs_unpacking(g_dsc)) return NULL;
+
+    font_glyph_atlas_data_t search_key;
+    search_key.font = g_dsc->resolved_font;
+    search_key.gid = g_dsc->gid.index;
+    search_key.slot.size = lv_draw_buf_width_to_stride_ex(font_draw_buf_handlers, g_dsc->box_w, LV_COLOR_FORMAT_A8) *
+                           g_dsc->box_h;
+    search_key.draw_buf = NULL;
+
+    /*Glyphs are unpacked by several draw units, count under the cache's lock*/
+    lv_mutex_lock(&font_glyph_atlas_p->lock);
+    font_glyph_atlas_create_ctx_t ctx = {g_dsc, false};
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(font_glyph_atlas_p, &search_key, &ctx);
+    if(entry != NULL) {
+        if(ctx.created) font_glyph_atlas_miss_cnt++;
+        else font_glyph_atlas_hit_cnt++;
+    }
+    lv_mutex_unlock(&font_glyph_atlas_p->lock);
+    if(entry == NULL) return NULL;
+
+    g_dsc->entry = entry;
+    font_glyph_atlas_data_t * cached_data = lv_cache_entry_get_data(entry);
+    return cached_data->draw_buf;
+}
+
+void lv_font_glyph_atlas_release(lv_font_glyph_dsc_t * g_dsc)
+{
+    LV_ASSERT_NULL(g_dsc);
+    if(g_dsc->entry == NULL) return;
+
+    lv_cache_release(font_glyph_atlas_p, g_dsc->entry, NULL);
+    g_dsc->entry = NULL;
+}
+
+uint32_t lv_font_glyph_atlas_get_hit_cnt(void)
+{
+    return font_glyph_atlas_hit_cnt;
+}
+
+uint32_t lv_font_glyph_atlas_get_miss_cnt(void)
+{
+    return font_glyph_atlas_miss_cnt;
+}
+
+uint32_t lv_font_glyph_atlas_get_size(void)
+{
+    if(font_glyph_atlas_p == NULL) return 0;
+
+    return (uint32_t)lv_cache_get_size(font_glyph_atlas_p, NULL);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * 8 bpp plain bitmaps are only copied, faster than finding them in the atlas
+ */
+static bool needs_unpacking(const lv_font_glyph_dsc_t * g_dsc)
+{
+    if(g_dsc->req_raw_bitmap || g_dsc->gid.index == 0) return false;
+    if(g_dsc->box_w == 0 || g_dsc->box_h == 0) return false;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)g_dsc->resolved_font->dsc;
+    if(fdsc->bpp != 8) return true;
+
+    return fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN && fdsc->bitmap_format != LV_FONT_FMT_PLAIN_ALIGNED;
+}
+
+static bool font_glyph_atlas_create_cb(font_glyph_atlas_data_t * node, font_glyph_atlas_create_ctx_t * ctx)
+{
+    lv_font_glyph_dsc_t * g_dsc = ctx->g_dsc;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create_ex(font_draw_buf_handlers, g_dsc->box_w, g_dsc->box_h,
+                                                     LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) {
+        LV_LOG_WARN("could not allocate the bitmap of glyph %" LV_PRIu32, node->gid);
+        return false;
+    }
+
+    if(lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf) == NULL) {
+        lv_draw_buf_destroy(draw_buf);
+        return false;
+    }
+
+    node->draw_buf = draw_buf;
+    ctx->created = true;
+    return true;
+}
+
+static void font_glyph_atlas_free_cb(font_glyph_atlas_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_draw_buf_destroy(node->draw_buf);
+}
+
+static lv_cache_compare_res_t font_glyph_atlas_compare_cb(const font_glyph_atlas_data_t * lhs,
+                                                          const font_glyph_atlas_data_t * rhs)
+{
+    if(lhs->gid != rhs->gid) {
+        return lhs->gid > rhs->gid ? 1 : -1;
+    }
+
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+* @file lv_font_glyph_atlas.h
+*
+ */
+
+#ifndef LV_FONT_GLYPH_ATLAS_H
+#define LV_FONT_GLYPH_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../lv_types.h"
+#include "../../font/lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph atlas.
+ * It keeps the A8 bitmaps of the glyphs of built-in format fonts (`lv_font_fmt_txt_dsc_t`),
+ * so drawing the same letter again doesn't unpack or decompress its bitmap.
+ * @param size      initial size of the atlas in bytes.
+ * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_font_glyph_atlas_init(uint32_t size);
+
+/**
+ * Deinitialize the glyph atlas and free the bitmaps.
+ */
+void lv_font_glyph_atlas_deinit(void);
+
+/**
+ * Resize the glyph atlas.
+ * If set to 0, the atlas is disabled.
+ * @param size      new max size of the atlas in bytes.
+ * @param evict_now true: evict the bitmaps should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_font_glyph_atlas_resize(uint32_t size, bool evict_now);
+
+/**
+ * Drop the bitmaps of all fonts. Needs to be called when a font is deleted.
+ */
+void lv_font_glyph_atlas_drop_all(void);
+
+/**
+ * Return true if the glyph atlas is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_font_glyph_atlas_is_enabled(void);
+
+/**
+ * Get the A8 bitmap of a glyph from the atlas, or unpack it into the atlas if it's not there yet.
+ * Only glyphs which need unpacking are stored: 1, 2, 3 and 4 bpp or compressed bitmaps.
+ * @param g_dsc     the glyph descriptor of a built-in format font.
+ *                  Its `entry` is set to keep the bitmap until `lv_font_glyph_atlas_release()`.
+ * @return          pointer to the draw buffer of the bitmap or NULL if the glyph isn't stored in the atlas
+ */
+const lv_draw_buf_t * lv_font_glyph_atlas_get(lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Release a bitmap returned by `lv_font_glyph_atlas_get()`.
+ * @param g_dsc     the glyph descriptor passed to `lv_font_glyph_atlas_get()`
+ */
+void lv_font_glyph_atlas_release(lv_font_glyph_dsc_t * g_dsc);
+
+/**
+ * Get the number of bitmaps found in the glyph atlas since `lv_init()`.
+ * @return the number of atlas hits
+ */
+uint32_t lv_font_glyph_atlas_get_hit_cnt(void);
+
+/**
+ * Get the number of bitmaps unpacked into the glyph atlas since `lv_init()`.
+ * @return the number of atlas misses
+ */
+uint32_t lv_font_glyph_atlas_get_miss_cnt(void);
+
+/**
+ * Get the number of bytes used by the bitmaps in the glyph atlas.
+ * @return the used size in bytes
+ */
+uint32_t lv_font_glyph_atlas_get_size(void);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_ATLAS_H*/
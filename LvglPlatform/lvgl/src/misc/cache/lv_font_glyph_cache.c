@@ -0,0 +1,204 @@
+/**
+* @file lv_font_glyph_cache.c
+*
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_assert.h"
+#include "../../core/lv_global.h"
+#include "../../font/lv_font.h"
+
+#include "lv_font_glyph_cache.h"
+#include "lv_cache.h"
+#include "lv_cache_private.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CACHE_NAME  "FONT_GLYPH"
+
+#define font_glyph_cache_p (LV_GLOBAL_DEFAULT()->font_glyph_cache)
+#define font_glyph_cache_hit_cnt (LV_GLOBAL_DEFAULT()->font_glyph_cache_hit_cnt)
+#define font_glyph_cache_miss_cnt (LV_GLOBAL_DEFAULT()->font_glyph_cache_miss_cnt)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    /*Key*/
+    const lv_font_t * font;
+    const lv_font_t * fallback;
+    uint32_t letter;
+    uint32_t letter_next;
+
+    /*Data*/
+    lv_font_glyph_dsc_t dsc;
+    bool found;
+} font_glyph_cache_data_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static lv_cache_compare_res_t font_glyph_cache_compare_cb(const font_glyph_cache_data_t * lhs,
+                                                          const font_glyph_cache_data_t * rhs);
+static void font_glyph_cache_free_cb(font_glyph_cache_data_t * entry, void * user_data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_font_glyph_cache_init(uint32_t count)
+{
+    if(font_glyph_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    font_glyph_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
+    sizeof(font_glyph_cache_data_t), count, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) font_glyph_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) font_glyph_cache_free_cb
+    });
+
+    if(font_glyph_cache_p == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_cache_set_name(font_glyph_cache_p, CACHE_NAME);
+    return LV_RESULT_OK;
+}
+
+void lv_font_glyph_cache_deinit(void)
+{
+    if(font_glyph_cache_p == NULL) return;
+
+    lv_cache_destroy(font_glyph_cache_p, NULL);
+    font_glyph_cache_p = NULL;
+}
+
+void lv_font_glyph_cache_resize(uint32_t count, bool evict_now)
+{
+    lv_cache_set_max_size(font_glyph_cache_p, count, NULL);
+    if(evict_now) {
+        lv_cache_reserve(font_glyph_cache_p, count, NULL);
+    }
+}
+
+void lv_font_glyph_cache_drop_all(void)
+{
+    if(font_glyph_cache_p == NULL) return;
+
+    lv_cache_drop_all(font_glyph_cache_p, NULL);
+}
+
+bool lv_font_glyph_cache_is_enabled(void)
+{
+    return font_glyph_cache_p != NULL && lv_cache_is_enabled(font_glyph_cache_p);
+}
+
+bool lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter, uint32_t letter_next,
+                             lv_font_glyph_dsc_t * dsc_out, bool * found)
+{
+    font_glyph_cache_data_t search_key;
+    search_key.font = font;
+    search_key.fallback = font->fallback;
+    search_key.letter = letter;
+    search_key.letter_next = letter_next;
+
+    /*Glyphs are looked up by several draw units, count under the cache's lock*/
+    lv_mutex_lock(&font_glyph_cache_p->lock);
+    lv_cache_entry_t * entry = lv_cache_acquire(font_glyph_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        font_glyph_cache_miss_cnt++;
+        lv_mutex_unlock(&font_glyph_cache_p->lock);
+        return false;
+    }
+
+    const font_glyph_cache_data_t * cached_data = lv_cache_entry_get_data(entry);
+    *dsc_out = cached_data->dsc;
+    *found = cached_data->found;
+    lv_cache_release(font_glyph_cache_p, entry, NULL);
+
+    font_glyph_cache_hit_cnt++;
+    lv_mutex_unlock(&font_glyph_cache_p->lock);
+    return true;
+}
+
+void lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, uint32_t letter_next,
+                             const lv_font_glyph_dsc_t * dsc, bool found)
+{
+    font_glyph_cache_data_t data;
+    data.font = font;
+    data.fallback = font->fallback;
+    data.letter = letter;
+    data.letter_next = letter_next;
+    data.dsc = *dsc;
+    data.found = found;
+
+    lv_cache_entry_t * entry = lv_cache_add(font_glyph_cache_p, &data, NULL);
+    if(entry != NULL) {
+        lv_cache_release(font_glyph_cache_p, entry, NULL);
+    }
+}
+
+uint32_t lv_font_glyph_cache_get_hit_cnt(void)
+{
+    return font_glyph_cache_hit_cnt;
+}
+
+uint32_t lv_font_glyph_cache_get_miss_cnt(void)
+{
+    return font_glyph_cache_miss_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t font_glyph_cache_compare_cb(const font_glyph_cache_data_t * lhs,
+                                                          const font_glyph_cache_data_t * rhs)
+{
+    if(lhs->letter != rhs->letter) {
+        return lhs->letter > rhs->letter ? 1 : -1;
+    }
+
+    if(lhs->letter_next != rhs->letter_next) {
+        return lhs->letter_next > rhs->letter_next ? 1 : -1;
+    }
+
+    if(lhs->font != rhs->font) {
+        return lhs->font > rhs->font ? 1 : -1;
+    }
+
+    /*`fallback` is set directly, so a new one must not find the glyphs resolved with the old one*/
+    if(lhs->fallback != rhs->fallback) {
+        return lhs->fallback > rhs->fallback ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static void font_glyph_cache_free_cb(font_glyph_cache_data_t * entry, void * user_data)
+{
+    /*The descriptors don't own any data*/
+    LV_UNUSED(entry);
+    LV_UNUSED(user_data);
+}
@@ -0,0 +1,116 @@
+/**
+* @file lv_font_glyph_cache.h
+*
+ */
+
+#ifndef LV_FONT_GLYPH_CACHE_H
+#define LV_FONT_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../lv_types.h"
+#include "../../font/lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph descriptor cache.
+ * It stores the results of `lv_font_get_glyph_dsc()` for (font, fallback, letter, next letter) keys,
+ * so measuring and drawing a text resolve the metrics and kerning of a letter pair only once.
+ * `lv_font_set_kerning()` drops the whole cache. If the fallback of a fallback font is replaced,
+ * call `lv_font_glyph_cache_drop_all()`.
+ * @param count     initial size of the cache in count of glyph descriptors.
+ * @return LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_font_glyph_cache_init(uint32_t count);
+
+/**
+ * Deinitialize the glyph descriptor cache and free its entries.
+ */
+void lv_font_glyph_cache_deinit(void);
+
+/**
+ * Resize the glyph descriptor cache.
+ * If set to 0, the cache is disabled.
+ * @param count     new max count of cached glyph descriptors.
+ * @param evict_now true: evict the glyph descriptors should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_font_glyph_cache_resize(uint32_t count, bool evict_now);
+
+/**
+ * Drop the cached glyph descriptors of all fonts.
+ * Needs to be called when a font is deleted, or when the metrics or the fallback of a font are changed.
+ */
+void lv_font_glyph_cache_drop_all(void);
+
+/**
+ * Return true if the glyph descriptor cache is enabled.
+ * @return true: enabled, false: disabled.
+ */
+bool lv_font_glyph_cache_is_enabled(void);
+
+/**
+ * Look up a glyph descriptor in the cache.
+ * @param font          the font passed to `lv_font_get_glyph_dsc()`
+ * @param letter        a UNICODE character code
+ * @param letter_next   the next letter after `letter`, used for kerning
+ * @param dsc_out       store the cached descriptor here
+ * @param found         store the return value of `lv_font_get_glyph_dsc()` here
+ * @return              true: the descriptor was cached; false: it needs to be resolved and added
+ */
+bool lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter, uint32_t letter_next,
+                             lv_font_glyph_dsc_t * dsc_out, bool * found);
+
+/**
+ * Add a resolved glyph descriptor to the cache.
+ * @param font          the font passed to `lv_font_get_glyph_dsc()`
+ * @param letter        a UNICODE character code
+ * @param letter_next   the next letter after `letter`, used for kerning
+ * @param dsc           the descriptor returned by `lv_font_get_glyph_dsc()`
+ * @param found         the return value of `lv_font_get_glyph_dsc()`
+ */
+void lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, uint32_t letter_next,
+                             const lv_font_glyph_dsc_t * dsc, bool found);
+
+/**
+ * Get the number of lookups answered by the glyph descriptor cache since `lv_init()`.
+ * @return the number of cache hits
+ */
+uint32_t lv_font_glyph_cache_get_hit_cnt(void);
+
+/**
+ * Get the number of lookups the glyph descriptor cache couldn't answer since `lv_init()`.
+ * @return the number of cache misses
+ */
+uint32_t lv_font_glyph_cache_get_miss_cnt(void);
+
+/*************************
+ *    GLOBAL VARIABLES
+ *************************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_CACHE_H*/
@@ -155,6 +155,8 @@ typedef struct _lv_draw_mask_t lv_draw_mask_t;
 
 typedef struct _lv_draw_label_hint_t lv_draw_label_hint_t;
 
+typedef struct _lv_draw_label_lines_t lv_draw_label_lines_t;
+
 typedef struct _lv_draw_glyph_dsc_t lv_draw_glyph_dsc_t;
 
 typedef struct _lv_draw_image_sup_t lv_draw_image_sup_t;
@@ -73,6 +73,7 @@ void lv_imgfont_destroy(lv_font_t * font)
 
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_free(dsc);
+    lv_font_glyph_cache_drop_all();
 }
 
 /**********************
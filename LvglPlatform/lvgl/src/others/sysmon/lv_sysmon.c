@@ -15,8 +15,12 @@
 #include "../../core/lv_global.h"
 #include "../../misc/lv_async.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_sprintf.h"
 #include "../../widgets/label/lv_label.h"
 #include "../../display/lv_display_private.h"
+#include "../../misc/cache/lv_font_glyph_cache.h"
+#include "../../misc/cache/lv_font_glyph_atlas.h"
+#include "../../draw/sw/lv_draw_sw.h"
 
 /*********************
  *      DEFINES
@@ -267,6 +271,37 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.fps_avg_total = ((info->calculated.fps_avg_total * (info->calculated.run_cnt - 1)) +
                                       info->calculated.fps) / info->calculated.run_cnt;
 
+    uint32_t glyph_cache_hit_cnt = lv_font_glyph_cache_get_hit_cnt();
+    uint32_t glyph_cache_miss_cnt = lv_font_glyph_cache_get_miss_cnt();
+    uint32_t glyph_cache_hits = glyph_cache_hit_cnt - info->measured.font_glyph_cache_hit_cnt;
+    info->calculated.font_glyph_cache_lookup_cnt = glyph_cache_hits + glyph_cache_miss_cnt -
+                                                   info->measured.font_glyph_cache_miss_cnt;
+    info->calculated.font_glyph_cache_hit_pct = info->calculated.font_glyph_cache_lookup_cnt ?
+                                                (uint32_t)((uint64_t)glyph_cache_hits * 100 /
+                                                           info->calculated.font_glyph_cache_lookup_cnt) : 0;
+
+    uint32_t glyph_atlas_hit_cnt = lv_font_glyph_atlas_get_hit_cnt();
+    uint32_t glyph_atlas_miss_cnt = lv_font_glyph_atlas_get_miss_cnt();
+    uint32_t glyph_atlas_hits = glyph_atlas_hit_cnt - info->measured.font_glyph_atlas_hit_cnt;
+    info->calculated.font_glyph_atlas_lookup_cnt = glyph_atlas_hits + glyph_atlas_miss_cnt -
+                                                   info->measured.font_glyph_atlas_miss_cnt;
+    info->calculated.font_glyph_atlas_hit_pct = info->calculated.font_glyph_atlas_lookup_cnt ?
+                                                (uint32_t)((uint64_t)glyph_atlas_hits * 100 /
+                                                           info->calculated.font_glyph_atlas_lookup_cnt) : 0;
+    info->calculated.font_glyph_atlas_size = lv_font_glyph_atlas_get_size();
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    uint32_t shadow_cache_hit_cnt = lv_draw_sw_shadow_cache_get_hit_cnt();
+    uint32_t shadow_cache_miss_cnt = lv_draw_sw_shadow_cache_get_miss_cnt();
+    uint32_t shadow_cache_hits = shadow_cache_hit_cnt - info->measured.sw_shadow_cache_hit_cnt;
+    info->calculated.sw_shadow_cache_lookup_cnt = shadow_cache_hits + shadow_cache_miss_cnt -
+                                                  info->measured.sw_shadow_cache_miss_cnt;
+    info->calculated.sw_shadow_cache_hit_pct = info->calculated.sw_shadow_cache_lookup_cnt ?
+                                               (uint32_t)((uint64_t)shadow_cache_hits * 100 /
+                                                          info->calculated.sw_shadow_cache_lookup_cnt) : 0;
+    info->calculated.sw_shadow_cache_size = lv_draw_sw_shadow_cache_get_size();
+#endif
+
     lv_subject_set_pointer(&disp->perf_sysmon_backend.subject, info);
 
     lv_sysmon_perf_info_t prev_info = *info;
@@ -275,6 +310,14 @@ static void perf_update_timer_cb(lv_timer_t * t)
     info->calculated.cpu_avg_total = prev_info.calculated.cpu_avg_total;
     info->calculated.fps_avg_total = prev_info.calculated.fps_avg_total;
     info->calculated.run_cnt = prev_info.calculated.run_cnt;
+    info->measured.font_glyph_cache_hit_cnt = glyph_cache_hit_cnt;
+    info->measured.font_glyph_cache_miss_cnt = glyph_cache_miss_cnt;
+    info->measured.font_glyph_atlas_hit_cnt = glyph_atlas_hit_cnt;
+    info->measured.font_glyph_atlas_miss_cnt = glyph_atlas_miss_cnt;
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    info->measured.sw_shadow_cache_hit_cnt = shadow_cache_hit_cnt;
+    info->measured.sw_shadow_cache_miss_cnt = shadow_cache_miss_cnt;
+#endif
 
     info->measured.last_report_timestamp = lv_tick_get();
 }
@@ -288,20 +331,46 @@ static void perf_observer_cb(lv_observer_t * observer, lv_subject_t * subject)
     LV_LOG("sysmon: "
            "%" LV_PRIu32 " FPS (refr_cnt: %" LV_PRIu32 " | redraw_cnt: %" LV_PRIu32"), "
            "refr %" LV_PRIu32 "ms (render %" LV_PRIu32 "ms | flush %" LV_PRIu32 "ms), "
-           "CPU %" LV_PRIu32 "%%\n",
+           "CPU %" LV_PRIu32 "%%, "
+           "glyph cache %" LV_PRIu32 "%% of %" LV_PRIu32 " lookups, "
+           "glyph atlas %" LV_PRIu32 "%% of %" LV_PRIu32 " lookups (%" LV_PRIu32 " bytes), "
+           "shadow cache %" LV_PRIu32 "%% of %" LV_PRIu32 " shadows (%" LV_PRIu32 " bytes)\n",
            perf->calculated.fps, perf->measured.refr_cnt, perf->measured.render_cnt,
            perf->calculated.refr_avg_time, perf->calculated.render_avg_time, perf->calculated.flush_avg_time,
-           perf->calculated.cpu);
+           perf->calculated.cpu, perf->calculated.font_glyph_cache_hit_pct, perf->calculated.font_glyph_cache_lookup_cnt,
+           perf->calculated.font_glyph_atlas_hit_pct, perf->calculated.font_glyph_atlas_lookup_cnt,
+           perf->calculated.font_glyph_atlas_size,
+           perf->calculated.sw_shadow_cache_hit_pct, perf->calculated.sw_shadow_cache_lookup_cnt,
+           perf->calculated.sw_shadow_cache_size);
 #else
+    char buf[128];
+    uint32_t len = lv_snprintf(buf, sizeof(buf),
+                               "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
+                               "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
+                               perf->calculated.fps, perf->calculated.cpu,
+                               perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
+                               perf->calculated.render_avg_time, perf->calculated.flush_avg_time);
+
+    /*Show the caches only if they are used*/
+    if(lv_font_glyph_cache_is_enabled() && len < sizeof(buf)) {
+        len += lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32 "%% glyph cache hits",
+                           perf->calculated.font_glyph_cache_hit_pct);
+    }
+
+    if(lv_font_glyph_atlas_is_enabled() && len < sizeof(buf)) {
+        len += lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32 "%% atlas hits, %" LV_PRIu32 " kB",
+                           perf->calculated.font_glyph_atlas_hit_pct, (perf->calculated.font_glyph_atlas_size + 1023) / 1024);
+    }
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    if(lv_draw_sw_shadow_cache_is_enabled() && len < sizeof(buf)) {
+        lv_snprintf(buf + len, sizeof(buf) - len, "\n%" LV_PRIu32 "%% shadow hits, %" LV_PRIu32 " kB",
+                    perf->calculated.sw_shadow_cache_hit_pct, (perf->calculated.sw_shadow_cache_size + 1023) / 1024);
+    }
+#endif
+
     lv_obj_t * label = lv_observer_get_target(observer);
-    lv_label_set_text_fmt(
-        label,
-        "%" LV_PRIu32" FPS, %" LV_PRIu32 "%% CPU\n"
-        "%" LV_PRIu32" ms (%" LV_PRIu32" | %" LV_PRIu32")",
-        perf->calculated.fps, perf->calculated.cpu,
-        perf->calculated.render_avg_time + perf->calculated.flush_avg_time,
-        perf->calculated.render_avg_time, perf->calculated.flush_avg_time
-    );
+    lv_label_set_text(label, buf);
 #endif /*LV_USE_PERF_MONITOR_LOG_MODE*/
 }
 
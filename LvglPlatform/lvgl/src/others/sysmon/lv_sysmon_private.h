@@ -47,6 +47,12 @@ struct _lv_sysmon_perf_info_t {
         uint32_t flush_not_in_render_start;
         uint32_t flush_not_in_render_elaps_sum;
         uint32_t last_report_timestamp;
+        uint32_t font_glyph_cache_hit_cnt;  /*Total number of glyph cache hits at the last report*/
+        uint32_t font_glyph_cache_miss_cnt; /*Total number of glyph cache misses at the last report*/
+        uint32_t font_glyph_atlas_hit_cnt;  /*Total number of glyph atlas hits at the last report*/
+        uint32_t font_glyph_atlas_miss_cnt; /*Total number of glyph atlas misses at the last report*/
+        uint32_t sw_shadow_cache_hit_cnt;   /*Total number of shadow cache hits at the last report*/
+        uint32_t sw_shadow_cache_miss_cnt;  /*Total number of shadow cache misses at the last report*/
         uint32_t render_in_progress : 1;
     } measured;
 
@@ -59,6 +65,14 @@ struct _lv_sysmon_perf_info_t {
         uint32_t cpu_avg_total;
         uint32_t fps_avg_total;
         uint32_t run_cnt;
+        uint32_t font_glyph_cache_lookup_cnt;   /**< Glyph descriptor lookups since the last report*/
+        uint32_t font_glyph_cache_hit_pct;      /**< Percentage of these lookups served by the glyph cache*/
+        uint32_t font_glyph_atlas_lookup_cnt;   /**< Glyph bitmap lookups in the atlas since the last report*/
+        uint32_t font_glyph_atlas_hit_pct;      /**< Percentage of these lookups found already unpacked*/
+        uint32_t font_glyph_atlas_size;         /**< Bytes used by the bitmaps in the glyph atlas*/
+        uint32_t sw_shadow_cache_lookup_cnt;    /**< Box shadows drawn by the SW renderer since the last report*/
+        uint32_t sw_shadow_cache_hit_pct;       /**< Percentage of these shadows drawn with cached corners*/
+        uint32_t sw_shadow_cache_size;          /**< Bytes used by the corners in the shadow cache*/
     } calculated;
 
 };
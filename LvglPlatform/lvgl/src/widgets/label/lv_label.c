@@ -727,6 +727,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_memzero(&label->lines, sizeof(label->lines));
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -746,6 +750,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_deinit(&label->lines);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -871,6 +879,12 @@ static void draw_main(lv_event_t * e)
         return;
     }
 
+#if LV_LABEL_LINE_CACHE
+    /*Measured only if the text, the style or the width has changed*/
+    lv_draw_label_lines_update(&label->lines, &label_draw_dsc, lv_area_get_width(&txt_coords));
+    label_draw_dsc.lines = &label->lines;
+#endif
+
     if(label->long_mode == LV_LABEL_LONG_MODE_WRAP) {
         int32_t s = lv_obj_get_scroll_top(obj);
         lv_area_move(&txt_coords, 0, -s);
@@ -952,6 +966,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
+#endif
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_invalidate(&label->lines); /*The text might be changed in place*/
 #endif
     label->invalid_size_cache = true;
 
@@ -38,6 +38,10 @@ struct _lv_label_t {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_LABEL_LINE_CACHE
+    lv_draw_label_lines_t lines;        /**< Line breaks and widths of the text from the last drawing */
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
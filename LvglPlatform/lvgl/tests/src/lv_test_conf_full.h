@@ -2,7 +2,8 @@
 #define LV_TEST_CONF_FULL_H
 
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
-#define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE (16 * 1024)
+#define LV_DRAW_SW_GRAD_CACHE_DEF_SIZE (16 * 1024)
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -45,11 +46,14 @@
 #define LV_FONT_DEFAULT         &lv_font_montserrat_14
 #define LV_FONT_FMT_TXT_LARGE   1
 #define LV_USE_FONT_COMPRESSED  1
+#define LV_FONT_FMT_TXT_GLYPH_INDEX 1
 #define LV_USE_BIDI 1
 #define LV_USE_ARABIC_PERSIAN_CHARS 1
 #define LV_USE_PERF_MONITOR         1
 #define LV_USE_MEM_MONITOR          1
 #define LV_LABEL_TEXT_SELECTION     1
+#define LV_LABEL_LINE_CACHE         1
+#define LV_OBJ_COVER_CACHE          1
 
 #define LV_USE_CALENDAR_CHINESE 1
 #define LV_USE_LOTTIE 1
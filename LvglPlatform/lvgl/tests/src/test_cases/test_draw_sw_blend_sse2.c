@@ -0,0 +1,191 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+
+/*Not a multiple of the vector sizes to test the last pixels too*/
+#define BUF_W       37
+#define BUF_H       16
+#define STRIDE_PX   40
+#define BUF_SIZE    (STRIDE_PX * BUF_H * 4)
+
+static uint8_t src_buf[BUF_SIZE];
+static uint8_t mask_buf[STRIDE_PX * BUF_H];
+static uint8_t dest_ori[BUF_SIZE];
+static uint8_t dest_ref[BUF_SIZE];
+static uint8_t dest_buf[BUF_SIZE];
+
+static const lv_opa_t opa_list[] = {LV_OPA_COVER, LV_OPA_MAX, LV_OPA_MAX - 1, LV_OPA_50, LV_OPA_MIN + 1, LV_OPA_MIN};
+
+void setUp(void)
+{
+    lv_rand_set_seed(0x5EED);
+}
+
+void tearDown(void)
+{
+    lv_blend_sse2_init();
+}
+
+/*Random bytes, often the ones where the blending takes a special path*/
+static void randomize(uint8_t * buf, uint32_t size)
+{
+    static const uint8_t special[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(lv_rand(0, 1)) buf[i] = special[lv_rand(0, sizeof(special) - 1)];
+        else buf[i] = lv_rand(0, 255);
+    }
+}
+
+static void blend(lv_color_format_t dest_cf, lv_color_format_t src_cf, lv_color_t color, lv_opa_t opa, bool masked)
+{
+    if(src_cf == LV_COLOR_FORMAT_UNKNOWN) {
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = dest_buf;
+        dsc.dest_w = BUF_W;
+        dsc.dest_h = BUF_H;
+        dsc.dest_stride = STRIDE_PX * lv_color_format_get_size(dest_cf);
+        dsc.mask_buf = masked ? mask_buf : NULL;
+        dsc.mask_stride = STRIDE_PX;
+        dsc.color = color;
+        dsc.opa = opa;
+
+        if(dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_color_to_argb8888(&dsc);
+        else if(dest_cf == LV_COLOR_FORMAT_XRGB8888) lv_draw_sw_blend_color_to_rgb888(&dsc, 4);
+        else lv_draw_sw_blend_color_to_rgb565(&dsc);
+    }
+    else {
+        lv_draw_sw_blend_image_dsc_t dsc;
+        lv_memzero(&dsc, sizeof(dsc));
+        dsc.dest_buf = dest_buf;
+        dsc.dest_w = BUF_W;
+        dsc.dest_h = BUF_H;
+        dsc.dest_stride = STRIDE_PX * lv_color_format_get_size(dest_cf);
+        dsc.mask_buf = masked ? mask_buf : NULL;
+        dsc.mask_stride = STRIDE_PX;
+        dsc.src_buf = src_buf;
+        dsc.src_stride = STRIDE_PX * lv_color_format_get_size(src_cf);
+        dsc.src_color_format = src_cf;
+        dsc.opa = opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+        if(dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_image_to_argb8888(&dsc);
+        else if(dest_cf == LV_COLOR_FORMAT_XRGB8888) lv_draw_sw_blend_image_to_rgb888(&dsc, 4);
+        else lv_draw_sw_blend_image_to_rgb565(&dsc);
+    }
+}
+
+/*Compare the result of each instruction set with the C implementation*/
+static void check_blend(lv_color_format_t dest_cf, lv_color_format_t src_cf)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(opa_list) * 2; i++) {
+        lv_opa_t opa = opa_list[i / 2];
+        bool masked = i % 2;
+        lv_color_t color = lv_color_hex(lv_rand(0, 0xFFFFFF));
+        randomize(src_buf, sizeof(src_buf));
+        randomize(mask_buf, sizeof(mask_buf));
+        randomize(dest_ori, sizeof(dest_ori));
+
+        lv_blend_sse2_isa_t isa;
+        for(isa = LV_BLEND_SSE2_ISA_NONE; isa <= LV_BLEND_SSE2_ISA_AVX2; isa++) {
+            lv_blend_sse2_set_isa(isa);
+            if(lv_blend_sse2_get_isa() != isa) continue;  /*Not supported by the CPU*/
+
+            lv_memcpy(dest_buf, dest_ori, sizeof(dest_buf));
+            blend(dest_cf, src_cf, color, opa, masked);
+
+            if(isa == LV_BLEND_SSE2_ISA_NONE) lv_memcpy(dest_ref, dest_buf, sizeof(dest_buf));
+            else TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(dest_ref, dest_buf, sizeof(dest_buf), isa == LV_BLEND_SSE2_ISA_SSE2 ? "SSE2" : "AVX2");
+        }
+    }
+}
+
+void test_draw_sw_blend_sse2_fill(void)
+{
+    check_blend(LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN);
+    check_blend(LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_UNKNOWN);
+    check_blend(LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN);
+}
+
+void test_draw_sw_blend_sse2_argb8888_image(void)
+{
+    check_blend(LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888);
+    check_blend(LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888);
+    check_blend(LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_draw_sw_blend_sse2_xrgb8888_image(void)
+{
+    check_blend(LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_XRGB8888);
+    check_blend(LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_XRGB8888);
+}
+
+void test_draw_sw_blend_sse2_rgb888_image(void)
+{
+    check_blend(LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_RGB888);
+    check_blend(LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_RGB888);
+}
+
+void test_draw_sw_blend_sse2_rgb565_image(void)
+{
+    check_blend(LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565);
+}
+
+void test_draw_sw_blend_sse2_isa_is_limited_by_the_cpu(void)
+{
+    lv_blend_sse2_isa_t cpu_isa = lv_blend_sse2_get_isa();
+    TEST_ASSERT_NOT_EQUAL(LV_BLEND_SSE2_ISA_NONE, cpu_isa);
+
+    lv_blend_sse2_set_isa(LV_BLEND_SSE2_ISA_NONE);
+    TEST_ASSERT_EQUAL(LV_BLEND_SSE2_ISA_NONE, lv_blend_sse2_get_isa());
+
+    lv_blend_sse2_set_isa(LV_BLEND_SSE2_ISA_AVX2);
+    TEST_ASSERT_EQUAL(cpu_isa, lv_blend_sse2_get_isa());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_blend_sse2_fill(void)
+{
+}
+
+void test_draw_sw_blend_sse2_argb8888_image(void)
+{
+}
+
+void test_draw_sw_blend_sse2_xrgb8888_image(void)
+{
+}
+
+void test_draw_sw_blend_sse2_rgb888_image(void)
+{
+}
+
+void test_draw_sw_blend_sse2_rgb565_image(void)
+{
+}
+
+void test_draw_sw_blend_sse2_isa_is_limited_by_the_cpu(void)
+{
+}
+
+#endif
+
+#endif
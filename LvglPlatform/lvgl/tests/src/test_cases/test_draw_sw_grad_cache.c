@@ -0,0 +1,270 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW
+
+#define CANVAS_W    160
+#define CANVAS_H    120
+#define CACHE_SIZE  (64 * 1024)
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+static uint8_t ref_buf[CANVAS_W * CANVAS_H * 4];
+
+void setUp(void)
+{
+    lv_draw_sw_grad_cache_resize(CACHE_SIZE, true);
+    lv_draw_sw_grad_cache_drop_all();
+
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_rand_set_seed(0x6AD1);
+}
+
+void tearDown(void)
+{
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+    lv_draw_sw_grad_cache_resize(LV_DRAW_SW_GRAD_CACHE_DEF_SIZE, true);
+    lv_draw_sw_grad_cache_drop_all();
+}
+
+static void draw_grad(const lv_grad_dsc_t * grad, const lv_area_t * coords)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_TRANSP);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_grad = *grad;
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_rect(&layer, &dsc, coords);
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static void two_color_grad(lv_grad_dsc_t * grad, lv_grad_dir_t dir, uint32_t color)
+{
+    lv_color_t colors[2] = {lv_color_hex(color), lv_color_black()};
+    lv_memzero(grad, sizeof(*grad));
+    lv_grad_init_stops(grad, colors, NULL, NULL, 2);
+    grad->dir = dir;
+}
+
+static void random_grad(lv_grad_dsc_t * grad, lv_area_t * coords)
+{
+    lv_color_t colors[LV_GRADIENT_MAX_STOPS];
+    lv_opa_t opas[LV_GRADIENT_MAX_STOPS];
+    uint8_t fracs[LV_GRADIENT_MAX_STOPS];
+    int32_t stops_count = lv_rand(2, LV_GRADIENT_MAX_STOPS);
+    int32_t i;
+    for(i = 0; i < stops_count; i++) {
+        colors[i] = lv_color_hex(lv_rand(0, 0xFFFFFF));
+        opas[i] = lv_rand(0, 1) ? LV_OPA_COVER : lv_rand(0, 255);
+        fracs[i] = i * 255 / (stops_count - 1);
+    }
+
+    lv_memzero(grad, sizeof(*grad));
+    lv_grad_init_stops(grad, colors, opas, fracs, stops_count);
+
+    switch(lv_rand(0, 4)) {
+        case 0:
+            lv_grad_horizontal_init(grad);
+            break;
+#if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+        case 1:
+            lv_grad_linear_init(grad, LV_GRAD_LEFT, LV_GRAD_TOP, LV_GRAD_RIGHT, LV_GRAD_BOTTOM, LV_GRAD_EXTEND_PAD);
+            break;
+        case 2:
+            lv_grad_radial_init(grad, LV_GRAD_CENTER, LV_GRAD_CENTER, LV_GRAD_RIGHT, LV_GRAD_BOTTOM,
+                                LV_GRAD_EXTEND_REFLECT);
+            break;
+#endif
+        default:
+            lv_grad_vertical_init(grad);
+            break;
+    }
+
+    coords->x1 = lv_rand(0, 60);
+    coords->y1 = lv_rand(0, 40);
+    coords->x2 = coords->x1 + lv_rand(4, 100);
+    coords->y2 = coords->y1 + lv_rand(4, 80);
+}
+
+/*Draw the gradient without the cache for a reference, then check that the cached colors give the same pixels*/
+static void check_grad(const lv_grad_dsc_t * grad, const lv_area_t * coords)
+{
+    lv_draw_sw_grad_cache_resize(0, false);
+    draw_grad(grad, coords);
+    lv_memcpy(ref_buf, draw_buf->data, sizeof(ref_buf));
+
+    lv_draw_sw_grad_cache_resize(CACHE_SIZE, false);
+    draw_grad(grad, coords);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, draw_buf->data, sizeof(ref_buf));
+}
+
+void test_draw_sw_grad_cache_same_result_as_without_cache(void)
+{
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_grad_dsc_t grad;
+        lv_area_t coords;
+        random_grad(&grad, &coords);
+
+        /*Keep the previous gradients to find them by mistake if the key is wrong*/
+        check_grad(&grad, &coords);
+        draw_grad(&grad, &coords);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, draw_buf->data, sizeof(ref_buf));
+    }
+}
+
+void test_draw_sw_grad_cache_keeps_multiple_gradients(void)
+{
+    lv_grad_dsc_t grad1;
+    two_color_grad(&grad1, LV_GRAD_DIR_HOR, 0xFF0000);
+    lv_grad_dsc_t grad2;
+    two_color_grad(&grad2, LV_GRAD_DIR_VER, 0x00FF00);
+
+    lv_area_t coords = {40, 30, 119, 89};
+
+    uint32_t miss_cnt = lv_draw_sw_grad_cache_get_miss_cnt();
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        draw_grad(&grad1, &coords);
+        draw_grad(&grad2, &coords);
+    }
+
+    /*Both are calculated only once. The number of hits depends on how the draw units split the drawing.*/
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+    TEST_ASSERT_NOT_EQUAL_UINT32(0, lv_draw_sw_grad_cache_get_size());
+
+    /*An object at another position with the same width uses the same colors*/
+    lv_area_t coords2 = {0, 0, 79, 19};
+    draw_grad(&grad1, &coords2);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+
+    /*A vertical gradient as high as the horizontal one is wide has the same colors too*/
+    grad1.dir = LV_GRAD_DIR_VER;
+    lv_area_t coords3 = {0, 0, 19, 79};
+    draw_grad(&grad1, &coords3);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_grad_cache_ignores_the_unused_stops(void)
+{
+    lv_grad_dsc_t grad;
+    two_color_grad(&grad, LV_GRAD_DIR_HOR, 0xFF0000);
+    lv_area_t coords = {20, 10, 119, 109};
+
+    uint32_t miss_cnt = lv_draw_sw_grad_cache_get_miss_cnt();
+    check_grad(&grad, &coords);
+
+    /*Only the first `stops_count` stops are compared*/
+    uint32_t i;
+    for(i = grad.stops_count; i < LV_GRADIENT_MAX_STOPS; i++) {
+        grad.stops[i].color = lv_color_hex(0x123456 * (i + 1));
+        grad.stops[i].opa = LV_OPA_50;
+        grad.stops[i].frac = 100;
+    }
+    check_grad(&grad, &coords);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_grad_cache_stop_count_is_part_of_the_key(void)
+{
+    /*The same first two stops, then a third one*/
+    lv_color_t colors[3] = {lv_color_hex(0xFF0000), lv_color_hex(0x00FF00), lv_color_hex(0x0000FF)};
+    uint8_t fracs[3] = {0, 128, 255};
+    lv_area_t coords = {20, 10, 119, 109};
+
+    lv_grad_dsc_t grad2;
+    lv_memzero(&grad2, sizeof(grad2));
+    lv_grad_init_stops(&grad2, colors, NULL, fracs, 2);
+    lv_grad_horizontal_init(&grad2);
+
+    lv_grad_dsc_t grad3 = grad2;
+    lv_grad_init_stops(&grad3, colors, NULL, fracs, 3);
+
+    uint32_t miss_cnt = lv_draw_sw_grad_cache_get_miss_cnt();
+    check_grad(&grad3, &coords);
+    check_grad(&grad2, &coords);
+    check_grad(&grad3, &coords);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_grad_cache_every_field_of_a_stop_is_part_of_the_key(void)
+{
+    lv_grad_dsc_t grad;
+    two_color_grad(&grad, LV_GRAD_DIR_HOR, 0xFF0000);
+    lv_area_t coords = {20, 10, 119, 109};
+
+    uint32_t miss_cnt = lv_draw_sw_grad_cache_get_miss_cnt();
+    check_grad(&grad, &coords);
+
+    /*A change in the last byte of the last stop is found too*/
+    grad.stops[1].frac = 200;
+    check_grad(&grad, &coords);
+    grad.stops[1].opa = LV_OPA_70;
+    check_grad(&grad, &coords);
+    grad.stops[0].color.blue = 1;
+    check_grad(&grad, &coords);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_draw_sw_grad_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_grad_cache_skips_large_gradients(void)
+{
+    lv_draw_sw_grad_cache_resize(1024, true);
+
+    lv_grad_dsc_t grad;
+    two_color_grad(&grad, LV_GRAD_DIR_HOR, 0xFF0000);
+    lv_area_t coords = {0, 0, 149, 99};
+
+    uint32_t miss_cnt = lv_draw_sw_grad_cache_get_miss_cnt();
+    draw_grad(&grad, &coords);
+    draw_grad(&grad, &coords);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, lv_draw_sw_grad_cache_get_miss_cnt());
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_sw_grad_cache_get_size());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_grad_cache_same_result_as_without_cache(void)
+{
+}
+
+void test_draw_sw_grad_cache_keeps_multiple_gradients(void)
+{
+}
+
+void test_draw_sw_grad_cache_ignores_the_unused_stops(void)
+{
+}
+
+void test_draw_sw_grad_cache_stop_count_is_part_of_the_key(void)
+{
+}
+
+void test_draw_sw_grad_cache_every_field_of_a_stop_is_part_of_the_key(void)
+{
+}
+
+void test_draw_sw_grad_cache_skips_large_gradients(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_DRAW_SW_CIRCLE_CACHE_SIZE > 0
+
+#define RADIUS_MAX      40
+#define MASK_SIZE       (RADIUS_MAX * 2 + 1)
+#define THREAD_CNT      4
+
+static uint8_t ref_buf[RADIUS_MAX + 1][MASK_SIZE * MASK_SIZE];
+
+void setUp(void)
+{
+    /*Start from an empty cache*/
+    lv_draw_sw_mask_deinit();
+    lv_draw_sw_mask_init();
+}
+
+void tearDown(void)
+{
+}
+
+/*Use a circle with the given radius without rendering anything*/
+static void touch_circle(int32_t radius)
+{
+    lv_area_t rect = {0, 0, 999, 999};
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &rect, radius, false);
+    lv_draw_sw_mask_free_param(&param);
+}
+
+/*Render a circle with the given radius and return whether its data is in the cache*/
+static bool render_circle(int32_t radius, uint8_t * buf)
+{
+    lv_area_t rect = {0, 0, radius * 2, radius * 2};
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &rect, radius, false);
+    bool cached = param.circle->cached;
+
+    void * masks[2] = {&param, NULL};
+    lv_memzero(buf, MASK_SIZE * MASK_SIZE);
+    int32_t y;
+    for(y = 0; y <= radius * 2; y++) {
+        uint8_t * line = &buf[y * MASK_SIZE];
+        lv_memset(line, 0xff, radius * 2 + 1);
+        lv_draw_sw_mask_apply(masks, line, 0, y, radius * 2 + 1);
+    }
+
+    lv_draw_sw_mask_free_param(&param);
+    return cached;
+}
+
+void test_draw_sw_mask_circle_cache_keeps_circles_between_frames(void)
+{
+    lv_area_t rect = {0, 0, 99, 99};
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &rect, 10, false);
+    lv_draw_sw_mask_radius_circle_dsc_t * circle = param.circle;
+    TEST_ASSERT_TRUE(circle->cached);
+    lv_draw_sw_mask_free_param(&param);
+
+    /*End of a frame*/
+    lv_draw_sw_mask_cleanup();
+
+    lv_draw_sw_mask_radius_init(&param, &rect, 10, false);
+    TEST_ASSERT_EQUAL_PTR(circle, param.circle);
+    lv_draw_sw_mask_free_param(&param);
+}
+
+void test_draw_sw_mask_circle_cache_is_cleared_after_overflow(void)
+{
+    /*Large enough not to limit the radii*/
+    lv_area_t rect = {0, 0, LV_DRAW_SW_CIRCLE_CACHE_SIZE * 2 + 1, LV_DRAW_SW_CIRCLE_CACHE_SIZE * 2 + 1};
+    lv_draw_sw_mask_radius_param_t param[LV_DRAW_SW_CIRCLE_CACHE_SIZE + 1];
+
+    /*One more radius than what fits*/
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE + 1; i++) {
+        lv_draw_sw_mask_radius_init(&param[i], &rect, i + 1, false);
+        TEST_ASSERT_EQUAL(i < LV_DRAW_SW_CIRCLE_CACHE_SIZE, param[i].circle->cached);
+    }
+
+    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE + 1; i++) {
+        lv_draw_sw_mask_free_param(&param[i]);
+    }
+
+    /*The next frame can cache the last radius too*/
+    lv_draw_sw_mask_cleanup();
+    lv_draw_sw_mask_radius_init(&param[0], &rect, LV_DRAW_SW_CIRCLE_CACHE_SIZE + 1, false);
+    TEST_ASSERT_TRUE(param[0].circle->cached);
+    lv_draw_sw_mask_free_param(&param[0]);
+}
+
+void test_draw_sw_mask_circle_cache_same_mask_as_without_cache(void)
+{
+    static uint8_t buf[MASK_SIZE * MASK_SIZE];
+    int32_t r;
+    for(r = 1; r <= RADIUS_MAX; r++) {
+        /*Fill the cache with other radii to calculate the circle only for this mask*/
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
+            touch_circle(RADIUS_MAX + 1 + i);
+        }
+
+        TEST_ASSERT_FALSE(render_circle(r, ref_buf[r]));
+
+        /*Once calculated into the cache and once from the cache*/
+        lv_draw_sw_mask_cleanup();
+        TEST_ASSERT_TRUE(render_circle(r, buf));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf[r], buf, sizeof(buf));
+        TEST_ASSERT_TRUE(render_circle(r, buf));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf[r], buf, sizeof(buf));
+    }
+}
+
+#if LV_USE_OS
+
+static uint32_t mismatch_cnt[THREAD_CNT];
+
+static void render_thread_cb(void * user_data)
+{
+    static uint8_t bufs[THREAD_CNT][MASK_SIZE * MASK_SIZE];
+    uint32_t id = (uint32_t)(lv_uintptr_t)user_data;
+
+    /*Each thread uses the radii in a different order*/
+    uint32_t i;
+    for(i = 0; i < RADIUS_MAX * 20; i++) {
+        int32_t r = (int32_t)((i * (id * 2 + 7)) % RADIUS_MAX) + 1;
+        render_circle(r, bufs[id]);
+        if(lv_memcmp(ref_buf[r], bufs[id], sizeof(bufs[id])) != 0) {
+            mismatch_cnt[id]++;
+        }
+    }
+}
+
+void test_draw_sw_mask_circle_cache_threads(void)
+{
+    static uint8_t buf[MASK_SIZE * MASK_SIZE];
+    int32_t r;
+    for(r = 1; r <= RADIUS_MAX; r++) {
+        render_circle(r, ref_buf[r]);
+    }
+
+    lv_draw_sw_mask_deinit();
+    lv_draw_sw_mask_init();
+
+    lv_thread_t threads[THREAD_CNT];
+    uint32_t i;
+    for(i = 0; i < THREAD_CNT; i++) {
+        lv_thread_init(&threads[i], "circle", LV_THREAD_PRIO_MID, render_thread_cb, 64 * 1024, (void *)(lv_uintptr_t)i);
+    }
+
+    for(i = 0; i < THREAD_CNT; i++) {
+        lv_thread_delete(&threads[i]);
+    }
+
+    for(i = 0; i < THREAD_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, mismatch_cnt[i]);
+    }
+
+    /*A frame has ended, the radii that fit are kept*/
+    lv_draw_sw_mask_cleanup();
+    uint32_t cached_cnt = 0;
+    for(r = 1; r <= RADIUS_MAX; r++) {
+        if(render_circle(r, buf)) cached_cnt++;
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf[r], buf, sizeof(buf));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(LV_MIN(LV_DRAW_SW_CIRCLE_CACHE_SIZE, RADIUS_MAX), cached_cnt);
+}
+
+#else
+
+void test_draw_sw_mask_circle_cache_threads(void)
+{
+}
+
+#endif
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_mask_circle_cache_keeps_circles_between_frames(void)
+{
+}
+
+void test_draw_sw_mask_circle_cache_is_cleared_after_overflow(void)
+{
+}
+
+void test_draw_sw_mask_circle_cache_same_mask_as_without_cache(void)
+{
+}
+
+void test_draw_sw_mask_circle_cache_threads(void)
+{
+}
+
+#endif
+
+#endif
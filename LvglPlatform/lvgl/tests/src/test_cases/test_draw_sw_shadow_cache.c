@@ -0,0 +1,217 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+
+#define CANVAS_W    160
+#define CANVAS_H    120
+#define CACHE_SIZE  (64 * 1024)
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+static uint8_t ref_buf[CANVAS_W * CANVAS_H * 4];
+
+void setUp(void)
+{
+    lv_draw_sw_shadow_cache_resize(CACHE_SIZE, true);
+    lv_draw_sw_shadow_cache_drop_all();
+
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_rand_set_seed(0x5AD0);
+}
+
+void tearDown(void)
+{
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+    lv_draw_sw_shadow_cache_resize(LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE, true);
+    lv_draw_sw_shadow_cache_drop_all();
+}
+
+static void draw_shadow(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_TRANSP);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_box_shadow(&layer, dsc, coords);
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static void random_shadow(lv_draw_box_shadow_dsc_t * dsc, lv_area_t * coords)
+{
+    lv_draw_box_shadow_dsc_init(dsc);
+    dsc->color = lv_color_hex(lv_rand(0, 0xFFFFFF));
+    dsc->width = lv_rand(1, 30);
+    dsc->spread = (int32_t)lv_rand(0, 12) - 4;
+    dsc->radius = lv_rand(0, 3) == 0 ? LV_RADIUS_CIRCLE : (int32_t)lv_rand(0, 30);
+    dsc->ofs_x = (int32_t)lv_rand(0, 10) - 5;
+    dsc->ofs_y = (int32_t)lv_rand(0, 10) - 5;
+    dsc->opa = lv_rand(0, 1) ? LV_OPA_COVER : LV_OPA_70;
+    dsc->bg_cover = lv_rand(0, 1);
+
+    /*Small objects too, where the far edges affect the corners*/
+    coords->x1 = lv_rand(20, 60);
+    coords->y1 = lv_rand(20, 40);
+    coords->x2 = coords->x1 + lv_rand(4, 70);
+    coords->y2 = coords->y1 + lv_rand(4, 50);
+}
+
+/*Draw the shadow without the cache for a reference, then check that the cached corners give the same pixels*/
+static void check_shadow(const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_sw_shadow_cache_resize(0, false);
+    draw_shadow(dsc, coords);
+    lv_memcpy(ref_buf, draw_buf->data, sizeof(ref_buf));
+
+    lv_draw_sw_shadow_cache_resize(CACHE_SIZE, false);
+    draw_shadow(dsc, coords);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, draw_buf->data, sizeof(ref_buf));
+}
+
+/*A shadow of 10 px width and 6 px radius has 16 px corners, so objects larger than 32 px can share them*/
+static void init_shadow(lv_draw_box_shadow_dsc_t * dsc)
+{
+    lv_draw_box_shadow_dsc_init(dsc);
+    dsc->width = 10;
+    dsc->radius = 6;
+}
+
+void test_draw_sw_shadow_cache_same_result_as_without_cache(void)
+{
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        lv_draw_box_shadow_dsc_t dsc;
+        lv_area_t coords;
+        random_shadow(&dsc, &coords);
+
+        /*Keep the previous corners to find them by mistake if the key is wrong*/
+        check_shadow(&dsc, &coords);
+        draw_shadow(&dsc, &coords);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, draw_buf->data, sizeof(ref_buf));
+    }
+}
+
+void test_draw_sw_shadow_cache_shares_corners_beyond_twice_the_corner_size(void)
+{
+    lv_draw_box_shadow_dsc_t dsc;
+    init_shadow(&dsc);
+
+    uint32_t miss_cnt = lv_draw_sw_shadow_cache_get_miss_cnt();
+
+    lv_area_t coords1 = {40, 30, 40 + 32 - 1, 30 + 32 - 1};
+    check_shadow(&dsc, &coords1);
+    lv_area_t coords2 = {40, 30, 40 + 33 - 1, 30 + 40 - 1};
+    check_shadow(&dsc, &coords2);
+    lv_area_t coords3 = {20, 10, 139, 109};
+    check_shadow(&dsc, &coords3);
+
+    /*The spread grows the blurred rectangle only*/
+    dsc.spread = 5;
+    check_shadow(&dsc, &coords3);
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * 16 * 16, lv_draw_sw_shadow_cache_get_size());
+}
+
+void test_draw_sw_shadow_cache_clamps_each_side_separately(void)
+{
+    lv_draw_box_shadow_dsc_t dsc;
+    init_shadow(&dsc);
+
+    uint32_t miss_cnt = lv_draw_sw_shadow_cache_get_miss_cnt();
+
+    /*Only the width is clamped, so a longer object can use the corners but a higher one can't*/
+    lv_area_t coords1 = {20, 40, 20 + 100 - 1, 40 + 20 - 1};
+    check_shadow(&dsc, &coords1);
+    lv_area_t coords2 = {20, 40, 20 + 120 - 1, 40 + 20 - 1};
+    check_shadow(&dsc, &coords2);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+
+    lv_area_t coords3 = {20, 40, 20 + 100 - 1, 40 + 24 - 1};
+    check_shadow(&dsc, &coords3);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+
+    /*The same for the height*/
+    lv_area_t coords4 = {60, 5, 60 + 20 - 1, 5 + 100 - 1};
+    check_shadow(&dsc, &coords4);
+    lv_area_t coords5 = {60, 5, 60 + 20 - 1, 5 + 110 - 1};
+    check_shadow(&dsc, &coords5);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_shadow_cache_small_objects_have_their_own_corners(void)
+{
+    lv_draw_box_shadow_dsc_t dsc;
+    init_shadow(&dsc);
+
+    uint32_t miss_cnt = lv_draw_sw_shadow_cache_get_miss_cnt();
+
+    /*The far edge of a 31 px wide object reaches into the corner*/
+    lv_area_t coords1 = {40, 30, 40 + 32 - 1, 30 + 40 - 1};
+    check_shadow(&dsc, &coords1);
+    lv_area_t coords2 = {40, 30, 40 + 31 - 1, 30 + 40 - 1};
+    check_shadow(&dsc, &coords2);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+
+    /*The radius is clamped to the half of the shorter side, 4 px here, so the corners are smaller*/
+    lv_area_t coords3 = {40, 30, 40 + 8 - 1, 30 + 40 - 1};
+    check_shadow(&dsc, &coords3);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_draw_sw_shadow_cache_get_miss_cnt() - miss_cnt);
+}
+
+void test_draw_sw_shadow_cache_skips_large_shadows(void)
+{
+    lv_draw_sw_shadow_cache_resize(4 * 1024, true);
+
+    lv_draw_box_shadow_dsc_t dsc;
+    lv_draw_box_shadow_dsc_init(&dsc);
+    dsc.width = 30;
+    dsc.radius = 20;
+    lv_area_t coords = {20, 10, 139, 109};
+
+    uint32_t miss_cnt = lv_draw_sw_shadow_cache_get_miss_cnt();
+    draw_shadow(&dsc, &coords);
+    draw_shadow(&dsc, &coords);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, lv_draw_sw_shadow_cache_get_miss_cnt());
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_sw_shadow_cache_get_size());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_shadow_cache_same_result_as_without_cache(void)
+{
+}
+
+void test_draw_sw_shadow_cache_shares_corners_beyond_twice_the_corner_size(void)
+{
+}
+
+void test_draw_sw_shadow_cache_clamps_each_side_separately(void)
+{
+}
+
+void test_draw_sw_shadow_cache_small_objects_have_their_own_corners(void)
+{
+}
+
+void test_draw_sw_shadow_cache_skips_large_shadows(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_BAND_HEIGHT && LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+
+#define CANVAS_W    160
+#define CANVAS_H    (LV_DRAW_SW_BAND_HEIGHT * 8)
+#define REPEAT_CNT  20
+#define IMG_W       40
+#define IMG_H       (LV_DRAW_SW_BAND_HEIGHT * 4)
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+static uint8_t ref_buf[CANVAS_W * CANVAS_H * 4];
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_draw_sw_set_thread_cnt(LV_DRAW_SW_DRAW_UNIT_CNT);
+    lv_obj_delete(canvas);
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static void draw_image(const lv_image_dsc_t * img)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = img;
+
+    lv_area_t coords = {10, 10, 10 + IMG_W - 1, 10 + IMG_H - 1};
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_image(&layer, &dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static void check_split_image(const lv_image_dsc_t * img)
+{
+    lv_draw_sw_set_thread_cnt(1);
+    draw_image(img);
+    lv_memcpy(ref_buf, draw_buf->data, sizeof(ref_buf));
+
+    lv_draw_sw_set_thread_cnt(LV_DRAW_SW_DRAW_UNIT_CNT);
+    uint32_t i;
+    for(i = 0; i < REPEAT_CNT; i++) {
+        draw_image(img);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, draw_buf->data, sizeof(ref_buf));
+    }
+}
+
+static void draw_grad(const lv_grad_dsc_t * grad)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_TRANSP);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_grad = *grad;
+
+    lv_area_t coords = {0, 0, CANVAS_W - 1, CANVAS_H - 1};
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_rect(&layer, &dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+/*The bands share the task, but the gradient state must stay private to each thread*/
+static void check_split_grad(const lv_grad_dsc_t * grad)
+{
+    lv_draw_sw_set_thread_cnt(1);
+    draw_grad(grad);
+    lv_memcpy(ref_buf, draw_buf->data, sizeof(ref_buf));
+
+    lv_draw_sw_set_thread_cnt(LV_DRAW_SW_DRAW_UNIT_CNT);
+    uint32_t i;
+    for(i = 0; i < REPEAT_CNT; i++) {
+        draw_grad(grad);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, draw_buf->data, sizeof(ref_buf));
+    }
+}
+
+static void init_stops(lv_grad_dsc_t * grad)
+{
+    lv_color_t colors[2] = {lv_palette_main(LV_PALETTE_RED), lv_palette_main(LV_PALETTE_BLUE)};
+    lv_opa_t opas[2] = {LV_OPA_COVER, LV_OPA_50};
+    lv_memzero(grad, sizeof(*grad));
+    lv_grad_init_stops(grad, colors, opas, NULL, 2);
+}
+
+void test_split_linear_gradient_matches_single_thread(void)
+{
+    lv_grad_dsc_t grad;
+    init_stops(&grad);
+    lv_grad_linear_init(&grad, LV_GRAD_LEFT, LV_GRAD_TOP, LV_GRAD_RIGHT, LV_GRAD_BOTTOM, LV_GRAD_EXTEND_REFLECT);
+    check_split_grad(&grad);
+}
+
+void test_split_radial_gradient_matches_single_thread(void)
+{
+    lv_grad_dsc_t grad;
+    init_stops(&grad);
+    lv_grad_radial_init(&grad, LV_GRAD_CENTER, LV_GRAD_CENTER, LV_GRAD_RIGHT, LV_GRAD_BOTTOM, LV_GRAD_EXTEND_REPEAT);
+    lv_grad_radial_set_focal(&grad, 20, 20, 5);
+    check_split_grad(&grad);
+}
+
+void test_split_conical_gradient_matches_single_thread(void)
+{
+    lv_grad_dsc_t grad;
+    init_stops(&grad);
+    lv_grad_conical_init(&grad, LV_GRAD_CENTER, LV_GRAD_CENTER, 0, 270, LV_GRAD_EXTEND_PAD);
+    check_split_grad(&grad);
+}
+
+/*The blender reads ARGB8888 directly so it's drawn in bands*/
+void test_split_argb8888_image_matches_single_thread(void)
+{
+    static uint32_t pixels[IMG_W * IMG_H];
+    uint32_t i;
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        pixels[i] = ((i * 4) & 0xFF) << 24 | (i * 2654435761u & 0xFFFFFF);
+    }
+
+    lv_image_dsc_t img;
+    lv_memzero(&img, sizeof(img));
+    img.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    img.header.w = IMG_W;
+    img.header.h = IMG_H;
+    img.header.stride = IMG_W * 4;
+    img.data = (const uint8_t *)pixels;
+    img.data_size = sizeof(pixels);
+
+    check_split_image(&img);
+}
+
+/*Indexed images need to be decoded first so they are drawn in one piece*/
+void test_split_indexed_image_matches_single_thread(void)
+{
+    static uint8_t data[256 * 4 + IMG_W * IMG_H];
+    uint32_t i;
+    for(i = 0; i < 256; i++) {
+        lv_color32_t * palette = (lv_color32_t *)data;
+        palette[i] = lv_color32_make(i, 255 - i, i * 7, i < 128 ? 255 : i);
+    }
+    for(i = 0; i < IMG_W * IMG_H; i++) {
+        data[256 * 4 + i] = (uint8_t)(i * 13);
+    }
+
+    lv_image_dsc_t img;
+    lv_memzero(&img, sizeof(img));
+    img.header.magic = LV_IMAGE_HEADER_MAGIC;
+    img.header.cf = LV_COLOR_FORMAT_I8;
+    img.header.w = IMG_W;
+    img.header.h = IMG_H;
+    img.header.stride = IMG_W;
+    img.data = data;
+    img.data_size = sizeof(data);
+
+    check_split_image(&img);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_split_linear_gradient_matches_single_thread(void)
+{
+}
+
+void test_split_radial_gradient_matches_single_thread(void)
+{
+}
+
+void test_split_conical_gradient_matches_single_thread(void)
+{
+}
+
+void test_split_argb8888_image_matches_single_thread(void)
+{
+}
+
+void test_split_indexed_image_matches_single_thread(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+
+/*Odd sizes and a padded stride to test the edges and the last pixels of the rows too*/
+#define SRC_W           23
+#define SRC_H           17
+#define SRC_STRIDE_PX   26
+#define DEST_X1         (-12)
+#define DEST_Y1         (-10)
+#define DEST_W          113
+#define DEST_H          97
+
+static uint8_t src_buf[SRC_STRIDE_PX * SRC_H * 4];
+static uint8_t dest_ref[DEST_W * DEST_H * 5];
+static uint8_t dest_buf[DEST_W * DEST_H * 5];
+
+static const int32_t rotation_list[] = {0, 1, 150, 450, 900, 1234, 2700, 3599};
+static const int32_t scale_list[] = {LV_SCALE_NONE, 128, 300, 512, 768, 1000};
+
+void setUp(void)
+{
+    lv_rand_set_seed(0x7A5F);
+}
+
+void tearDown(void)
+{
+    lv_blend_sse2_init();
+}
+
+/*Random pixels, often transparent or the same as the neighbor where the mixing takes a special path*/
+static void randomize(uint8_t * buf, uint32_t size)
+{
+    static const uint8_t special[] = {0, 1, 2, 127, 128, 254, 255};
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        uint32_t r = lv_rand(0, 3);
+        if(r == 0 && i >= 4) buf[i] = buf[i - 4];
+        else if(r == 1) buf[i] = special[lv_rand(0, sizeof(special) - 1)];
+        else buf[i] = lv_rand(0, 255);
+    }
+}
+
+/*Compare the result of each instruction set with the C implementation*/
+static void check_transform(lv_color_format_t cf)
+{
+    uint32_t px_size = lv_color_format_get_size(cf);
+    int32_t src_stride = SRC_STRIDE_PX * px_size;
+    lv_area_t dest_area = {DEST_X1, DEST_Y1, DEST_X1 + DEST_W - 1, DEST_Y1 + DEST_H - 1};
+
+    uint32_t r;
+    for(r = 0; r < sizeof(rotation_list) / sizeof(rotation_list[0]); r++) {
+        uint32_t s;
+        for(s = 0; s < sizeof(scale_list) / sizeof(scale_list[0]); s++) {
+            lv_draw_image_dsc_t dsc;
+            lv_draw_image_dsc_init(&dsc);
+            dsc.rotation = rotation_list[r];
+            dsc.scale_x = scale_list[s];
+            dsc.scale_y = scale_list[(s + r) % (sizeof(scale_list) / sizeof(scale_list[0]))];
+            dsc.pivot.x = lv_rand(0, SRC_W);
+            dsc.pivot.y = lv_rand(0, SRC_H);
+            dsc.antialias = (s + r) % 2;
+            randomize(src_buf, sizeof(src_buf));
+
+            lv_blend_sse2_isa_t isa;
+            for(isa = LV_BLEND_SSE2_ISA_NONE; isa <= LV_BLEND_SSE2_ISA_AVX2; isa++) {
+                lv_blend_sse2_set_isa(isa);
+                if(lv_blend_sse2_get_isa() != isa) continue;  /*Not supported by the CPU*/
+
+                lv_memset(dest_buf, 0x5A, sizeof(dest_buf));
+                lv_draw_sw_transform(&dest_area, src_buf, SRC_W, SRC_H, src_stride, &dsc, NULL, cf, dest_buf);
+
+                if(isa == LV_BLEND_SSE2_ISA_NONE) lv_memcpy(dest_ref, dest_buf, sizeof(dest_buf));
+                else TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(dest_ref, dest_buf, sizeof(dest_buf),
+                                                               isa == LV_BLEND_SSE2_ISA_SSE2 ? "SSE2" : "AVX2");
+            }
+        }
+    }
+}
+
+void test_draw_sw_transform_sse2_argb8888(void)
+{
+    check_transform(LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_draw_sw_transform_sse2_xrgb8888(void)
+{
+    check_transform(LV_COLOR_FORMAT_XRGB8888);
+}
+
+void test_draw_sw_transform_sse2_rgb888(void)
+{
+    check_transform(LV_COLOR_FORMAT_RGB888);
+}
+
+void test_draw_sw_transform_sse2_rgb565(void)
+{
+    check_transform(LV_COLOR_FORMAT_RGB565);
+}
+
+void test_draw_sw_transform_sse2_rgb565a8(void)
+{
+    check_transform(LV_COLOR_FORMAT_RGB565A8);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_transform_sse2_argb8888(void)
+{
+}
+
+void test_draw_sw_transform_sse2_xrgb8888(void)
+{
+}
+
+void test_draw_sw_transform_sse2_rgb888(void)
+{
+}
+
+void test_draw_sw_transform_sse2_rgb565(void)
+{
+}
+
+void test_draw_sw_transform_sse2_rgb565a8(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,110 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define DRAW_UNIT_ID_TEST   100
+
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    lv_layer_init(&layer);
+    lv_area_set(&layer.buf_area, 0, 0, 99, 99);
+    layer._clip_area = layer.buf_area;
+
+    /*A task in progress at the head keeps the draw units from taking the test tasks*/
+    lv_area_t area = {90, 90, 99, 99};
+    lv_draw_task_t * t = lv_draw_add_task(&layer, &area);
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+}
+
+void tearDown(void)
+{
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t) {
+        t->state = LV_DRAW_TASK_STATE_READY;
+        t = t->next;
+    }
+    lv_draw_dispatch_layer(NULL, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+}
+
+static lv_draw_task_t * add_task(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_draw_task_t * t = lv_draw_add_task(&layer, &area);
+    t->preferred_draw_unit_id = DRAW_UNIT_ID_TEST;
+    return t;
+}
+
+static lv_draw_task_t * take_task(lv_draw_task_t * t_prev)
+{
+    lv_draw_task_t * t = lv_draw_get_next_available_task(&layer, t_prev, DRAW_UNIT_ID_TEST);
+    if(t) t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    return t;
+}
+
+static void finish_task(lv_draw_task_t * t)
+{
+    t->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_dispatch_layer(NULL, &layer);
+}
+
+void test_draw_task_deps_waits_for_all_overlapping_older_tasks(void)
+{
+    lv_draw_task_t * a = add_task(0, 0, 9, 9);
+    lv_draw_task_t * b = add_task(20, 0, 29, 9);
+    lv_draw_task_t * c = add_task(5, 5, 25, 15);
+    lv_draw_task_t * d = add_task(40, 0, 49, 9);
+
+    /*The independent tasks can be drawn in parallel, the overlapping one is skipped*/
+    TEST_ASSERT_EQUAL_PTR(a, take_task(NULL));
+    TEST_ASSERT_EQUAL_PTR(b, take_task(a));
+    TEST_ASSERT_EQUAL_PTR(d, take_task(b));
+    TEST_ASSERT_NULL(take_task(d));
+    TEST_ASSERT_EQUAL_PTR(a, c->dep_blocker);
+    TEST_ASSERT_EQUAL_UINT32(1, a->dep_ref_cnt);
+
+    /*Checking continues after the removed task and finds the other one*/
+    finish_task(a);
+    TEST_ASSERT_EQUAL_PTR(b, c->dep_scan);
+    TEST_ASSERT_NULL(take_task(NULL));
+    TEST_ASSERT_EQUAL_PTR(b, c->dep_blocker);
+
+    finish_task(b);
+    TEST_ASSERT_TRUE(c->dep_independent);
+    TEST_ASSERT_EQUAL_PTR(c, take_task(NULL));
+}
+
+void test_draw_task_deps_keep_the_order_of_a_chain(void)
+{
+    lv_draw_task_t * tasks[5];
+    uint32_t i;
+    for(i = 0; i < 5; i++) tasks[i] = add_task(i * 10, 0, i * 10 + 15, 9);
+
+    /*Each task overlaps only the previous one, so they are drawn one by one*/
+    for(i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_PTR(tasks[i], take_task(NULL));
+        TEST_ASSERT_NULL(take_task(tasks[i]));
+        finish_task(tasks[i]);
+    }
+}
+
+void test_draw_task_deps_skip_the_finished_tasks(void)
+{
+    lv_draw_task_t * a = add_task(0, 0, 9, 9);
+    lv_draw_task_t * b = add_task(0, 0, 9, 9);
+    TEST_ASSERT_EQUAL_PTR(a, take_task(NULL));
+    TEST_ASSERT_NULL(take_task(a));
+    TEST_ASSERT_EQUAL_PTR(a, b->dep_blocker);
+
+    /*A finished task is not waited for even before it's removed*/
+    a->state = LV_DRAW_TASK_STATE_READY;
+    TEST_ASSERT_EQUAL_PTR(b, take_task(NULL));
+    TEST_ASSERT_NULL(b->dep_blocker);
+    TEST_ASSERT_EQUAL_UINT32(0, a->dep_ref_cnt);
+}
+
+#endif
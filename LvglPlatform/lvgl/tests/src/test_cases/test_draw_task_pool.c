@@ -0,0 +1,109 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    100
+#define CANVAS_H    100
+#define RECT_CNT    50
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static void draw_rects(void)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0x2080ff);
+    dsc.border_width = 1;
+
+    uint32_t i;
+    for(i = 0; i < RECT_CNT; i++) {
+        lv_area_t area = {i, i, i + 10, i + 10};
+        lv_draw_rect(&layer, &dsc, &area);
+    }
+}
+
+void test_draw_task_pool_appends_to_the_tail(void)
+{
+    lv_canvas_init_layer(canvas, &layer);
+    draw_rects();
+
+    /*A fill and a border for each rectangle, in order*/
+    uint32_t cnt = 0;
+    lv_draw_task_t * t = layer.draw_task_head;
+    lv_draw_task_t * last = NULL;
+    while(t) {
+        TEST_ASSERT_EQUAL(cnt % 2 ? LV_DRAW_TASK_TYPE_BORDER : LV_DRAW_TASK_TYPE_FILL, t->type);
+        TEST_ASSERT_EQUAL_INT32(cnt / 2, t->area.x1);
+        last = t;
+        t = t->next;
+        cnt++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(RECT_CNT * 2, cnt);
+    TEST_ASSERT_EQUAL_PTR(last, layer.draw_task_tail);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+}
+
+void test_draw_task_pool_reuses_the_finished_tasks(void)
+{
+    lv_draw_global_info_t * info = &LV_GLOBAL_DEFAULT()->draw_info;
+
+    lv_canvas_init_layer(canvas, &layer);
+    draw_rects();
+    lv_canvas_finish_layer(canvas, &layer);
+
+    uint32_t pool_cnt = info->task_pool_cnt;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(LV_MIN(RECT_CNT * 2, LV_DRAW_TASK_POOL_CNT), pool_cnt);
+
+    /*The same drawing takes its tasks from the pool, and gives them back*/
+    lv_draw_task_t * pooled = info->task_pool;
+    lv_canvas_init_layer(canvas, &layer);
+    draw_rects();
+    TEST_ASSERT_EQUAL_PTR(pooled, layer.draw_task_head);
+    TEST_ASSERT_EQUAL_PTR(layer.draw_task_head + 1, layer.draw_task_head->draw_dsc);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    TEST_ASSERT_EQUAL_UINT32(pool_cnt, info->task_pool_cnt);
+}
+
+void test_draw_task_pool_allocates_large_draw_descriptors(void)
+{
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_fill_dsc_t fill_dsc;
+    lv_draw_fill_dsc_init(&fill_dsc);
+    fill_dsc.color = lv_color_hex(0xff0000);
+
+    /*Larger than any built-in draw descriptor, so it's allocated and freed with the task*/
+    lv_area_t area = {10, 10, 20, 20};
+    lv_draw_task_t * t = lv_draw_add_task(&layer, &area);
+    t->draw_dsc = lv_draw_task_alloc_draw_dsc(t, 4096);
+    TEST_ASSERT_NOT_EQUAL(t + 1, t->draw_dsc);
+    lv_memcpy(t->draw_dsc, &fill_dsc, sizeof(fill_dsc));
+    t->type = LV_DRAW_TASK_TYPE_FILL;
+    lv_draw_finalize_task_creation(&layer, t);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_color32_t px = lv_canvas_get_px(canvas, 15, 15);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_color_make(px.red, px.green, px.blue));
+}
+
+#endif
@@ -0,0 +1,109 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define FONT_COPY_CNT (LV_FONT_FMT_TXT_GLYPH_INDEX_FONT_CNT + 2)
+
+static lv_font_t font_copies[FONT_COPY_CNT];
+static lv_font_fmt_txt_dsc_t font_dsc_copies[FONT_COPY_CNT];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/* Glyph ID of a letter as described for `lv_font_fmt_txt_cmap_t`, independent of the glyph index */
+static uint32_t find_glyph_id_in_cmaps(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t rcp = letter - cmap->range_start;
+        if(rcp >= cmap->range_length) continue;
+
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) return cmap->glyph_id_start + rcp;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * ofs = cmap->glyph_id_ofs_list;
+            /*A 0 offset after the first character is a missing character*/
+            if(ofs[rcp] == 0 && rcp != 0) continue;
+            return cmap->glyph_id_start + ofs[rcp];
+        }
+
+        int32_t low = 0;
+        int32_t high = (int32_t)cmap->list_length - 1;
+        while(low <= high) {
+            int32_t mid = (low + high) / 2;
+            if(cmap->unicode_list[mid] < rcp) low = mid + 1;
+            else if(cmap->unicode_list[mid] > rcp) high = mid - 1;
+            else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) return cmap->glyph_id_start + mid;
+            else return cmap->glyph_id_start + ((const uint16_t *)cmap->glyph_id_ofs_list)[mid];
+        }
+        return 0;
+    }
+
+    return 0;
+}
+
+static void check_font(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    uint32_t letter;
+    for(letter = 1; letter < 0x11000; letter++) {
+        if(letter == '\t') continue;
+
+        lv_font_glyph_dsc_t dsc;
+        bool found = lv_font_get_glyph_dsc_fmt_txt(font, &dsc, letter, 0);
+        uint32_t gid = find_glyph_id_in_cmaps(fdsc, letter);
+        TEST_ASSERT_EQUAL(gid != 0, found);
+        if(found) TEST_ASSERT_EQUAL_UINT32(gid, dsc.gid.index);
+    }
+}
+
+void test_font_fmt_txt_glyph_index_matches_cmaps(void)
+{
+    check_font(&lv_font_montserrat_14);
+    check_font(&lv_font_montserrat_28_compressed);
+    check_font(&lv_font_dejavu_16_persian_hebrew);
+    check_font(&lv_font_simsun_16_cjk);
+    check_font(&lv_font_unscii_8);
+}
+
+void test_font_fmt_txt_glyph_index_more_fonts_than_slots(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    lv_font_get_glyph_dsc_fmt_txt(&lv_font_montserrat_14, &dsc, 'A', 0);
+    uint32_t gid = dsc.gid.index;
+
+    /*Each copy has its own descriptor and there are more copies than slots, so some keep searching their cmaps*/
+    uint32_t i;
+    for(i = 0; i < FONT_COPY_CNT; i++) {
+        font_dsc_copies[i] = *(const lv_font_fmt_txt_dsc_t *)lv_font_montserrat_14.dsc;
+        font_copies[i] = lv_font_montserrat_14;
+        font_copies[i].dsc = &font_dsc_copies[i];
+
+        TEST_ASSERT_TRUE(lv_font_get_glyph_dsc_fmt_txt(&font_copies[i], &dsc, 'A', 0));
+        TEST_ASSERT_EQUAL_UINT32(gid, dsc.gid.index);
+    }
+
+    /*Removing an index must keep the other indexes of its probe sequence reachable*/
+    for(i = 0; i < FONT_COPY_CNT; i += 2) {
+        lv_font_fmt_txt_glyph_index_remove(&font_dsc_copies[i]);
+    }
+
+    for(i = 0; i < FONT_COPY_CNT; i++) {
+        check_font(&font_copies[i]);
+    }
+
+    for(i = 0; i < FONT_COPY_CNT; i++) {
+        lv_font_fmt_txt_glyph_index_remove(&font_dsc_copies[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,130 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+LV_FONT_DECLARE(test_font_montserrat_ascii_1bpp);
+LV_FONT_DECLARE(test_font_montserrat_ascii_2bpp);
+LV_FONT_DECLARE(test_font_montserrat_ascii_3bpp_compressed);
+LV_FONT_DECLARE(test_font_montserrat_ascii_4bpp);
+LV_FONT_DECLARE(test_font_montserrat_ascii_8bpp);
+
+static lv_draw_buf_t * draw_buf;
+
+void setUp(void)
+{
+    lv_font_glyph_atlas_resize(16 * 1024, true);
+    lv_font_glyph_atlas_drop_all();
+    draw_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+}
+
+void tearDown(void)
+{
+    lv_draw_buf_destroy(draw_buf);
+    lv_font_glyph_atlas_resize(LV_FONT_GLYPH_ATLAS_DEF_SIZE, true);
+    lv_font_glyph_atlas_drop_all();
+}
+
+/*Unpack the bitmap of a letter into `draw_buf` without the atlas*/
+static void unpack_letter(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * g)
+{
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, g, letter, 0));
+    lv_draw_buf_reshape(draw_buf, LV_COLOR_FORMAT_A8, g->box_w, g->box_h, LV_STRIDE_AUTO);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_bitmap_fmt_txt(g, draw_buf));
+}
+
+static void assert_same_bitmap(const lv_draw_buf_t * expected, const lv_draw_buf_t * actual, uint32_t w, uint32_t h)
+{
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected->data + y * expected->header.stride,
+                                      actual->data + y * actual->header.stride, w);
+    }
+}
+
+void test_font_glyph_atlas_bitmaps_match_the_unpacked_ones(void)
+{
+    const lv_font_t * fonts[] = {&test_font_montserrat_ascii_1bpp, &test_font_montserrat_ascii_2bpp,
+                                 &test_font_montserrat_ascii_3bpp_compressed, &test_font_montserrat_ascii_4bpp
+                                };
+    const char * letters = "AgW@%";
+
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        const char * l;
+        for(l = letters; *l; l++) {
+            lv_font_glyph_dsc_t g;
+            unpack_letter(fonts[i], *l, &g);
+
+            const lv_draw_buf_t * bitmap = lv_font_get_glyph_bitmap(&g, draw_buf);
+            TEST_ASSERT_NOT_NULL(bitmap);
+            TEST_ASSERT_NOT_EQUAL(draw_buf, bitmap);
+            TEST_ASSERT_NOT_NULL(g.entry);
+            assert_same_bitmap(draw_buf, bitmap, g.box_w, g.box_h);
+            lv_font_glyph_release_draw_data(&g);
+            TEST_ASSERT_NULL(g.entry);
+        }
+    }
+}
+
+void test_font_glyph_atlas_unpacks_a_glyph_once(void)
+{
+    lv_font_glyph_dsc_t g;
+    uint32_t hit_cnt = lv_font_glyph_atlas_get_hit_cnt();
+    uint32_t miss_cnt = lv_font_glyph_atlas_get_miss_cnt();
+
+    unpack_letter(&test_font_montserrat_ascii_4bpp, 'A', &g);
+    const void * first = lv_font_get_glyph_bitmap(&g, draw_buf);
+    lv_font_glyph_release_draw_data(&g);
+    const void * second = lv_font_get_glyph_bitmap(&g, draw_buf);
+    lv_font_glyph_release_draw_data(&g);
+
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt + 1, lv_font_glyph_atlas_get_miss_cnt());
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 1, lv_font_glyph_atlas_get_hit_cnt());
+
+    uint32_t stride = lv_draw_buf_width_to_stride(g.box_w, LV_COLOR_FORMAT_A8);
+    TEST_ASSERT_EQUAL_UINT32(stride * g.box_h, lv_font_glyph_atlas_get_size());
+}
+
+void test_font_glyph_atlas_skips_plain_8bpp_fonts(void)
+{
+    lv_font_glyph_dsc_t g;
+
+    unpack_letter(&test_font_montserrat_ascii_8bpp, 'A', &g);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_glyph_bitmap(&g, draw_buf));
+    TEST_ASSERT_NULL(g.entry);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_glyph_atlas_get_size());
+}
+
+void test_font_glyph_atlas_keeps_its_size_limit(void)
+{
+    lv_font_glyph_atlas_resize(1024, true);
+
+    char letter;
+    for(letter = 'A'; letter <= 'Z'; letter++) {
+        lv_font_glyph_dsc_t g;
+        unpack_letter(&test_font_montserrat_ascii_4bpp, letter, &g);
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(&g, draw_buf));
+        lv_font_glyph_release_draw_data(&g);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(1024, lv_font_glyph_atlas_get_size());
+    }
+
+    lv_font_glyph_atlas_drop_all();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_glyph_atlas_get_size());
+}
+
+void test_font_glyph_atlas_disabled(void)
+{
+    lv_font_glyph_dsc_t g;
+
+    lv_font_glyph_atlas_resize(0, true);
+    TEST_ASSERT_FALSE(lv_font_glyph_atlas_is_enabled());
+
+    unpack_letter(&test_font_montserrat_ascii_1bpp, 'A', &g);
+    TEST_ASSERT_EQUAL_PTR(draw_buf, lv_font_get_glyph_bitmap(&g, draw_buf));
+    TEST_ASSERT_NULL(g.entry);
+}
+
+#endif
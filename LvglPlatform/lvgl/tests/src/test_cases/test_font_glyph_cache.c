@@ -0,0 +1,185 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static uint32_t get_glyph_dsc_cnt;
+
+static bool counting_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                   uint32_t letter_next)
+{
+    get_glyph_dsc_cnt++;
+
+    if(letter < 'A' || letter > 'Z') return false;
+
+    bool kerned = font->kerning == LV_FONT_KERNING_NORMAL && letter_next == 'V';
+    dsc_out->box_w = 8;
+    dsc_out->box_h = 10;
+    dsc_out->adv_w = kerned ? 7 : 9; /*Kerning with 'V'*/
+    dsc_out->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc_out->gid.index = letter - 'A' + 1;
+    return true;
+}
+
+static bool lowercase_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                    uint32_t letter_next)
+{
+    if(letter < 'a' || letter > 'z') return false;
+
+    bool kerned = font->kerning == LV_FONT_KERNING_NORMAL && letter_next == 'v';
+    dsc_out->box_w = 6;
+    dsc_out->box_h = 8;
+    dsc_out->adv_w = kerned ? 5 : 7; /*Kerning with 'v'*/
+    dsc_out->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc_out->gid.index = letter - 'a' + 1;
+    return true;
+}
+
+static lv_font_t counting_font = {
+    .get_glyph_dsc = counting_get_glyph_dsc,
+    .line_height = 12,
+    .base_line = 2,
+    .kerning = LV_FONT_KERNING_NORMAL,
+};
+
+static lv_font_t lowercase_font = {
+    .get_glyph_dsc = lowercase_get_glyph_dsc,
+    .line_height = 12,
+    .base_line = 2,
+    .kerning = LV_FONT_KERNING_NORMAL,
+};
+
+void setUp(void)
+{
+    lv_font_glyph_cache_resize(16, true);
+    lv_font_glyph_cache_drop_all();
+    get_glyph_dsc_cnt = 0;
+}
+
+void tearDown(void)
+{
+    counting_font.fallback = NULL;
+    lv_font_set_kerning(&counting_font, LV_FONT_KERNING_NORMAL);
+    lv_font_set_kerning(&lowercase_font, LV_FONT_KERNING_NORMAL);
+    lv_font_glyph_cache_resize(LV_FONT_GLYPH_CACHE_DEF_CNT, true);
+    lv_font_glyph_cache_drop_all();
+}
+
+void test_font_glyph_cache_resolves_a_letter_pair_once(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    uint32_t hit_cnt = lv_font_glyph_cache_get_hit_cnt();
+
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'V'));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'V'));
+    TEST_ASSERT_EQUAL_UINT32(1, get_glyph_dsc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt + 1, lv_font_glyph_cache_get_hit_cnt());
+    TEST_ASSERT_EQUAL(7, dsc.adv_w);
+    TEST_ASSERT_EQUAL_UINT32(1, dsc.gid.index);
+    TEST_ASSERT_EQUAL_PTR(&counting_font, dsc.resolved_font);
+
+    /*The kerning depends on the next letter, so it's another entry*/
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'B'));
+    TEST_ASSERT_EQUAL_UINT32(2, get_glyph_dsc_cnt);
+    TEST_ASSERT_EQUAL(9, dsc.adv_w);
+}
+
+void test_font_glyph_cache_keeps_missing_glyphs(void)
+{
+    lv_font_glyph_dsc_t dsc;
+
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 0));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 0));
+    TEST_ASSERT_EQUAL_UINT32(1, get_glyph_dsc_cnt);
+    TEST_ASSERT_TRUE(dsc.is_placeholder);
+    TEST_ASSERT_NULL(dsc.resolved_font);
+}
+
+void test_font_glyph_cache_drop_all(void)
+{
+    lv_font_glyph_dsc_t dsc;
+
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 0);
+    lv_font_glyph_cache_drop_all();
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 0);
+    TEST_ASSERT_EQUAL_UINT32(2, get_glyph_dsc_cnt);
+}
+
+void test_font_glyph_cache_is_dropped_on_kerning_change(void)
+{
+    lv_font_glyph_dsc_t dsc;
+
+    /*With a fallback the next letter is part of the key even without kerning*/
+    counting_font.fallback = &lowercase_font;
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'V');
+    TEST_ASSERT_EQUAL(7, dsc.adv_w);
+
+    lv_font_set_kerning(&counting_font, LV_FONT_KERNING_NONE);
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'V');
+    TEST_ASSERT_EQUAL(9, dsc.adv_w);
+    TEST_ASSERT_EQUAL_UINT32(2, get_glyph_dsc_cnt);
+
+    /*Setting the same kerning keeps the cache*/
+    lv_font_set_kerning(&counting_font, LV_FONT_KERNING_NONE);
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 'V');
+    TEST_ASSERT_EQUAL_UINT32(2, get_glyph_dsc_cnt);
+}
+
+void test_font_glyph_cache_is_dropped_on_fallback_kerning_change(void)
+{
+    lv_font_glyph_dsc_t dsc;
+
+    counting_font.fallback = &lowercase_font;
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 'v');
+    TEST_ASSERT_EQUAL(5, dsc.adv_w);
+    TEST_ASSERT_EQUAL_PTR(&lowercase_font, dsc.resolved_font);
+
+    lv_font_set_kerning(&lowercase_font, LV_FONT_KERNING_NONE);
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 'v');
+    TEST_ASSERT_EQUAL(7, dsc.adv_w);
+}
+
+void test_font_glyph_cache_keys_on_the_fallback(void)
+{
+    lv_font_glyph_dsc_t dsc;
+
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 0));
+
+    counting_font.fallback = &lowercase_font;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 0));
+    TEST_ASSERT_EQUAL_PTR(&lowercase_font, dsc.resolved_font);
+
+    counting_font.fallback = NULL;
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(&counting_font, &dsc, 'a', 0));
+}
+
+void test_font_glyph_cache_evicts_beyond_its_size(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    uint32_t letter;
+
+    for(letter = 'A'; letter <= 'Z'; letter++) {
+        lv_font_get_glyph_dsc(&counting_font, &dsc, letter, 0);
+    }
+
+    /*Only the last 16 letters are kept*/
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'Z', 0);
+    TEST_ASSERT_EQUAL_UINT32(26, get_glyph_dsc_cnt);
+    lv_font_get_glyph_dsc(&counting_font, &dsc, 'A', 0);
+    TEST_ASSERT_EQUAL_UINT32(27, get_glyph_dsc_cnt);
+}
+
+void test_font_glyph_cache_is_not_used_by_built_in_fonts(void)
+{
+    lv_font_glyph_dsc_t dsc;
+    uint32_t hit_cnt = lv_font_glyph_cache_get_hit_cnt();
+    uint32_t miss_cnt = lv_font_glyph_cache_get_miss_cnt();
+
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_14, &dsc, 'A', 'V'));
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(&lv_font_montserrat_14, &dsc, 'A', 'V'));
+    TEST_ASSERT_EQUAL_UINT32(hit_cnt, lv_font_glyph_cache_get_hit_cnt());
+    TEST_ASSERT_EQUAL_UINT32(miss_cnt, lv_font_glyph_cache_get_miss_cnt());
+}
+
+#endif
@@ -0,0 +1,193 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define DISP_W      320
+#define DISP_H      240
+#define BUF_ROWS    40
+
+static lv_display_t * disp;
+static lv_display_t * disp_ori;
+static uint8_t * buf;
+static uint8_t flushed[DISP_H][DISP_W];
+static uint32_t max_flush_size;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(px_map);
+    uint32_t size = lv_draw_buf_width_to_stride(lv_area_get_width(area), lv_display_get_color_format(d)) *
+                    lv_area_get_height(area);
+    max_flush_size = LV_MAX(max_flush_size, size);
+    int32_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memset(&flushed[y][area->x1], 1, lv_area_get_width(area));
+    }
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    disp_ori = lv_display_get_default();
+    disp = lv_display_create(DISP_W, DISP_H);
+    uint32_t buf_size = lv_draw_buf_width_to_stride(DISP_W, lv_display_get_color_format(disp)) * BUF_ROWS;
+    buf = lv_malloc(buf_size + LV_DRAW_BUF_ALIGN);
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf, lv_display_get_color_format(disp)), NULL, buf_size,
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+
+    /*Start from a clean state*/
+    lv_refr_now(disp);
+    lv_memzero(flushed, sizeof(flushed));
+    max_flush_size = 0;
+}
+
+void tearDown(void)
+{
+    lv_display_delete(disp);
+    lv_free(buf);
+    lv_display_set_default(disp_ori);
+}
+
+/*Small areas scattered on the screen, not touching each other*/
+static void get_small_area(uint32_t i, lv_area_t * area)
+{
+    area->x1 = (int32_t)(i % 10) * 31 + 3;
+    area->y1 = (int32_t)(i / 10) * 29 + 5;
+    area->x2 = area->x1 + 7;
+    area->y2 = area->y1 + 5;
+}
+
+void test_inv_area_marks_tiles_instead_of_the_screen(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_INV_BUF_SIZE + 20; i++) {
+        lv_area_t area;
+        get_small_area(i, &area);
+        lv_inv_area(disp, &area);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_p);
+    TEST_ASSERT_TRUE(disp->inv_tiles_dirty);
+    for(i = 0; i < disp->inv_p; i++) {
+        TEST_ASSERT_LESS_THAN_INT32(DISP_W, lv_area_get_width(&disp->inv_areas[i]));
+    }
+
+    /*An area in the marked tiles is not saved again*/
+    lv_area_t area;
+    get_small_area(LV_INV_BUF_SIZE + 5, &area);
+    lv_area_increase(&area, 1, 1);
+    lv_inv_area(disp, &area);
+    TEST_ASSERT_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_p);
+
+    lv_inv_area(disp, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+    TEST_ASSERT_FALSE(disp->inv_tiles_dirty);
+}
+
+void test_inv_area_redraws_all_areas_but_not_the_screen(void)
+{
+    uint32_t area_cnt = 70;
+    uint32_t i;
+    for(i = 0; i < area_cnt; i++) {
+        lv_area_t area;
+        get_small_area(i, &area);
+        lv_inv_area(disp, &area);
+    }
+
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+    TEST_ASSERT_FALSE(disp->inv_tiles_dirty);
+
+    for(i = 0; i < area_cnt; i++) {
+        lv_area_t area;
+        get_small_area(i, &area);
+        int32_t x;
+        int32_t y;
+        for(y = area.y1; y <= area.y2; y++) {
+            for(x = area.x1; x <= area.x2; x++) {
+                TEST_ASSERT_EQUAL_UINT8(1, flushed[y][x]);
+            }
+        }
+    }
+
+    uint32_t flushed_px = 0;
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < DISP_H; y++) {
+        for(x = 0; x < DISP_W; x++) flushed_px += flushed[y][x];
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(DISP_W * DISP_H, flushed_px);
+}
+
+void test_inv_area_tiles_follow_the_resolution(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_INV_BUF_SIZE + 10; i++) {
+        lv_area_t area;
+        get_small_area(i, &area);
+        lv_inv_area(disp, &area);
+    }
+
+    /*The old tiles are dropped and the new screen covers all the areas*/
+    lv_display_set_resolution(disp, DISP_W / 2, DISP_H / 2);
+    for(i = 0; i < LV_INV_BUF_SIZE + 10; i++) {
+        lv_area_t area;
+        get_small_area(i, &area);
+        lv_inv_area(disp, &area);
+    }
+    TEST_ASSERT_FALSE(disp->inv_tiles_dirty);
+
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+
+    /*Nothing is flushed out of the new resolution*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < DISP_H; y++) {
+        for(x = 0; x < DISP_W; x++) {
+            if(x >= DISP_W / 2 || y >= DISP_H / 2) TEST_ASSERT_EQUAL_UINT8(0, flushed[y][x]);
+        }
+    }
+}
+
+void test_inv_area_tiled_mode_redraws_only_the_marked_tiles(void)
+{
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_TILED);
+
+    static uint8_t marked[DISP_H / LV_INV_TILE_SIZE + 1][DISP_W / LV_INV_TILE_SIZE + 1];
+    lv_memzero(marked, sizeof(marked));
+
+    /*A few scattered areas, and a tall one which doesn't fit into the buffer*/
+    lv_area_t areas[] = {{3, 5, 10, 10}, {200, 40, 230, 70}, {290, 200, 319, 239}, {100, 0, 140, DISP_H - 1}};
+    uint32_t i;
+    for(i = 0; i < sizeof(areas) / sizeof(areas[0]); i++) {
+        lv_inv_area(disp, &areas[i]);
+
+        int32_t row;
+        int32_t col;
+        for(row = areas[i].y1 / LV_INV_TILE_SIZE; row <= areas[i].y2 / LV_INV_TILE_SIZE; row++) {
+            for(col = areas[i].x1 / LV_INV_TILE_SIZE; col <= areas[i].x2 / LV_INV_TILE_SIZE; col++) {
+                marked[row][col] = 1;
+            }
+        }
+    }
+
+    /*Even the first areas are marked on the tiles*/
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+    TEST_ASSERT_TRUE(disp->inv_tiles_dirty);
+
+    lv_refr_now(disp);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(disp->buf_1->data_size, max_flush_size);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < DISP_H; y++) {
+        for(x = 0; x < DISP_W; x++) {
+            TEST_ASSERT_EQUAL_UINT8(marked[y / LV_INV_TILE_SIZE][x / LV_INV_TILE_SIZE], flushed[y][x]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,183 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+#define CANVAS_W    120
+#define CANVAS_H    120
+
+static const char * long_text =
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit.\nCras malesuada ultrices magna in rutrum. "
+    "Etiam ut lacus non nulla porta aliquet.";
+
+static lv_obj_t * label;
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+
+void setUp(void)
+{
+    label = lv_label_create(lv_screen_active());
+    lv_obj_set_width(label, 100);
+    lv_label_set_text(label, long_text);
+
+    draw_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static void init_draw_dsc(lv_draw_label_dsc_t * dsc, const char * text, lv_text_align_t align)
+{
+    lv_draw_label_dsc_init(dsc);
+    dsc->text = text;
+    dsc->font = &lv_font_montserrat_14;
+    dsc->color = lv_color_black();
+    dsc->align = align;
+    dsc->line_space = 2;
+}
+
+/*Draw the text to the canvas and return the checksum of the pixels*/
+static uint32_t draw_to_canvas(const lv_draw_label_dsc_t * dsc, int32_t y_ofs)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_area_t coords = {10, 10 - y_ofs, 10 + 99, CANVAS_H + 200};
+    lv_draw_label(&layer, dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    uint32_t sum = 0;
+    const uint32_t * px = (const uint32_t *)draw_buf->data;
+    uint32_t i;
+    for(i = 0; i < draw_buf->data_size / sizeof(uint32_t); i++) {
+        sum = sum * 31 + px[i];
+    }
+    return sum;
+}
+
+void test_label_line_cache_matches_the_measured_lines(void)
+{
+    lv_draw_label_dsc_t dsc;
+    init_draw_dsc(&dsc, long_text, LV_TEXT_ALIGN_LEFT);
+
+    lv_draw_label_lines_t lines;
+    lv_memzero(&lines, sizeof(lines));
+    lv_draw_label_lines_update(&lines, &dsc, 100);
+    TEST_ASSERT_TRUE(lines.valid);
+
+    uint32_t start = 0;
+    uint32_t i = 0;
+    while(long_text[start] != '\0') {
+        uint32_t len = lv_text_get_next_line(&long_text[start], LV_TEXT_LEN_MAX, dsc.font, 0, 100, NULL,
+                                             LV_TEXT_FLAG_NONE);
+        lv_draw_label_line_t * line = lv_array_at(&lines.lines, i);
+        TEST_ASSERT_EQUAL_UINT32(start, line->start);
+        TEST_ASSERT_EQUAL_INT32(lv_text_get_width(&long_text[start], len, dsc.font, 0), line->width);
+        start += len;
+        i++;
+    }
+
+    /*One more entry for the end of the text*/
+    TEST_ASSERT_EQUAL_UINT32(i + 1, lv_array_size(&lines.lines));
+    lv_draw_label_line_t * last = lv_array_at(&lines.lines, i);
+    TEST_ASSERT_EQUAL_UINT32(lv_strlen(long_text), last->start);
+
+    lv_draw_label_lines_deinit(&lines);
+}
+
+void test_label_line_cache_is_made_again_only_if_needed(void)
+{
+    lv_draw_label_dsc_t dsc;
+    init_draw_dsc(&dsc, long_text, LV_TEXT_ALIGN_LEFT);
+
+    lv_draw_label_lines_t lines;
+    lv_memzero(&lines, sizeof(lines));
+    lv_draw_label_lines_update(&lines, &dsc, 100);
+    uint32_t line_cnt = lv_array_size(&lines.lines);
+
+    /*Another width breaks the text differently*/
+    lv_draw_label_lines_update(&lines, &dsc, 200);
+    TEST_ASSERT_LESS_THAN_UINT32(line_cnt, lv_array_size(&lines.lines));
+    TEST_ASSERT_EQUAL_INT32(200, lines.width);
+
+    dsc.letter_space = 5;
+    lv_draw_label_lines_update(&lines, &dsc, 200);
+    TEST_ASSERT_EQUAL_INT32(5, lines.letter_space);
+
+    /*Nothing changed, so the lines are kept even if modified*/
+    lv_draw_label_line_t * line = lv_array_at(&lines.lines, 0);
+    line->width = -1;
+    lv_draw_label_lines_update(&lines, &dsc, 200);
+    TEST_ASSERT_EQUAL_INT32(-1, line->width);
+
+    lv_draw_label_lines_invalidate(&lines);
+    TEST_ASSERT_FALSE(lines.valid);
+    lv_draw_label_lines_update(&lines, &dsc, 200);
+    TEST_ASSERT_NOT_EQUAL_INT32(-1, line->width);
+
+    lv_draw_label_lines_deinit(&lines);
+}
+
+void test_label_line_cache_draws_the_same_pixels(void)
+{
+    static const lv_text_align_t aligns[] = {LV_TEXT_ALIGN_LEFT, LV_TEXT_ALIGN_CENTER, LV_TEXT_ALIGN_RIGHT};
+    static const int32_t y_ofs[] = {0, 40, 300};
+
+    lv_draw_label_lines_t lines;
+    lv_memzero(&lines, sizeof(lines));
+
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(aligns) / sizeof(aligns[0]); i++) {
+        for(j = 0; j < sizeof(y_ofs) / sizeof(y_ofs[0]); j++) {
+            lv_draw_label_dsc_t dsc;
+            init_draw_dsc(&dsc, long_text, aligns[i]);
+            uint32_t measured = draw_to_canvas(&dsc, y_ofs[j]);
+
+            lv_draw_label_lines_update(&lines, &dsc, 100);
+            dsc.lines = &lines;
+            TEST_ASSERT_EQUAL_UINT32(measured, draw_to_canvas(&dsc, y_ofs[j]));
+        }
+    }
+
+    /*Lines made for another width are ignored*/
+    lv_draw_label_dsc_t dsc;
+    init_draw_dsc(&dsc, long_text, LV_TEXT_ALIGN_LEFT);
+    uint32_t measured = draw_to_canvas(&dsc, 0);
+    lv_draw_label_lines_update(&lines, &dsc, 50);
+    dsc.lines = &lines;
+    TEST_ASSERT_EQUAL_UINT32(measured, draw_to_canvas(&dsc, 0));
+
+    lv_draw_label_lines_deinit(&lines);
+}
+
+void test_label_line_cache_is_invalidated_by_the_label(void)
+{
+    lv_label_t * label_p = (lv_label_t *)label;
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(label_p->lines.valid);
+    TEST_ASSERT_EQUAL_PTR(lv_label_get_text(label), label_p->lines.text);
+    TEST_ASSERT_EQUAL_INT32(lv_obj_get_content_width(label), label_p->lines.width);
+
+    lv_label_set_text(label, "Hello");
+    TEST_ASSERT_FALSE(label_p->lines.valid);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(label_p->lines.valid);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_array_size(&label_p->lines.lines));
+
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_obj_set_width(label, 40);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_PTR(&lv_font_montserrat_24, label_p->lines.font);
+    TEST_ASSERT_EQUAL_INT32(40, label_p->lines.width);
+}
+
+#endif
@@ -0,0 +1,157 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../lvgl_private.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * obj;
+static uint32_t cover_check_cnt;
+static uint32_t screen_draw_cnt;
+
+static void cover_check_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    cover_check_cnt++;
+}
+
+static void not_cover_cb(lv_event_t * e)
+{
+    lv_event_set_cover_res(e, LV_COVER_RES_NOT_COVER);
+}
+
+static void screen_draw_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    screen_draw_cnt++;
+}
+
+void setUp(void)
+{
+    lv_obj_set_style_bg_opa(lv_screen_active(), LV_OPA_COVER, 0);
+    lv_obj_add_event_cb(lv_screen_active(), screen_draw_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+
+    obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, 10, 10);
+    lv_obj_set_size(obj, 100, 100);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_add_event_cb(obj, cover_check_cb, LV_EVENT_COVER_CHECK, NULL);
+
+    lv_refr_now(NULL);
+    cover_check_cnt = 0;
+    screen_draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_remove_event_cb(lv_screen_active(), screen_draw_cb);
+    lv_obj_clean(lv_screen_active());
+}
+
+static void refr_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_inv_area(NULL, &area);
+    lv_refr_now(NULL);
+}
+
+void test_obj_cover_cache_skips_the_cover_check_event(void)
+{
+    uint32_t i;
+    for(i = 0; i < 5; i++) refr_area(40 + i, 40, 60 + i, 60);
+
+    /*Checked once, and the object was the top object so the screen wasn't drawn*/
+    TEST_ASSERT_EQUAL_UINT32(1, cover_check_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, screen_draw_cnt);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_COVER, obj->cover_cache);
+}
+
+void test_obj_cover_cache_is_reset_on_style_change(void)
+{
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_COVER, obj->cover_cache);
+
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_UNKNOWN, obj->cover_cache);
+    lv_refr_now(NULL);
+    screen_draw_cnt = 0;
+
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_NOT_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(1, screen_draw_cnt);
+}
+
+void test_obj_cover_cache_is_reset_on_event_cb_removal(void)
+{
+    lv_obj_add_event_cb(obj, not_cover_cb, LV_EVENT_COVER_CHECK, NULL);
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_NOT_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(1, screen_draw_cnt);
+
+    /*Without the handler the object covers again, even though it wasn't invalidated*/
+    lv_obj_remove_event_cb(obj, not_cover_cb);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_UNKNOWN, obj->cover_cache);
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(1, screen_draw_cnt);
+
+    /*The same when the handler is removed by its descriptor*/
+    lv_event_dsc_t * dsc = lv_obj_add_event_cb(obj, not_cover_cb, LV_EVENT_COVER_CHECK, NULL);
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_NOT_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(2, screen_draw_cnt);
+
+    lv_obj_remove_event_dsc(obj, dsc);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_UNKNOWN, obj->cover_cache);
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(2, screen_draw_cnt);
+}
+
+void test_obj_cover_cache_checks_the_corners_exactly(void)
+{
+    lv_obj_set_style_radius(obj, 20, 0);
+    lv_refr_now(NULL);
+    cover_check_cnt = 0;
+    screen_draw_cnt = 0;
+
+    /*The redraw after the style change has filled the cache, so the inner area is not checked again*/
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_COVER, obj->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(20, obj->cover_inset);
+    refr_area(40, 40, 60, 60);
+    TEST_ASSERT_EQUAL_UINT32(0, cover_check_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, screen_draw_cnt);
+
+    /*In the rounded corner the object is asked, and it doesn't cover*/
+    refr_area(10, 10, 15, 15);
+    TEST_ASSERT_EQUAL_UINT32(1, cover_check_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, screen_draw_cnt);
+
+    /*On the straight edge it covers*/
+    refr_area(50, 10, 60, 15);
+    TEST_ASSERT_EQUAL_UINT32(2, cover_check_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, screen_draw_cnt);
+}
+
+void test_obj_cover_cache_skips_transparent_objects(void)
+{
+    lv_obj_t * child = lv_obj_create(obj);
+    lv_obj_remove_style_all(child);
+    lv_obj_set_size(child, 80, 80);
+    lv_obj_set_style_bg_opa(child, LV_OPA_COVER, 0);
+
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+    cover_check_cnt = 0;
+    screen_draw_cnt = 0;
+
+    /*Neither the object nor its child covers the area*/
+    refr_area(20, 20, 40, 40);
+    refr_area(20, 20, 40, 40);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_SKIP, obj->cover_cache);
+    TEST_ASSERT_EQUAL(LV_OBJ_COVER_CACHE_UNKNOWN, child->cover_cache);
+    TEST_ASSERT_EQUAL_UINT32(0, cover_check_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, screen_draw_cnt);
+}
+
+#endif
@@ -0,0 +1,118 @@
+﻿#include "render_stats.h"
+#include <lvgl/lvgl.h>
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+#include <malloc.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// The draw threads allocate too, so the counters are atomic
+static atomic_uint allocations;
+static atomic_uint frees;
+static atomic_ullong allocated_bytes;
+static atomic_size_t heap_size;
+static atomic_size_t heap_peak;
+
+static void add_heap_size(size_t size)
+{
+    size_t current = atomic_fetch_add(&heap_size, size) + size;
+    size_t peak = atomic_load(&heap_peak);
+    while (current > peak && !atomic_compare_exchange_weak(&heap_peak, &peak, current))
+    {
+    }
+}
+
+void lv_mem_init(void)
+{
+}
+
+void lv_mem_deinit(void)
+{
+}
+
+lv_mem_pool_t lv_mem_add_pool(void* mem, size_t bytes)
+{
+    // Not supported, the C library owns the heap
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    LV_UNUSED(pool);
+}
+
+void* lv_malloc_core(size_t size)
+{
+    void* p = malloc(size);
+    if (p)
+    {
+        atomic_fetch_add(&allocations, 1);
+        atomic_fetch_add(&allocated_bytes, size);
+        add_heap_size(malloc_usable_size(p));
+    }
+    return p;
+}
+
+void* lv_realloc_core(void* p, size_t new_size)
+{
+    size_t old_size = p ? malloc_usable_size(p) : 0;
+    void* new_p = realloc(p, new_size);
+    if (new_p)
+    {
+        atomic_fetch_add(&allocations, 1);
+        atomic_fetch_add(&allocated_bytes, new_size);
+        atomic_fetch_sub(&heap_size, old_size);
+        add_heap_size(malloc_usable_size(new_p));
+    }
+    return new_p;
+}
+
+void lv_free_core(void* p)
+{
+    if (p)
+    {
+        atomic_fetch_add(&frees, 1);
+        atomic_fetch_sub(&heap_size, malloc_usable_size(p));
+    }
+    free(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t* mon_p)
+{
+    // The heap has no fixed size, so the peak is reported as the total
+    size_t used = atomic_load(&heap_size);
+    size_t peak = atomic_load(&heap_peak);
+    mon_p->total_size = peak;
+    mon_p->free_size = peak - used;
+    mon_p->free_biggest_size = peak - used;
+    mon_p->used_cnt = atomic_load(&allocations) - atomic_load(&frees);
+    mon_p->max_used = peak;
+    mon_p->used_pct = peak ? (uint8_t)(used * 100 / peak) : 0;
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    return LV_RESULT_OK;
+}
+
+void get_allocation_stats(allocation_stats_t* stats)
+{
+    stats->allocations = atomic_load(&allocations);
+    stats->frees = atomic_load(&frees);
+    stats->allocated_bytes = atomic_load(&allocated_bytes);
+    stats->heap_size = atomic_load(&heap_size);
+    stats->heap_peak = atomic_load(&heap_peak);
+}
+
+void reset_allocation_stats(void)
+{
+    atomic_store(&allocations, 0);
+    atomic_store(&frees, 0);
+    atomic_store(&allocated_bytes, 0);
+    atomic_store(&heap_peak, atomic_load(&heap_size));
+}
+
+#endif
@@ -0,0 +1,191 @@
+﻿#include <lvgl/lvgl.h>
+#include <lvgl/src/draw/sw/lv_draw_sw.h>
+#include "render_stats.h"
+#include "schedule_app.h"
+#include "schedule_benchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DISPLAY_WIDTH 800
+#define DISPLAY_HEIGHT 480
+
+// Time the headless build runs for when no duration is given
+#define HEADLESS_DURATION_MS 5000
+
+// Rows of the draw buffer of the headless display in partial and tiled render mode, a tenth of the screen
+#define HEADLESS_BUFFER_ROWS (DISPLAY_HEIGHT / 10)
+
+#if !defined(SCHEDULE_DISPLAY_SDL) && !defined(SCHEDULE_DISPLAY_FBDEV)
+
+// Memory the headless display is flushed to, standing in for a frame buffer device
+static uint8_t frame_memory[DISPLAY_WIDTH * DISPLAY_HEIGHT * 4 + LV_DRAW_BUF_ALIGN];
+static uint8_t* frame_buffer;
+static uint32_t frame_stride;
+static lv_display_render_mode_t headless_render_mode;
+
+static void flush_to_memory(lv_display_t* display, const lv_area_t* area, uint8_t* px_map)
+{
+    // In direct and full mode the draw buffer is the frame buffer, nothing to copy
+    if (headless_render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || headless_render_mode == LV_DISPLAY_RENDER_MODE_TILED)
+    {
+        uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(display));
+        uint32_t row_size = lv_area_get_width(area) * px_size;
+        uint32_t src_stride = lv_draw_buf_width_to_stride(lv_area_get_width(area), lv_display_get_color_format(display));
+        for (int32_t y = area->y1; y <= area->y2; y++)
+        {
+            memcpy(&frame_buffer[y * frame_stride + area->x1 * px_size], px_map, row_size);
+            px_map += src_stride;
+        }
+    }
+    lv_display_flush_ready(display);
+}
+
+/**
+ * Creates a display that renders into memory, without a window or a device.
+ */
+static lv_display_t* create_headless_display(lv_display_render_mode_t render_mode)
+{
+    lv_display_t* display = lv_display_create(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    if (!display) return NULL;
+
+    lv_color_format_t color_format = lv_display_get_color_format(display);
+    frame_buffer = lv_draw_buf_align(frame_memory, color_format);
+    frame_stride = lv_draw_buf_width_to_stride(DISPLAY_WIDTH, color_format);
+    headless_render_mode = render_mode;
+    if (render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL || render_mode == LV_DISPLAY_RENDER_MODE_TILED)
+    {
+        static uint8_t draw_buffer[DISPLAY_WIDTH * HEADLESS_BUFFER_ROWS * 4 + LV_DRAW_BUF_ALIGN];
+        lv_display_set_buffers(display, lv_draw_buf_align(draw_buffer, color_format), NULL,
+            frame_stride * HEADLESS_BUFFER_ROWS, render_mode);
+    }
+    else
+    {
+        lv_display_set_buffers(display, frame_buffer, NULL, frame_stride * DISPLAY_HEIGHT, render_mode);
+    }
+    lv_display_set_flush_cb(display, flush_to_memory);
+    return display;
+}
+
+#endif
+
+static uint32_t get_tick_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+static void print_usage(const char* program)
+{
+    printf("Usage: %s [--duration MS] [--mode partial|direct|full|tiled] [--benchmarks]\n", program);
+    printf("  --duration MS  stop after MS milliseconds and print the render statistics (headless default: %d)\n",
+        HEADLESS_DURATION_MS);
+    printf("  --mode         render mode of the headless display (default: partial)\n");
+    printf("  --benchmarks   run the schedule benchmarks once the screen is built\n");
+}
+
+int main(int argc, char** argv)
+{
+#if defined(SCHEDULE_DISPLAY_SDL) || defined(SCHEDULE_DISPLAY_FBDEV)
+    uint32_t duration_ms = 0; // Run until stopped
+#else
+    uint32_t duration_ms = HEADLESS_DURATION_MS;
+#endif
+    lv_display_render_mode_t render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    int benchmarks = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+        {
+            duration_ms = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc)
+        {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "partial") == 0) render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+            else if (strcmp(mode, "direct") == 0) render_mode = LV_DISPLAY_RENDER_MODE_DIRECT;
+            else if (strcmp(mode, "full") == 0) render_mode = LV_DISPLAY_RENDER_MODE_FULL;
+            else if (strcmp(mode, "tiled") == 0) render_mode = LV_DISPLAY_RENDER_MODE_TILED;
+            else
+            {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--benchmarks") == 0)
+        {
+            benchmarks = 1;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    lv_init();
+    lv_tick_set_cb(get_tick_ms);
+
+#if defined(SCHEDULE_DISPLAY_SDL)
+    LV_UNUSED(render_mode);
+    lv_display_t* display = lv_sdl_window_create(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    if (!display)
+    {
+        return 1;
+    }
+    lv_sdl_mouse_create();
+#elif defined(SCHEDULE_DISPLAY_FBDEV)
+    LV_UNUSED(render_mode);
+    const char* device = getenv("LV_LINUX_FBDEV_DEVICE");
+    lv_display_t* display = lv_linux_fbdev_create();
+    if (!display)
+    {
+        return 1;
+    }
+    lv_linux_fbdev_set_file(display, device ? device : "/dev/fb0");
+#else
+    lv_display_t* display = create_headless_display(render_mode);
+    if (!display)
+    {
+        return 1;
+    }
+#endif
+
+    // One rendering thread and screen tile per core, more would only take turns on the same cores
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    lv_draw_sw_set_thread_cnt(cores > 0 ? (uint32_t)cores : 1);
+    lv_display_set_tile_cnt(display, lv_draw_sw_get_thread_cnt());
+
+    init_render_stats(display);
+    init_schedule_app();
+    // Fail the CTest run if an instruction set draws differently
+    bool benchmarks_passed = true;
+    if (benchmarks)
+    {
+        benchmarks_passed = run_schedule_benchmarks();
+    }
+
+    uint32_t start = lv_tick_get();
+    while (1)
+    {
+        uint32_t elapsed = lv_tick_elaps(start);
+        if (duration_ms != 0 && elapsed >= duration_ms)
+        {
+            break;
+        }
+
+        uint32_t time_till_next = lv_timer_handler();
+        if (duration_ms != 0 && time_till_next > duration_ms - elapsed)
+        {
+            time_till_next = duration_ms - elapsed;
+        }
+        lv_delay_ms(time_till_next);
+    }
+
+    print_render_stats();
+    return benchmarks_passed ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+﻿#include "render_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Frame durations kept for the percentile, the oldest are overwritten
+#define FRAME_TIME_SAMPLES 4096
+
+static uint64_t frame_start_us;
+static int frame_rendered;              // Something was drawn since the refresh started
+static uint32_t frames;
+static uint64_t frame_time_total_us;
+static uint32_t frame_time_max_us;
+static uint32_t frame_times[FRAME_TIME_SAMPLES];
+static uint32_t flushes;
+static uint64_t flushed_pixels;
+
+static uint64_t get_time_us(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+static void start_frame(lv_event_t* e)
+{
+    LV_UNUSED(e);
+    frame_start_us = get_time_us();
+    frame_rendered = 0;
+}
+
+static void start_render(lv_event_t* e)
+{
+    LV_UNUSED(e);
+    frame_rendered = 1;
+}
+
+static void finish_frame(lv_event_t* e)
+{
+    LV_UNUSED(e);
+    // Refreshes with nothing to redraw are not frames
+    if (!frame_rendered) return;
+
+    uint32_t time_us = (uint32_t)(get_time_us() - frame_start_us);
+    frame_times[frames % FRAME_TIME_SAMPLES] = time_us;
+    frames++;
+    frame_time_total_us += time_us;
+    if (time_us > frame_time_max_us) frame_time_max_us = time_us;
+}
+
+static void count_flush(lv_event_t* e)
+{
+    const lv_area_t* area = lv_event_get_param(e);
+    flushes++;
+    flushed_pixels += lv_area_get_size(area);
+}
+
+static int compare_times(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void init_render_stats(lv_display_t* display)
+{
+    lv_display_add_event_cb(display, start_frame, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(display, start_render, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(display, finish_frame, LV_EVENT_REFR_READY, NULL);
+    lv_display_add_event_cb(display, count_flush, LV_EVENT_FLUSH_START, NULL);
+    reset_render_stats();
+}
+
+void reset_render_stats(void)
+{
+    frames = 0;
+    frame_time_total_us = 0;
+    frame_time_max_us = 0;
+    flushes = 0;
+    flushed_pixels = 0;
+    reset_allocation_stats();
+}
+
+void get_render_stats(render_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->frames = frames;
+    stats->flushes = flushes;
+    stats->flushed_pixels = flushed_pixels;
+    if (frames)
+    {
+        uint32_t count = frames < FRAME_TIME_SAMPLES ? frames : FRAME_TIME_SAMPLES;
+        static uint32_t sorted[FRAME_TIME_SAMPLES];
+        memcpy(sorted, frame_times, sizeof(uint32_t) * count);
+        qsort(sorted, count, sizeof(uint32_t), compare_times);
+        stats->frame_time_avg_us = (uint32_t)(frame_time_total_us / frames);
+        stats->frame_time_p95_us = sorted[(count - 1) * 95 / 100];
+        stats->frame_time_max_us = frame_time_max_us;
+    }
+
+    allocation_stats_t allocation_stats;
+    get_allocation_stats(&allocation_stats);
+    stats->allocations = allocation_stats.allocations;
+    stats->frees = allocation_stats.frees;
+    stats->allocated_bytes = allocation_stats.allocated_bytes;
+    stats->heap_size = allocation_stats.heap_size;
+    stats->heap_peak = allocation_stats.heap_peak;
+}
+
+void print_render_stats(void)
+{
+    render_stats_t stats;
+    get_render_stats(&stats);
+
+    printf("render: %u frames, %u us/frame (p95 %u, max %u)\n",
+        (unsigned)stats.frames, (unsigned)stats.frame_time_avg_us,
+        (unsigned)stats.frame_time_p95_us, (unsigned)stats.frame_time_max_us);
+    printf("  %u flushes, %llu px flushed (%.0f px/frame)\n",
+        (unsigned)stats.flushes, (unsigned long long)stats.flushed_pixels,
+        stats.frames ? (double)stats.flushed_pixels / stats.frames : 0.0);
+    printf("memory: %u allocations (%llu bytes), %u frees, %zu bytes in use, %zu at peak\n",
+        (unsigned)stats.allocations, (unsigned long long)stats.allocated_bytes, (unsigned)stats.frees,
+        stats.heap_size, stats.heap_peak);
+}
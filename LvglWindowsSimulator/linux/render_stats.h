@@ -0,0 +1,70 @@
+﻿#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <lvgl/lvgl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Render and memory counters of the Linux build, collected since init_render_stats() or reset_render_stats().
+ */
+typedef struct {
+    uint32_t frames;                /** Display refreshes that redrew something */
+    uint32_t frame_time_avg_us;     /** Average duration of a frame, from the start of the refresh to the last flush */
+    uint32_t frame_time_p95_us;     /** 95th percentile of the frame durations */
+    uint32_t frame_time_max_us;     /** Longest frame */
+    uint32_t flushes;               /** Areas passed to the flush callback */
+    uint64_t flushed_pixels;        /** Pixels passed to the flush callback */
+    uint32_t allocations;           /** Successful lv_malloc() and lv_realloc() calls */
+    uint32_t frees;                 /** Blocks released by lv_free() */
+    uint64_t allocated_bytes;       /** Bytes requested by the counted allocations */
+    size_t heap_size;               /** Bytes currently allocated through lv_malloc() */
+    size_t heap_peak;               /** Most bytes allocated at once */
+} render_stats_t;
+
+/**
+ * Allocation counters kept by the lv_malloc() implementation of the Linux build.
+ */
+typedef struct {
+    uint32_t allocations;           /** Successful lv_malloc() and lv_realloc() calls */
+    uint32_t frees;                 /** Blocks released by lv_free() */
+    uint64_t allocated_bytes;       /** Bytes requested by the counted allocations */
+    size_t heap_size;               /** Bytes currently allocated, as reported by the C library */
+    size_t heap_peak;               /** Most bytes allocated at once */
+} allocation_stats_t;
+
+/**
+ * Starts recording the frame times and flushed areas of a display.
+ * @param display  The display to watch.
+ */
+void init_render_stats(lv_display_t* display);
+
+/**
+ * Clears all counters, e.g. to leave the startup out of a measurement.
+ * The peak heap size starts again from the current heap size.
+ */
+void reset_render_stats(void);
+
+/**
+ * Gets the counters collected so far.
+ * @param stats  Receives the counters.
+ */
+void get_render_stats(render_stats_t* stats);
+
+/**
+ * Prints the counters collected so far to the console.
+ */
+void print_render_stats(void);
+
+/**
+ * Gets the allocation counters.
+ * @param stats  Receives the counters.
+ */
+void get_allocation_stats(allocation_stats_t* stats);
+
+/**
+ * Clears the allocation counters. The peak heap size starts again from the current heap size.
+ */
+void reset_allocation_stats(void);
+
+#endif
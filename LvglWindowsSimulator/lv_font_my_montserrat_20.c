@@ -2703,7 +2703,7 @@ lv_font_t lv_font_my_montserrat_20 = {
 #endif
     .dsc = &font_dsc,          /*The custom font data. Will be accessed by `get_glyph_bitmap/dsc` */
 #if LV_VERSION_CHECK(8, 2, 0) || LVGL_VERSION_MAJOR >= 9
-    .fallback = &lv_font_my_montserrat_20,
+    .fallback = NULL,
 #endif
     .user_data = NULL,
 };
@@ -1,23 +1,7 @@
 ﻿#include <LvglWindowsIconResource.h>
 #include <lvgl/lvgl.h>
-#include "schedule_ui.h"
-#include "time_date_display.h"
-#include <time.h>
-
-static lv_timer_t* minute_timer;
-
-static void minute_tick(lv_timer_t* timer)
-{
-    (void)timer;
-
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
-    if (t->tm_sec == 0) // Trigger only when seconds are 0
-    {
-        update_time_and_date_display();
-        update_progress_bar();
-    }
-}
+#include <lvgl/src/draw/sw/lv_draw_sw.h>
+#include "schedule_app.h"
 
 int main()
 {
@@ -47,6 +31,12 @@ int main()
         return -1;
     }
 
+    // One rendering thread and screen tile per core, more would only take turns on the same cores
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    lv_draw_sw_set_thread_cnt(system_info.dwNumberOfProcessors);
+    lv_display_set_tile_cnt(display, lv_draw_sw_get_thread_cnt());
+
     HWND window_handle = lv_windows_get_display_window_handle(display);
     if (!window_handle)
     {
@@ -88,12 +78,7 @@ int main()
         return -1;
     }
 
-    // Initialize UI components
-    init_time_and_date_display();
-    init_schedule_ui();
-
-    // Create minute timer (check every second for minute change)
-    minute_timer = lv_timer_create(minute_tick, 1000, NULL);
+    init_schedule_app();
 
     while (1)
     {
@@ -0,0 +1,68 @@
+﻿#include "schedule_app.h"
+#include "schedule_ui.h"
+#include "schedule_benchmark.h"
+#include "schedule_file.h"
+#include "schedule_watcher.h"
+#include "time_date_display.h"
+#include <lvgl/lvgl.h>
+#include <time.h>
+
+// Delay after a minute boundary before the clock is read, so it already shows the new minute
+#define MINUTE_TICK_SLACK_MS 20
+
+static lv_timer_t* minute_timer;
+static schedule_watcher_t* schedule_watcher;
+
+/**
+ * Gets the time left until the next wall-clock minute boundary.
+ * Lessons start and end on whole minutes, so this is also the earliest possible lesson start or end.
+ */
+static uint32_t get_ms_to_next_minute(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    struct tm* t = localtime(&now.tv_sec);
+    int seconds = t->tm_sec < 60 ? t->tm_sec : 59; // Leap second
+    return (uint32_t)((60 - seconds) * 1000 - now.tv_nsec / 1000000) + MINUTE_TICK_SLACK_MS;
+}
+
+static void minute_tick(lv_timer_t* timer)
+{
+    // Pick up new timetables without a wake-up of their own
+    if (schedule_watcher)
+    {
+        poll_schedule_watcher(schedule_watcher);
+    }
+
+    update_time_and_date_display();
+    update_progress_bar();
+
+    // Sleep until the next minute boundary. If the loop stalls past it, the timer is overdue and
+    // fires as soon as the loop runs again, so a minute is never skipped.
+    lv_timer_set_period(timer, get_ms_to_next_minute());
+    lv_timer_reset(timer);
+}
+
+void init_schedule_app(void)
+{
+    // Use the schedule file if there is one, the built-in timetable otherwise
+    schedule_t* schedule = load_schedule_file(SCHEDULE_FILE_PATH);
+    if (schedule)
+    {
+        set_active_schedule(schedule);
+    }
+
+    // Initialize UI components
+    init_time_and_date_display();
+    init_schedule_ui();
+
+#if SCHEDULE_RUN_BENCHMARKS
+    run_schedule_benchmarks();
+#endif
+
+    // Pick up new timetables without restarting
+    schedule_watcher = create_schedule_watcher(SCHEDULE_FILE_PATH, reload_schedule_display);
+
+    // Create minute timer, armed for the next minute boundary
+    minute_timer = lv_timer_create(minute_tick, get_ms_to_next_minute(), NULL);
+}
@@ -0,0 +1,12 @@
+﻿#ifndef SCHEDULE_APP_H
+#define SCHEDULE_APP_H
+
+/**
+ * Builds the schedule screen on the default display and starts its timers.
+ * Opens the schedule file (or falls back to the built-in timetable), creates the clock and the lesson list,
+ * watches the schedule file for new versions and refreshes the clock and the progress bars every minute.
+ * @note Must be called after lvgl initialization and the creation of the display.
+ */
+void init_schedule_app(void);
+
+#endif
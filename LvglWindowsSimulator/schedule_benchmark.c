@@ -0,0 +1,1732 @@
+﻿#include "schedule_benchmark.h"
+#include "schedule_ui.h"
+#include "schedule_data.h"
+#include "schedule_file.h"
+#include <lvgl/lvgl.h>
+#include <lvgl/src/lvgl_private.h>
+#include <lvgl/src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h>
+#include <lvgl/src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h>
+#include <lvgl/src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCHMARK_UPDATE_COUNT 100
+
+#define BENCHMARK_ROOM_COUNT 200
+#define BENCHMARK_SUBJECT_COUNT 120
+#define BENCHMARK_TEACHER_COUNT 150
+#define BENCHMARK_LOOKUP_COUNT 1000000
+#define BENCHMARK_STYLE_LOOKUP_COUNT 100000
+#define BENCHMARK_SCROLL_LESSON_COUNT 1000
+#define BENCHMARK_SCROLL_STEP 40
+#define BENCHMARK_TEXT_LINE_COUNT 24
+#define BENCHMARK_TEXT_LAYOUT_COUNT 100
+#define BENCHMARK_TEXT_ROUNDS 10
+#define BENCHMARK_TEXT_WIDTH 630
+#define BENCHMARK_TEXT_SIZE (BENCHMARK_TEXT_LINE_COUNT * 160)
+#define BENCHMARK_ANIM_COUNT 150
+#define BENCHMARK_ANIM_SIZE 12
+#define BENCHMARK_ANIM_FRAMES 40
+#define BENCHMARK_ANIM_ROUNDS 5
+#define BENCHMARK_COVER_SPOT_ROWS 4
+#define BENCHMARK_COVER_FRAMES 50
+#define BENCHMARK_COVER_ROUNDS 5
+#define BENCHMARK_TASK_CELL_W 40
+#define BENCHMARK_TASK_CELL_H 24
+#define BENCHMARK_TASK_FRAMES 20
+#define BENCHMARK_TASK_ROUNDS 5
+#define BENCHMARK_DISPATCH_THREADS 4
+#define BENCHMARK_DISPATCH_UNIT_ID 100
+#define BENCHMARK_THREAD_MAX 8
+#define BENCHMARK_THREAD_FRAMES 10
+#define BENCHMARK_THREAD_ROUNDS 3
+#define BENCHMARK_BLEND_W 800
+#define BENCHMARK_BLEND_H 60
+#define BENCHMARK_BLEND_COUNT 20
+#define BENCHMARK_BLEND_ROUNDS 5
+#define BENCHMARK_TRANSFORM_W 160
+#define BENCHMARK_TRANSFORM_H 120
+#define BENCHMARK_TRANSFORM_COUNT 10
+#define BENCHMARK_TRANSFORM_ROUNDS 3
+#define BENCHMARK_SHADOW_CARDS 12
+#define BENCHMARK_SHADOW_FRAMES 20
+#define BENCHMARK_SHADOW_ROUNDS 3
+#define BENCHMARK_GRAD_BARS 64
+#define BENCHMARK_GRAD_FRAMES 20
+#define BENCHMARK_GRAD_ROUNDS 5
+#define BENCHMARK_CIRCLE_RADII 48
+#define BENCHMARK_CIRCLE_MASKS 20000
+#define BENCHMARK_CIRCLE_THREADS 4
+#define BENCHMARK_CIRCLE_ROUNDS 3
+
+static const char* benchmark_types[] = {
+    "Лекции", "Практические занятия и семинары", "Лабораторные занятия", "Консультация к промежуточной аттестации"
+};
+
+// Lesson type names in the order the display used to scan them, to compare against the resolved types
+static const char* scanned_type_names[] = {
+    "Зачет", "Экзамен", "Дифференцированный зачет", "Консультация к промежуточной аттестации", "-",
+    "Курсовая работа", "Лекции", "Практические занятия и семинары", "Лабораторные занятия", NULL
+};
+
+// Widgets in a single lesson block: the block itself, the bar, five labels and the dashed line
+#define OBJECTS_PER_LESSON_BLOCK 8
+
+static double elapsed_us(clock_t start)
+{
+    return (double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+}
+
+// clock() counts the CPU time of every thread on some platforms, and the real draw threads run meanwhile
+static double elapsed_wall_us(const struct timespec* start)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)(now.tv_sec - start->tv_sec) * 1000000.0 + (double)(now.tv_nsec - start->tv_nsec) / 1000.0;
+}
+
+static void benchmark_schedule_update(void)
+{
+    time_t now = time(NULL);
+    struct tm date = *localtime(&now);
+
+    uint32_t objects_created = 0;
+    uint32_t objects_deleted = 0;
+    uint32_t properties_updated = 0;
+    uint32_t rows = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < BENCHMARK_UPDATE_COUNT; i++)
+    {
+        // Walk through consecutive days, as the date switcher would
+        date.tm_mday++;
+        mktime(&date);
+        update_schedule_display(&date);
+        lv_refr_now(NULL);
+
+        const schedule_ui_stats_t* stats = get_schedule_ui_stats();
+        objects_created += stats->objects_created;
+        objects_deleted += stats->objects_deleted;
+        properties_updated += stats->properties_updated;
+        rows += stats->rows_reused + stats->objects_created / OBJECTS_PER_LESSON_BLOCK;
+    }
+    double total_us = elapsed_us(start);
+
+    printf("schedule update: %d updates, %.1f us/update (incl. refresh)\n",
+        BENCHMARK_UPDATE_COUNT, total_us / BENCHMARK_UPDATE_COUNT);
+    printf("  objects created %.2f, deleted %.2f, properties changed %.2f per update\n",
+        (double)objects_created / BENCHMARK_UPDATE_COUNT,
+        (double)objects_deleted / BENCHMARK_UPDATE_COUNT,
+        (double)properties_updated / BENCHMARK_UPDATE_COUNT);
+    printf("  full rebuild would create and delete %.2f objects per update\n",
+        (double)rows * OBJECTS_PER_LESSON_BLOCK / BENCHMARK_UPDATE_COUNT);
+
+    now = time(NULL);
+    update_schedule_display(localtime(&now));
+}
+
+static uint32_t next_random(uint32_t* state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+/**
+ * Builds a full academic year (September 2025 to June 2026, Monday to Saturday) for every room.
+ */
+static schedule_t* create_year_schedule(void)
+{
+    static char subjects[BENCHMARK_SUBJECT_COUNT][48];
+    static char teachers[BENCHMARK_TEACHER_COUNT][48];
+    static char rooms[BENCHMARK_ROOM_COUNT][16];
+    for (int i = 0; i < BENCHMARK_SUBJECT_COUNT; i++) snprintf(subjects[i], sizeof(subjects[i]), "Дисциплина %d", i);
+    for (int i = 0; i < BENCHMARK_TEACHER_COUNT; i++) snprintf(teachers[i], sizeof(teachers[i]), "Преподаватель %d", i);
+    for (int i = 0; i < BENCHMARK_ROOM_COUNT; i++) snprintf(rooms[i], sizeof(rooms[i]), "%d", 100 + i);
+
+    int max_entries = BENCHMARK_ROOM_COUNT * 304 * 6;
+    schedule_entry_t* entries = lv_malloc(sizeof(schedule_entry_t) * max_entries);
+    if (!entries) return NULL;
+
+    uint32_t random = 1;
+    int count = 0;
+    for (int room = 0; room < BENCHMARK_ROOM_COUNT; room++)
+    {
+        struct tm date = { 0 };
+        date.tm_year = 2025 - 1900;
+        date.tm_mon = 8;
+        date.tm_mday = 1;
+        date.tm_isdst = -1;
+        for (mktime(&date); date.tm_year == 2025 - 1900 || date.tm_mon < 6; date.tm_mday++, mktime(&date))
+        {
+            if (date.tm_wday == 0) continue;
+
+            int lessons = 2 + next_random(&random) % 5;
+            for (int i = 0; i < lessons && count < max_entries; i++)
+            {
+                schedule_entry_t* entry = &entries[count++];
+                entry->room = rooms[room];
+                entry->year = date.tm_year + 1900;
+                entry->month = date.tm_mon + 1;
+                entry->day = date.tm_mday;
+                entry->type = benchmark_types[next_random(&random) % (sizeof(benchmark_types) / sizeof(benchmark_types[0]))];
+                entry->subject = subjects[next_random(&random) % BENCHMARK_SUBJECT_COUNT];
+                entry->teacher = teachers[next_random(&random) % BENCHMARK_TEACHER_COUNT];
+                entry->start_hour = 8 + i * 2;
+                entry->start_minute = 0;
+                entry->end_hour = 9 + i * 2;
+                entry->end_minute = 35;
+            }
+        }
+    }
+
+    schedule_t* schedule = create_schedule(entries, count);
+    lv_free(entries);
+    return schedule;
+}
+
+static int scan_type_name(const char* type)
+{
+    int i = 0;
+    while (scanned_type_names[i] != NULL && strcmp(type, scanned_type_names[i]) != 0)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Compares resolving the type of every lesson of a schedule by string scan and by its resolved kind.
+ */
+static void benchmark_lesson_types(const schedule_t* schedule, int first_day)
+{
+    schedule_stats_t stats;
+    get_schedule_stats(schedule, &stats);
+
+    uint32_t scan_known = 0;
+    clock_t start = clock();
+    for (int room = 0; room < stats.room_count; room++)
+    {
+        for (int day = first_day; day < first_day + stats.day_count; day++)
+        {
+            int count;
+            const lesson_t* lessons = get_schedule_lessons(schedule, room, day, &count);
+            for (int i = 0; i < count; i++)
+            {
+                scan_known += scanned_type_names[scan_type_name(get_schedule_string(schedule, lessons[i].type))] != NULL;
+            }
+        }
+    }
+    double scan_us = elapsed_us(start);
+
+    uint32_t types[LESSON_TYPE_COUNT] = { 0 };
+    start = clock();
+    for (int room = 0; room < stats.room_count; room++)
+    {
+        for (int day = first_day; day < first_day + stats.day_count; day++)
+        {
+            int count;
+            const lesson_t* lessons = get_schedule_lessons(schedule, room, day, &count);
+            for (int i = 0; i < count; i++)
+            {
+                types[get_schedule_lesson_type(schedule, &lessons[i])]++;
+            }
+        }
+    }
+    double type_us = elapsed_us(start);
+
+    printf("  lesson types: %.1f ns/lesson by string scan, %.1f ns/lesson resolved (%u and %u known)\n",
+        scan_us * 1000.0 / stats.lesson_count, type_us * 1000.0 / stats.lesson_count,
+        (unsigned)scan_known, (unsigned)(stats.lesson_count - types[LESSON_TYPE_OTHER]));
+}
+
+static void benchmark_schedule_lookup(void)
+{
+    clock_t start = clock();
+    schedule_t* schedule = create_year_schedule();
+    double build_us = elapsed_us(start);
+    if (!schedule) return;
+
+    schedule_stats_t stats;
+    get_schedule_stats(schedule, &stats);
+
+    struct tm first = { 0 };
+    first.tm_year = 2025 - 1900;
+    first.tm_mon = 8;
+    first.tm_mday = 1;
+    int first_day = get_day_number(&first);
+
+    uint32_t random = 1;
+    uint32_t checksum = 0;
+    start = clock();
+    for (int i = 0; i < BENCHMARK_LOOKUP_COUNT; i++)
+    {
+        int room = next_random(&random) % stats.room_count;
+        int day = first_day + next_random(&random) % stats.day_count;
+        int lessons;
+        const lesson_t* lesson = get_schedule_lessons(schedule, room, day, &lessons);
+        checksum += lessons ? lesson[lessons - 1].end_hour : 0;
+    }
+    double lookup_us = elapsed_us(start);
+
+    printf("schedule lookup: %d rooms x %d days, %d lessons, built in %.1f ms\n",
+        stats.room_count, stats.day_count, stats.lesson_count, build_us / 1000.0);
+    printf("  %.1f ns/lookup (checksum %u)\n", lookup_us * 1000.0 / BENCHMARK_LOOKUP_COUNT, (unsigned)checksum);
+    printf("  %u bytes total, %.1f bytes/lesson, %u bytes of interned strings\n",
+        (unsigned)stats.memory_size, (double)stats.memory_size / stats.lesson_count, (unsigned)stats.string_pool_size);
+    benchmark_lesson_types(schedule, first_day);
+
+    delete_schedule(schedule);
+}
+
+static void benchmark_schedule_file(void)
+{
+    static const char* path = "schedule_benchmark.bin";
+
+    schedule_t* schedule = create_year_schedule();
+    if (!schedule) return;
+
+    uint32_t size;
+    const void* image = get_schedule_image(schedule, &size);
+    FILE* file = fopen(path, "wb");
+    int written = file && fwrite(image, 1, size, file) == size;
+    if (file) fclose(file);
+    delete_schedule(schedule);
+    if (!written) return;
+
+    // Open the file and show a day of the last room, as a sign would on startup
+    struct tm date = { 0 };
+    date.tm_year = 2025 - 1900;
+    date.tm_mon = 9;
+    date.tm_mday = 15;
+
+    clock_t start = clock();
+    schedule = map_schedule_file(path);
+    int lessons = 0;
+    if (schedule)
+    {
+        get_schedule_lessons(schedule, get_schedule_room_count(schedule) - 1, get_day_number(&date), &lessons);
+    }
+    double open_us = elapsed_us(start);
+
+    if (schedule)
+    {
+        printf("schedule file: %u bytes mapped and first day looked up in %.1f us (%d lessons)\n",
+            (unsigned)size, open_us, lessons);
+        schedule_stats_t stats;
+        get_schedule_stats(schedule, &stats);
+        printf("  %u bytes of heap besides the mapped image\n", (unsigned)(stats.memory_size - stats.image_size));
+        delete_schedule(schedule);
+    }
+    remove(path);
+}
+
+static void benchmark_progress_ticks(void)
+{
+    time_t now = time(NULL);
+    struct tm date = *localtime(&now);
+    date.tm_hour = 7;
+    date.tm_min = 0;
+    update_schedule_display_at(&date, &date);
+
+    // Replay today from 7:00 minute by minute, as the minute timer would
+    int ticks = 0;
+    uint32_t bars_updated = 0;
+    uint32_t max_bars_updated = 0;
+    uint32_t invalidated_pixels = 0;
+    uint32_t max_invalidated_pixels = 0;
+    for (int minute = 7 * 60; minute < 21 * 60; minute++)
+    {
+        date.tm_hour = minute / 60;
+        date.tm_min = minute % 60;
+        update_progress_bar_at(&date);
+        lv_refr_now(NULL);
+
+        const progress_stats_t* stats = get_progress_stats();
+        ticks++;
+        bars_updated += stats->bars_updated;
+        invalidated_pixels += stats->invalidated_pixels;
+        if (stats->bars_updated > max_bars_updated) max_bars_updated = stats->bars_updated;
+        if (stats->invalidated_pixels > max_invalidated_pixels) max_invalidated_pixels = stats->invalidated_pixels;
+    }
+
+    printf("progress ticks: %d ticks, %d lessons\n", ticks, get_lesson_count_for_date(&date));
+    printf("  bars animated %.2f/tick (max %u), invalidated %.0f px/tick (max %u)\n",
+        (double)bars_updated / ticks, (unsigned)max_bars_updated,
+        (double)invalidated_pixels / ticks, (unsigned)max_invalidated_pixels);
+
+    update_schedule_display(localtime(&now));
+}
+
+/**
+ * Estimates the heap used by a widget and its children: the object itself, its style list,
+ * its local styles with their properties, its special attributes and label texts.
+ */
+static size_t get_object_heap_size(const lv_obj_t* obj)
+{
+    const lv_obj_class_t* class_p = obj->class_p;
+    while (class_p->base_class && class_p->instance_size == 0)
+    {
+        class_p = class_p->base_class;
+    }
+    size_t size = class_p->instance_size;
+
+    size += obj->style_cnt * sizeof(lv_obj_style_t);
+    for (uint32_t i = 0; i < obj->style_cnt; i++)
+    {
+        if (obj->styles[i].is_local)
+        {
+            size += sizeof(lv_style_t) + obj->styles[i].style->prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+        }
+    }
+
+    if (obj->spec_attr)
+    {
+        size += sizeof(lv_obj_spec_attr_t) + obj->spec_attr->child_cnt * sizeof(lv_obj_t*);
+    }
+
+    if (lv_obj_check_type(obj, &lv_label_class))
+    {
+        const lv_label_t* label = (const lv_label_t*)obj;
+        if (label->text && !label->static_txt)
+        {
+            size += strlen(label->text) + 1;
+        }
+    }
+
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++)
+    {
+        size += get_object_heap_size(lv_obj_get_child(obj, i));
+    }
+    return size;
+}
+
+/**
+ * Builds a lesson block the way it was built before the shared styles, with local styles on every widget.
+ */
+static lv_obj_t* create_local_style_block(lv_obj_t* parent, const lv_obj_t* block)
+{
+    lv_obj_t* copy = lv_obj_create(parent);
+    lv_obj_set_size(copy, 630, LV_SIZE_CONTENT);
+    lv_obj_set_style_border_width(copy, 1, 0);
+    lv_obj_set_style_border_color(copy, lv_color_hex(0x525252), 0);
+    lv_obj_set_style_radius(copy, 0, 0);
+    lv_obj_set_layout(copy, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(copy, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(copy, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    lv_obj_t* progress_bar = lv_bar_create(copy);
+    lv_obj_set_size(progress_bar, 600, 30);
+    lv_bar_set_range(progress_bar, 0, 100);
+    lv_obj_set_style_radius(progress_bar, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(progress_bar, 0, LV_PART_INDICATOR);
+    lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x90EE90), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x228B22), LV_PART_INDICATOR);
+
+    // Time labels, type, subject and teacher, with the texts of the displayed block
+    for (uint32_t i = 2; i < lv_obj_get_child_count(block); i++)
+    {
+        const lv_obj_t* source = lv_obj_get_child(block, i);
+        if (!lv_obj_check_type(source, &lv_label_class))
+        {
+            lv_obj_t* line = lv_line_create(copy);
+            lv_obj_set_style_line_color(line, lv_color_hex(0x000000), 0);
+            lv_obj_set_style_line_width(line, 1, 0);
+            lv_obj_set_style_line_dash_width(line, 2, 0);
+            lv_obj_set_style_line_dash_gap(line, 2, 0);
+            lv_obj_set_width(line, 600);
+            continue;
+        }
+
+        lv_obj_t* label = lv_label_create(copy);
+        lv_label_set_text(label, lv_label_get_text(source));
+        lv_obj_set_style_text_font(label, &lv_font_my_montserrat_20, 0);
+        lv_obj_set_style_text_color(label, lv_color_hex(i == 4 ? 0xffffff : 0x000000), 0);
+        if (i < 4)
+        {
+            lv_obj_set_style_text_align(label, i == 2 ? LV_TEXT_ALIGN_LEFT : LV_TEXT_ALIGN_RIGHT, 0);
+            lv_obj_add_flag(label, LV_OBJ_FLAG_FLOATING);
+            lv_obj_align_to(label, progress_bar, i == 2 ? LV_ALIGN_LEFT_MID : LV_ALIGN_RIGHT_MID, i == 2 ? 5 : -5, -1);
+            continue;
+        }
+
+        lv_obj_set_width(label, 600);
+        if (i == 4)
+        {
+            lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+            lv_obj_set_style_bg_opa(label, LV_OPA_COVER, 0);
+            lv_obj_set_style_pad_all(label, 5, 0);
+            lv_obj_set_style_bg_color(label, lv_obj_get_style_bg_color(source, 0), 0);
+        }
+        else if (i == 5)
+        {
+            lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
+            lv_obj_set_style_pad_top(label, 5, 0);
+            lv_obj_set_style_pad_bottom(label, 10, 0);
+        }
+    }
+    return copy;
+}
+
+/**
+ * Measures a style property lookup on every widget of a lesson block.
+ */
+static double measure_style_lookup_ns(const lv_obj_t* block)
+{
+    uint32_t count = lv_obj_get_child_count(block);
+    uint32_t checksum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < BENCHMARK_STYLE_LOOKUP_COUNT; i++)
+    {
+        const lv_obj_t* obj = lv_obj_get_child(block, i % count);
+        checksum += lv_obj_get_style_pad_bottom(obj, LV_PART_MAIN);
+        checksum += lv_obj_get_style_text_color(obj, LV_PART_MAIN).red;
+    }
+    double total_us = elapsed_us(start);
+    if (checksum == UINT32_MAX) printf("%u\n", (unsigned)checksum); // Keep the lookups from being optimized out
+    return total_us * 1000.0 / BENCHMARK_STYLE_LOOKUP_COUNT;
+}
+
+static void benchmark_lesson_block_styles(void)
+{
+    // Find a day with lessons, starting from today
+    time_t now = time(NULL);
+    struct tm date = *localtime(&now);
+    for (int i = 0; i < 14 && get_lesson_count_for_date(&date) == 0; i++)
+    {
+        date.tm_mday++;
+        mktime(&date);
+    }
+    update_schedule_display(&date);
+    lv_obj_t* block = get_lesson_block(0);
+    if (!block)
+    {
+        printf("lesson block styles: no lessons to display\n");
+        return;
+    }
+
+    lv_obj_t* local_block = create_local_style_block(lv_obj_get_parent(block), block);
+    lv_obj_update_layout(local_block);
+
+    printf("lesson block styles: %u widgets per block\n", (unsigned)(1 + lv_obj_get_child_count(block)));
+    printf("  local styles:  %u bytes of heap per block, %.1f ns per style lookup\n",
+        (unsigned)get_object_heap_size(local_block), measure_style_lookup_ns(local_block));
+    printf("  shared styles: %u bytes of heap per block, %.1f ns per style lookup\n",
+        (unsigned)get_object_heap_size(block), measure_style_lookup_ns(block));
+
+    lv_obj_delete(local_block);
+    update_schedule_display(localtime(&now));
+}
+
+/**
+ * Counts the neighbouring lesson blocks whose distance differs from the height of the upper one plus the gap,
+ * i.e. blocks placed from a wrong height estimate.
+ */
+static int count_misplaced_blocks(int lesson_count)
+{
+    int misplaced = 0;
+    for (int i = 0; i + 1 < lesson_count; i++)
+    {
+        lv_obj_t* block = get_lesson_block(i);
+        lv_obj_t* next = get_lesson_block(i + 1);
+        if (block && next && lv_obj_get_y(next) - lv_obj_get_y(block) != lv_obj_get_height(block) + 15)
+        {
+            misplaced++;
+        }
+    }
+    return misplaced;
+}
+
+// One day of a single room with a thousand lessons, whose subjects take one to three lines
+static schedule_t* create_long_day_schedule(struct tm* date)
+{
+    static const char* subjects[] = {
+        "Теория оптимизации",
+        "Искусственные интеллект и нейронные сети, практикум по обучению моделей",
+        "Основы компьютерного зрения, обработка изображений и видеопотоков, распознавание объектов и сцен в реальном времени"
+    };
+    schedule_entry_t* entries = lv_malloc(sizeof(schedule_entry_t) * BENCHMARK_SCROLL_LESSON_COUNT);
+    if (!entries) return NULL;
+    for (int i = 0; i < BENCHMARK_SCROLL_LESSON_COUNT; i++)
+    {
+        schedule_entry_t* entry = &entries[i];
+        entry->room = "101";
+        entry->year = 2025;
+        entry->month = 10;
+        entry->day = 15;
+        entry->type = benchmark_types[i % (sizeof(benchmark_types) / sizeof(benchmark_types[0]))];
+        entry->subject = subjects[i % 3];
+        entry->teacher = "Сурина Альфия Адгамовна";
+        entry->start_hour = 8 + i * 14 / BENCHMARK_SCROLL_LESSON_COUNT;
+        entry->start_minute = 0;
+        entry->end_hour = entry->start_hour + 1;
+        entry->end_minute = 0;
+    }
+    schedule_t* schedule = create_schedule(entries, BENCHMARK_SCROLL_LESSON_COUNT);
+    lv_free(entries);
+
+    *date = (struct tm){ 0 };
+    date->tm_year = 2025 - 1900;
+    date->tm_mon = 9;
+    date->tm_mday = 15;
+    date->tm_hour = 12;
+    return schedule;
+}
+
+static void benchmark_list_scroll(void)
+{
+    struct tm date;
+    schedule_t* schedule = create_long_day_schedule(&date);
+    if (!schedule) return;
+
+    schedule_t* previous = set_active_schedule(schedule);
+    clock_t start = clock();
+    update_schedule_display_at(&date, &date);
+    double update_us = elapsed_us(start);
+    lv_obj_t* list = lv_obj_get_parent(get_lesson_block(0));
+    lv_refr_now(NULL);
+    size_t top_heap = get_object_heap_size(list);
+    size_t max_heap = top_heap;
+
+    // Scroll to the end step by step, drawing every frame
+    int frames = 0;
+    int misplaced = 0;
+    double max_frame_us = 0;
+    start = clock();
+    for (;;)
+    {
+        int32_t scroll_y = lv_obj_get_scroll_y(list);
+        lv_obj_scroll_by_bounded(list, 0, -BENCHMARK_SCROLL_STEP, LV_ANIM_OFF);
+        if (lv_obj_get_scroll_y(list) == scroll_y) break;
+
+        clock_t frame_start = clock();
+        lv_refr_now(NULL);
+        double frame_us = elapsed_us(frame_start);
+        if (frame_us > max_frame_us) max_frame_us = frame_us;
+        frames++;
+        if (frames % 100 == 0)
+        {
+            size_t heap = get_object_heap_size(list);
+            if (heap > max_heap) max_heap = heap;
+            misplaced += count_misplaced_blocks(BENCHMARK_SCROLL_LESSON_COUNT);
+        }
+    }
+    double scroll_us = elapsed_us(start);
+    const schedule_ui_stats_t* stats = get_schedule_ui_stats();
+
+    printf("list scroll: %d lessons laid out in %.1f us, %d px scrolled in %d frames\n",
+        BENCHMARK_SCROLL_LESSON_COUNT, update_us, (int)lv_obj_get_scroll_y(list), frames);
+    printf("  %.1f us/frame (max %.1f), %u blocks recycled, %u widgets created, %d misplaced\n",
+        scroll_us / frames, max_frame_us, (unsigned)stats->rows_reused, (unsigned)stats->objects_created, misplaced);
+    printf("  %d lesson blocks, %u bytes of widgets at the top, at most %u while scrolling\n",
+        get_lesson_row_count(), (unsigned)top_heap, (unsigned)max_heap);
+
+    lv_obj_scroll_to_y(list, 0, LV_ANIM_OFF);
+    set_active_schedule(previous);
+    time_t now = time(NULL);
+    update_schedule_display(localtime(&now));
+    delete_schedule(schedule);
+}
+
+// Lines like the ones in the lesson blocks, the same for every run
+static void build_benchmark_text(char* text, size_t size)
+{
+    size_t length = 0;
+    for (int i = 0; i < BENCHMARK_TEXT_LINE_COUNT; i++)
+    {
+        length += snprintf(text + length, size - length, "%s. %s. Преподаватель: Иванова Елена Петровна\n",
+            benchmark_types[i % 4], scanned_type_names[i % 9]);
+    }
+}
+
+/**
+ * Lays out a screen of Russian lesson text in the schedule font, and looks up each of its glyphs.
+ * Build with LV_FONT_FMT_TXT_GLYPH_INDEX 0 to get the numbers without the glyph index.
+ */
+static void benchmark_glyph_lookup(void)
+{
+    static char text[BENCHMARK_TEXT_SIZE];
+    build_benchmark_text(text, sizeof(text));
+
+    const lv_font_t* font = &lv_font_my_montserrat_20;
+    uint32_t glyph_count = lv_text_get_encoded_length(text);
+    uint32_t checksum = 0;
+    lv_point_t size;
+
+    uint32_t cache_hits = lv_font_glyph_cache_get_hit_cnt();
+    uint32_t cache_misses = lv_font_glyph_cache_get_miss_cnt();
+
+    // The first layout also builds the glyph index and fills the glyph cache, if enabled
+    clock_t start = clock();
+    lv_text_get_size(&size, text, font, 0, 0, BENCHMARK_TEXT_WIDTH, LV_TEXT_FLAG_NONE);
+    double first_us = elapsed_us(start);
+
+    // Best of several rounds, a single round is easily disturbed by other processes
+    double layout_us = 0;
+    double lookup_us = 0;
+    for (int round = 0; round < BENCHMARK_TEXT_ROUNDS; round++)
+    {
+        start = clock();
+        for (int i = 0; i < BENCHMARK_TEXT_LAYOUT_COUNT; i++)
+        {
+            lv_text_get_size(&size, text, font, 0, 0, BENCHMARK_TEXT_WIDTH, LV_TEXT_FLAG_NONE);
+            checksum += size.y;
+        }
+        double round_us = elapsed_us(start);
+        if (round == 0 || round_us < layout_us) layout_us = round_us;
+
+        start = clock();
+        for (int i = 0; i < BENCHMARK_TEXT_LAYOUT_COUNT; i++)
+        {
+            uint32_t offset = 0;
+            uint32_t letter = lv_text_encoded_next(text, &offset);
+            while (letter)
+            {
+                uint32_t next = lv_text_encoded_next(text, &offset);
+                if (letter != '\n')
+                {
+                    lv_font_glyph_dsc_t dsc;
+                    lv_font_get_glyph_dsc(font, &dsc, letter, next);
+                    checksum += dsc.adv_w;
+                }
+                letter = next;
+            }
+        }
+        round_us = elapsed_us(start);
+        if (round == 0 || round_us < lookup_us) lookup_us = round_us;
+    }
+    if (checksum == UINT32_MAX) printf("%u\n", (unsigned)checksum); // Keep the work from being optimized out
+    cache_hits = lv_font_glyph_cache_get_hit_cnt() - cache_hits;
+    cache_misses = lv_font_glyph_cache_get_miss_cnt() - cache_misses;
+
+    double glyphs = (double)glyph_count * BENCHMARK_TEXT_LAYOUT_COUNT;
+    printf("glyph lookup: %u glyphs of Russian text in %d px lines, %d px high, glyph index %s, glyph cache %d entries\n",
+        (unsigned)glyph_count, BENCHMARK_TEXT_WIDTH, (int)size.y, LV_FONT_FMT_TXT_GLYPH_INDEX ? "on" : "off",
+        LV_FONT_GLYPH_CACHE_DEF_CNT);
+    printf("  layout %.1f ns/glyph (first %.1f us), glyph descriptor %.1f ns/glyph\n",
+        layout_us * 1000.0 / glyphs, first_us, lookup_us * 1000.0 / glyphs);
+    if (cache_hits + cache_misses > 0)
+    {
+        printf("  glyph cache %.1f%% hits of %u lookups\n",
+            cache_hits * 100.0 / (cache_hits + cache_misses), (unsigned)(cache_hits + cache_misses));
+    }
+}
+
+// Nanoseconds per glyph to get the A8 bitmaps of the letters of a text, as the software renderer does
+static double measure_glyph_bitmaps_ns(const lv_font_t* font, const char* text, lv_draw_buf_t* draw_buf)
+{
+    uint32_t checksum = 0;
+    uint32_t glyph_count = 0;
+    double best_us = 0;
+    for (int round = 0; round < BENCHMARK_TEXT_ROUNDS; round++)
+    {
+        clock_t start = clock();
+        for (int i = 0; i < BENCHMARK_TEXT_LAYOUT_COUNT; i++)
+        {
+            uint32_t offset = 0;
+            uint32_t letter = lv_text_encoded_next(text, &offset);
+            while (letter)
+            {
+                lv_font_glyph_dsc_t dsc;
+                if (lv_font_get_glyph_dsc(font, &dsc, letter, 0) && dsc.box_w > 0 && dsc.box_h > 0)
+                {
+                    lv_draw_buf_t* reshaped = lv_draw_buf_reshape(draw_buf, LV_COLOR_FORMAT_A8, dsc.box_w, dsc.box_h, LV_STRIDE_AUTO);
+                    const lv_draw_buf_t* bitmap = lv_font_get_glyph_bitmap(&dsc, reshaped);
+                    if (bitmap) checksum += bitmap->data[0];
+                    lv_font_glyph_release_draw_data(&dsc);
+                    if (round == 0 && i == 0) glyph_count++;
+                }
+                letter = lv_text_encoded_next(text, &offset);
+            }
+        }
+        double round_us = elapsed_us(start);
+        if (round == 0 || round_us < best_us) best_us = round_us;
+    }
+    if (checksum == UINT32_MAX) printf("%u\n", (unsigned)checksum); // Keep the work from being optimized out
+
+    return best_us * 1000.0 / ((double)glyph_count * BENCHMARK_TEXT_LAYOUT_COUNT);
+}
+
+/*
+ * Unpacking the glyph bitmaps of built-in format fonts, with and without the glyph atlas.
+ * The atlas is emptied first, so the first round fills it.
+ */
+static void benchmark_glyph_bitmaps(void)
+{
+    static char text[BENCHMARK_TEXT_SIZE];
+    build_benchmark_text(text, sizeof(text));
+
+    // Large enough for any glyph of the fonts below
+    lv_draw_buf_t* draw_buf = lv_draw_buf_create(64, 64, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    // The built-in Montserrat fonts have no Cyrillic letters, so give them a Latin text
+    static const char latin_text[] = "Lectures. Practical classes and seminars. Teacher: Elena Ivanova, room 1-305\n";
+    const lv_font_t* fonts[] = { &lv_font_my_montserrat_20, &lv_font_montserrat_14 };
+    const char* font_names[] = { "montserrat 20, 1 bpp", "montserrat 14, 4 bpp" };
+    const char* texts[] = { text, latin_text };
+
+    printf("glyph bitmaps: atlas %u bytes\n", (unsigned)LV_FONT_GLYPH_ATLAS_DEF_SIZE);
+    for (int f = 0; f < 2; f++)
+    {
+        lv_font_glyph_atlas_resize(0, true);
+        double unpack_ns = measure_glyph_bitmaps_ns(fonts[f], texts[f], draw_buf);
+
+        lv_font_glyph_atlas_resize(LV_FONT_GLYPH_ATLAS_DEF_SIZE, true);
+        lv_font_glyph_atlas_drop_all();
+        uint32_t hits = lv_font_glyph_atlas_get_hit_cnt();
+        uint32_t misses = lv_font_glyph_atlas_get_miss_cnt();
+        double atlas_ns = measure_glyph_bitmaps_ns(fonts[f], texts[f], draw_buf);
+        hits = lv_font_glyph_atlas_get_hit_cnt() - hits;
+        misses = lv_font_glyph_atlas_get_miss_cnt() - misses;
+
+        printf("  %s: unpacked %.1f ns/glyph, atlas %.1f ns/glyph (%u misses, %u hits, %u bytes used)\n",
+            font_names[f], unpack_ns, atlas_ns, (unsigned)misses, (unsigned)hits,
+            (unsigned)lv_font_glyph_atlas_get_size());
+    }
+
+    lv_draw_buf_destroy(draw_buf);
+}
+
+typedef struct
+{
+    uint32_t areas;
+    uint32_t pixels;
+} rendered_stats_t;
+
+// Counts the areas which are about to be rendered, after they were joined
+static void count_rendered_area(lv_event_t* e)
+{
+    rendered_stats_t* stats = lv_event_get_user_data(e);
+    lv_display_t* disp = lv_event_get_target(e);
+    for (uint32_t i = 0; i < disp->inv_p; i++)
+    {
+        if (disp->inv_area_joined[i]) continue;
+        stats->areas++;
+        stats->pixels += lv_area_get_size(&disp->inv_areas[i]);
+    }
+}
+
+static void count_invalidation(lv_event_t* e)
+{
+    uint32_t* invalidations = lv_event_get_user_data(e);
+    (*invalidations)++;
+}
+
+// Moves every widget by a pixel each frame, invalidating its old and new area
+static double move_widgets_us(lv_obj_t** widgets, int count, bool whole_screen)
+{
+    clock_t start = clock();
+    for (int frame = 0; frame < BENCHMARK_ANIM_FRAMES; frame++)
+    {
+        // The screen first, as when the invalidated areas used to run out
+        if (whole_screen) lv_obj_invalidate(lv_screen_active());
+        int32_t step = frame % 20 < 10 ? 1 : -1;
+        for (int i = 0; i < count; i++) lv_obj_set_x(widgets[i], lv_obj_get_x(widgets[i]) + step);
+        lv_refr_now(NULL);
+    }
+    return elapsed_us(start) / BENCHMARK_ANIM_FRAMES;
+}
+
+/**
+ * Moves many small widgets at once, like a screen of small simultaneous animations, and compares
+ * the redrawn areas with redrawing the whole screen, which used to happen when there were more than
+ * LV_INV_BUF_SIZE invalidated areas.
+ */
+static void benchmark_small_animations(void)
+{
+    lv_display_t* disp = lv_display_get_default();
+    int32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+
+    lv_obj_t* widgets[BENCHMARK_ANIM_COUNT];
+    uint32_t state = 1;
+    for (int i = 0; i < BENCHMARK_ANIM_COUNT; i++)
+    {
+        widgets[i] = lv_obj_create(lv_layer_top());
+        lv_obj_remove_style_all(widgets[i]);
+        lv_obj_set_style_bg_opa(widgets[i], LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(widgets[i], lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_size(widgets[i], BENCHMARK_ANIM_SIZE, BENCHMARK_ANIM_SIZE);
+        lv_obj_set_pos(widgets[i], next_random(&state) % (hor_res - 2 * BENCHMARK_ANIM_SIZE),
+            next_random(&state) % (ver_res - BENCHMARK_ANIM_SIZE));
+        lv_obj_add_flag(widgets[i], LV_OBJ_FLAG_HIDDEN);
+    }
+
+    if (disp->render_mode == LV_DISPLAY_RENDER_MODE_TILED)
+    {
+        printf("small animations: %d px widgets, tiled render mode, %d px tiles\n", BENCHMARK_ANIM_SIZE, LV_INV_TILE_SIZE);
+    }
+    else
+    {
+        printf("small animations: %d px widgets, buffer of %d areas, %d px tiles\n",
+            BENCHMARK_ANIM_SIZE, LV_INV_BUF_SIZE, LV_INV_TILE_SIZE);
+    }
+
+    rendered_stats_t rendered;
+    uint32_t invalidations;
+    lv_display_add_event_cb(disp, count_rendered_area, LV_EVENT_RENDER_START, &rendered);
+    lv_display_add_event_cb(disp, count_invalidation, LV_EVENT_INVALIDATE_AREA, &invalidations);
+
+    // A few widgets first, then all of them
+    static const int counts[] = { BENCHMARK_ANIM_COUNT / 4, BENCHMARK_ANIM_COUNT };
+    for (int c = 0; c < 2; c++)
+    {
+        for (int i = 0; i < counts[c]; i++) lv_obj_remove_flag(widgets[i], LV_OBJ_FLAG_HIDDEN);
+        lv_refr_now(NULL);
+
+        // Best of several rounds, alternating the two, as a single round is easily disturbed
+        double areas_us = 0;
+        double screen_us = 0;
+        rendered_stats_t areas_rendered;
+        uint32_t area_invalidations;
+        for (int round = 0; round < BENCHMARK_ANIM_ROUNDS; round++)
+        {
+            rendered = (rendered_stats_t){ 0 };
+            invalidations = 0;
+            double round_us = move_widgets_us(widgets, counts[c], false);
+            if (round == 0 || round_us < areas_us) areas_us = round_us;
+            areas_rendered = rendered;
+            area_invalidations = invalidations;
+
+            rendered = (rendered_stats_t){ 0 };
+            round_us = move_widgets_us(widgets, counts[c], true);
+            if (round == 0 || round_us < screen_us) screen_us = round_us;
+        }
+
+        printf("  %d widgets, %.0f invalidations/frame: %.1f areas, %.0f px in %.1f us/frame, "
+            "whole screen %.0f px in %.1f us/frame\n",
+            counts[c], (double)area_invalidations / BENCHMARK_ANIM_FRAMES,
+            (double)areas_rendered.areas / BENCHMARK_ANIM_FRAMES, (double)areas_rendered.pixels / BENCHMARK_ANIM_FRAMES,
+            areas_us, (double)rendered.pixels / BENCHMARK_ANIM_FRAMES, screen_us);
+    }
+
+    lv_display_remove_event_cb_with_user_data(disp, count_rendered_area, &rendered);
+    lv_display_remove_event_cb_with_user_data(disp, count_invalidation, &invalidations);
+    for (int i = 0; i < BENCHMARK_ANIM_COUNT; i++) lv_obj_delete(widgets[i]);
+    lv_refr_now(NULL);
+}
+
+#if LV_OBJ_COVER_CACHE
+static int reset_cover_cache(lv_obj_t* obj)
+{
+    obj->cover_cache = LV_OBJ_COVER_CACHE_UNKNOWN;
+    int count = 1;
+    uint32_t child_count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < child_count; i++) count += reset_cover_cache(lv_obj_get_child(obj, i));
+    return count;
+}
+
+static void count_cover_check(lv_event_t* e)
+{
+    uint32_t* cover_checks = lv_event_get_user_data(e);
+    (*cover_checks)++;
+}
+
+static void count_cover_checks(lv_obj_t* obj, uint32_t* cover_checks, bool count)
+{
+    if (count) lv_obj_add_event_cb(obj, count_cover_check, LV_EVENT_COVER_CHECK, cover_checks);
+    else lv_obj_remove_event_cb_with_user_data(obj, count_cover_check, cover_checks);
+    uint32_t child_count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < child_count; i++) count_cover_checks(lv_obj_get_child(obj, i), cover_checks, count);
+}
+
+// Redraws small spots, like ticking progress bars and clocks, and times only the redraw
+static double redraw_spots_us(const lv_area_t* spots, int spot_count, bool cached)
+{
+    double total_us = 0;
+    for (int frame = 0; frame < BENCHMARK_COVER_FRAMES; frame++)
+    {
+        for (int i = 0; i < spot_count; i++)
+        {
+            // Without the cache every object is asked again for each area, as it was before the cache
+            if (!cached) reset_cover_cache(lv_screen_active());
+            lv_inv_area(NULL, &spots[i]);
+            clock_t start = clock();
+            lv_refr_now(NULL);
+            total_us += elapsed_us(start);
+        }
+    }
+    return total_us / BENCHMARK_COVER_FRAMES;
+}
+
+/**
+ * Redraws small areas of the long lesson list, where finding the top object of each area walks
+ * down the flex rows of the screen, and compares the cached cover check results with checking
+ * every object again.
+ */
+static void benchmark_cover_check(void)
+{
+    struct tm date;
+    schedule_t* schedule = create_long_day_schedule(&date);
+    if (!schedule) return;
+
+    schedule_t* previous = set_active_schedule(schedule);
+    update_schedule_display_at(&date, &date);
+    lv_refr_now(NULL);
+
+    // A grid of spots over the screen, each redrawn on its own
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+    lv_area_t spots[BENCHMARK_COVER_SPOT_ROWS * BENCHMARK_COVER_SPOT_ROWS];
+    int spot_count = 0;
+    for (int row = 0; row < BENCHMARK_COVER_SPOT_ROWS; row++)
+    {
+        for (int col = 0; col < BENCHMARK_COVER_SPOT_ROWS; col++)
+        {
+            int32_t x = (2 * col + 1) * hor_res / (2 * BENCHMARK_COVER_SPOT_ROWS);
+            int32_t y = (2 * row + 1) * ver_res / (2 * BENCHMARK_COVER_SPOT_ROWS);
+            lv_area_set(&spots[spot_count++], x, y, x + 7, y + 7);
+        }
+    }
+    int object_count = reset_cover_cache(lv_screen_active());
+
+    uint32_t cover_checks = 0;
+    count_cover_checks(lv_screen_active(), &cover_checks, true);
+    double cached_us = 0;
+    double uncached_us = 0;
+    uint32_t cached_checks = 0;
+    uint32_t uncached_checks = 0;
+    for (int round = 0; round < BENCHMARK_COVER_ROUNDS; round++)
+    {
+        cover_checks = 0;
+        double round_us = redraw_spots_us(spots, spot_count, true);
+        if (round == 0 || round_us < cached_us) cached_us = round_us;
+        cached_checks = cover_checks;
+
+        cover_checks = 0;
+        round_us = redraw_spots_us(spots, spot_count, false);
+        if (round == 0 || round_us < uncached_us) uncached_us = round_us;
+        uncached_checks = cover_checks;
+    }
+    count_cover_checks(lv_screen_active(), &cover_checks, false);
+
+    printf("cover check: %d objects on the screen, %d spots redrawn per frame\n", object_count, spot_count);
+    printf("  cached %.1f events, %.1f us/frame, checking every object %.1f events, %.1f us/frame\n",
+        (double)cached_checks / BENCHMARK_COVER_FRAMES, cached_us,
+        (double)uncached_checks / BENCHMARK_COVER_FRAMES, uncached_us);
+
+    set_active_schedule(previous);
+    time_t now = time(NULL);
+    update_schedule_display(localtime(&now));
+    delete_schedule(schedule);
+}
+#endif
+
+/**
+ * Redraws a screen full of small bordered cells with a label in each, which makes thousands of draw
+ * tasks per frame, and checks that the finished draw tasks are reused instead of allocated again.
+ */
+static void benchmark_draw_tasks(void)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+    int cols = hor_res / BENCHMARK_TASK_CELL_W;
+    int rows = ver_res / BENCHMARK_TASK_CELL_H;
+
+    lv_obj_t* grid = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(grid);
+    lv_obj_set_size(grid, hor_res, ver_res);
+    for (int i = 0; i < cols * rows; i++)
+    {
+        lv_obj_t* cell = lv_obj_create(grid);
+        lv_obj_remove_style_all(cell);
+        lv_obj_set_pos(cell, i % cols * BENCHMARK_TASK_CELL_W, i / cols * BENCHMARK_TASK_CELL_H);
+        lv_obj_set_size(cell, BENCHMARK_TASK_CELL_W, BENCHMARK_TASK_CELL_H);
+        lv_obj_set_style_bg_opa(cell, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(cell, lv_palette_lighten(LV_PALETTE_BLUE, 4), 0);
+        lv_obj_set_style_border_width(cell, 1, 0);
+        lv_obj_set_style_border_color(cell, lv_palette_main(LV_PALETTE_BLUE), 0);
+
+        lv_obj_t* label = lv_label_create(cell);
+        lv_label_set_text_fmt(label, "%d", i % 100);
+        lv_obj_center(label);
+    }
+    lv_refr_now(NULL);
+
+    lv_draw_global_info_t* draw_info = &LV_GLOBAL_DEFAULT()->draw_info;
+    uint32_t pool_first = draw_info->task_pool_cnt;
+    double frame_us = 0;
+    for (int round = 0; round < BENCHMARK_TASK_ROUNDS; round++)
+    {
+        clock_t start = clock();
+        for (int frame = 0; frame < BENCHMARK_TASK_FRAMES; frame++)
+        {
+            lv_obj_invalidate(grid);
+            lv_refr_now(NULL);
+        }
+        double round_us = elapsed_us(start) / BENCHMARK_TASK_FRAMES;
+        if (round == 0 || round_us < frame_us) frame_us = round_us;
+    }
+
+    printf("draw tasks: %d cells with a border and a label, %.1f us/frame\n", cols * rows, frame_us);
+    printf("  %u tasks kept for reuse after the first frame, %d allocated later\n",
+        (unsigned)pool_first, (int)(draw_info->task_pool_cnt - pool_first));
+
+    lv_obj_delete(grid);
+    lv_refr_now(NULL);
+}
+
+static void add_dispatch_task(lv_layer_t* layer, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t area = { x1, y1, x2, y2 };
+    lv_draw_task_t* t = lv_draw_add_task(layer, &area);
+    t->preferred_draw_unit_id = BENCHMARK_DISPATCH_UNIT_ID;
+}
+
+/**
+ * Lets simulated draw threads take the draw tasks of a screen of cells, each with a fill, a border and
+ * a label, as fast as the dependency check allows. Only the dispatching is measured, nothing is drawn.
+ * With shared borders the cells overlap their neighbours like in a table, so most tasks wait for others.
+ */
+static void run_task_dispatch(bool shared_borders)
+{
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+    int cols = hor_res / BENCHMARK_TASK_CELL_W;
+    int rows = ver_res / BENCHMARK_TASK_CELL_H;
+    int32_t inset = shared_borders ? 0 : 1;
+
+    double best_us = 0;
+    int steps = 0;
+    for (int round = 0; round < BENCHMARK_TASK_ROUNDS; round++)
+    {
+        lv_layer_t layer;
+        lv_layer_init(&layer);
+        lv_area_set(&layer.buf_area, 0, 0, hor_res - 1, ver_res - 1);
+        layer._clip_area = layer.buf_area;
+
+        // A task in progress at the head keeps the real draw units away from these tasks
+        lv_area_t guard_area = { -1, -1, -1, -1 };
+        lv_draw_task_t* guard = lv_draw_add_task(&layer, &guard_area);
+        guard->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        for (int i = 0; i < cols * rows; i++)
+        {
+            int32_t x1 = i % cols * BENCHMARK_TASK_CELL_W + inset;
+            int32_t y1 = i / cols * BENCHMARK_TASK_CELL_H + inset;
+            int32_t x2 = x1 + BENCHMARK_TASK_CELL_W - 2 * inset;
+            int32_t y2 = y1 + BENCHMARK_TASK_CELL_H - 2 * inset;
+            add_dispatch_task(&layer, x1, y1, x2, y2);
+            add_dispatch_task(&layer, x1, y1, x2, y2);
+            add_dispatch_task(&layer, x1 + 8, y1 + 4, x2 - 8, y2 - 4);
+        }
+
+        // Each step the threads take what they can and finish it before the next dispatch
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        steps = 0;
+        while (layer.draw_task_head->next)
+        {
+            lv_draw_task_t* taken[BENCHMARK_DISPATCH_THREADS];
+            int taken_count = 0;
+            lv_draw_task_t* t = NULL;
+            while (taken_count < BENCHMARK_DISPATCH_THREADS)
+            {
+                t = lv_draw_get_next_available_task(&layer, t, BENCHMARK_DISPATCH_UNIT_ID);
+                if (!t) break;
+                t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+                taken[taken_count++] = t;
+            }
+            for (int i = 0; i < taken_count; i++) taken[i]->state = LV_DRAW_TASK_STATE_READY;
+            lv_draw_dispatch_layer(NULL, &layer);
+            steps++;
+        }
+        double round_us = elapsed_wall_us(&start);
+        if (round == 0 || round_us < best_us) best_us = round_us;
+
+        guard->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_dispatch_layer(NULL, &layer);
+    }
+
+    printf("task dispatch%s: %d tasks taken by %d simulated draw threads in %d steps, %.1f us\n",
+        shared_borders ? " (shared borders)" : "", cols * rows * 3, BENCHMARK_DISPATCH_THREADS, steps, best_us);
+}
+
+static void benchmark_task_dispatch(void)
+{
+    run_task_dispatch(false);
+    run_task_dispatch(true);
+}
+
+// Average wall time of redrawing the whole screen, the best of a few rounds
+static double redraw_screen_us(void)
+{
+    double frame_us = 0;
+    for (int round = 0; round < BENCHMARK_THREAD_ROUNDS; round++)
+    {
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (int frame = 0; frame < BENCHMARK_THREAD_FRAMES; frame++)
+        {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(NULL);
+        }
+        double round_us = elapsed_wall_us(&start) / BENCHMARK_THREAD_FRAMES;
+        if (round == 0 || round_us < frame_us) frame_us = round_us;
+    }
+    return frame_us;
+}
+
+/**
+ * Redraws the whole screen of a long day with 1 to 8 software rendering threads. Either the screen is
+ * divided into a tile per thread, and the widgets are drawn for each tile, or it's drawn as one tile
+ * and the threads share the large fills and images in bands. The threads past one per core only take
+ * turns, so only the rows up to the display's own thread count can show a speedup.
+ */
+static void benchmark_render_threads(void)
+{
+    struct tm date;
+    schedule_t* schedule = create_long_day_schedule(&date);
+    if (!schedule) return;
+
+    schedule_t* previous = set_active_schedule(schedule);
+    update_schedule_display_at(&date, &date);
+    lv_refr_now(NULL);
+
+    lv_display_t* disp = lv_display_get_default();
+    uint32_t thread_count_original = lv_draw_sw_get_thread_cnt();
+    uint32_t tile_count_original = lv_display_get_tile_cnt(disp);
+    double single_us = 0;
+    printf("render threads: the display uses %u, one per core\n", (unsigned)thread_count_original);
+    for (uint32_t threads = 1; threads <= BENCHMARK_THREAD_MAX; threads++)
+    {
+        // No more threads than LV_DRAW_SW_DRAW_UNIT_CNT
+        lv_draw_sw_set_thread_cnt(threads);
+        if (lv_draw_sw_get_thread_cnt() != threads) break;
+
+        lv_display_set_tile_cnt(disp, threads);
+        double tiles_us = redraw_screen_us();
+        lv_display_set_tile_cnt(disp, 1);
+        double bands_us = redraw_screen_us();
+        if (threads == 1) single_us = tiles_us;
+
+        printf("render threads: %u, full screen in %u tiles %.1f us/frame (%.2fx), in bands %.1f us/frame (%.2fx)\n",
+            (unsigned)threads, (unsigned)threads, tiles_us, single_us / tiles_us, bands_us, single_us / bands_us);
+    }
+    lv_draw_sw_set_thread_cnt(thread_count_original);
+    lv_display_set_tile_cnt(disp, tile_count_original);
+
+    set_active_schedule(previous);
+    time_t now = time(NULL);
+    update_schedule_display(localtime(&now));
+    delete_schedule(schedule);
+}
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+typedef struct
+{
+    const char* name;
+    lv_color_format_t dest_cf;
+    lv_color_format_t src_cf; // LV_COLOR_FORMAT_UNKNOWN to fill with a color
+    lv_opa_t opa;
+    bool masked;
+} blend_case_t;
+
+static const blend_case_t blend_cases[] = {
+    { "fill", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_UNKNOWN, LV_OPA_COVER, false },
+    { "fill with opacity", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_UNKNOWN, LV_OPA_50, false },
+    { "fill with mask", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_UNKNOWN, LV_OPA_COVER, true },
+    { "ARGB8888 image", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888, LV_OPA_COVER, false },
+    { "ARGB8888 image with opacity", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888, LV_OPA_50, false },
+    { "XRGB8888 image with mask", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_XRGB8888, LV_OPA_COVER, true },
+    { "RGB888 image", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_RGB888, LV_OPA_COVER, false },
+    { "RGB888 image with mask", LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_RGB888, LV_OPA_COVER, true },
+    { "fill with mask", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_UNKNOWN, LV_OPA_COVER, true },
+    { "ARGB8888 image", LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_ARGB8888, LV_OPA_COVER, false },
+    { "fill with mask", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_UNKNOWN, LV_OPA_COVER, true },
+    { "ARGB8888 image", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_ARGB8888, LV_OPA_COVER, false },
+    { "RGB565 image with opacity", LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565, LV_OPA_50, false },
+};
+
+static const char* const isa_names[] = { "C", "SSE2", "AVX2" };
+
+static uint8_t blend_dest_buf[BENCHMARK_BLEND_W * BENCHMARK_BLEND_H * 4];
+static uint8_t blend_ref_buf[sizeof(blend_dest_buf)];
+static uint8_t blend_src_buf[BENCHMARK_BLEND_W * BENCHMARK_BLEND_H * 4];
+static lv_opa_t blend_mask_buf[BENCHMARK_BLEND_W * BENCHMARK_BLEND_H];
+
+static void blend_once(const blend_case_t* c)
+{
+    int32_t dest_stride = BENCHMARK_BLEND_W * lv_color_format_get_size(c->dest_cf);
+    if (c->src_cf == LV_COLOR_FORMAT_UNKNOWN)
+    {
+        lv_draw_sw_blend_fill_dsc_t dsc = { 0 };
+        dsc.dest_buf = blend_dest_buf;
+        dsc.dest_w = BENCHMARK_BLEND_W;
+        dsc.dest_h = BENCHMARK_BLEND_H;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = c->masked ? blend_mask_buf : NULL;
+        dsc.mask_stride = BENCHMARK_BLEND_W;
+        dsc.color = lv_palette_main(LV_PALETTE_BLUE);
+        dsc.opa = c->opa;
+        if (c->dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_color_to_argb8888(&dsc);
+        else if (c->dest_cf == LV_COLOR_FORMAT_XRGB8888) lv_draw_sw_blend_color_to_rgb888(&dsc, 4);
+        else lv_draw_sw_blend_color_to_rgb565(&dsc);
+    }
+    else
+    {
+        lv_draw_sw_blend_image_dsc_t dsc = { 0 };
+        dsc.dest_buf = blend_dest_buf;
+        dsc.dest_w = BENCHMARK_BLEND_W;
+        dsc.dest_h = BENCHMARK_BLEND_H;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = c->masked ? blend_mask_buf : NULL;
+        dsc.mask_stride = BENCHMARK_BLEND_W;
+        dsc.src_buf = blend_src_buf;
+        dsc.src_stride = BENCHMARK_BLEND_W * lv_color_format_get_size(c->src_cf);
+        dsc.src_color_format = c->src_cf;
+        dsc.opa = c->opa;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        if (c->dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_image_to_argb8888(&dsc);
+        else if (c->dest_cf == LV_COLOR_FORMAT_XRGB8888) lv_draw_sw_blend_image_to_rgb888(&dsc, 4);
+        else lv_draw_sw_blend_image_to_rgb565(&dsc);
+    }
+}
+
+/**
+ * Blends once with the selected instruction set and compares the pixels with the C implementation's,
+ * so the build that ships verifies the instruction set dispatch, not only the SSE2 test build.
+ * @return false if the pixels differ. The C implementation always passes and stores the reference.
+ */
+static bool check_blend(const blend_case_t* c, lv_blend_sse2_isa_t isa)
+{
+    memset(blend_dest_buf, 0xff, sizeof(blend_dest_buf));
+    blend_once(c);
+    if (isa == LV_BLEND_SSE2_ISA_NONE)
+    {
+        memcpy(blend_ref_buf, blend_dest_buf, sizeof(blend_ref_buf));
+        return true;
+    }
+    return memcmp(blend_ref_buf, blend_dest_buf, sizeof(blend_ref_buf)) == 0;
+}
+
+// Wall time of one blend with the selected instruction set, the best of a few rounds
+static double measure_blend_us(const blend_case_t* c)
+{
+    double blend_us = 0;
+    for (int round = 0; round < BENCHMARK_BLEND_ROUNDS; round++)
+    {
+        // An opaque background, like the screen or a layer with a background
+        memset(blend_dest_buf, 0xff, sizeof(blend_dest_buf));
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (int i = 0; i < BENCHMARK_BLEND_COUNT; i++) blend_once(c);
+        double round_us = elapsed_wall_us(&start) / BENCHMARK_BLEND_COUNT;
+        if (round == 0 || round_us < blend_us) blend_us = round_us;
+    }
+    return blend_us;
+}
+
+/**
+ * Blends colors and images into a screen sized band with the C implementation, SSE2 and AVX2.
+ * The image has transparent, opaque and antialiased parts, like icons, and the mask is a ramp, like
+ * the edges of rounded rectangles.
+ * @return false if SSE2 or AVX2 blended other pixels than the C implementation
+ */
+static bool benchmark_blend(void)
+{
+    bool passed = true;
+    uint32_t* src = (uint32_t*)blend_src_buf;
+    for (int i = 0; i < BENCHMARK_BLEND_W * BENCHMARK_BLEND_H; i++)
+    {
+        int x = i % BENCHMARK_BLEND_W;
+        uint32_t alpha = x % 64 < 16 ? 0 : x % 64 < 48 ? 255 : (x % 16) * 17;
+        src[i] = (alpha << 24) | ((uint32_t)x * 0x010305u & 0xffffff);
+        blend_mask_buf[i] = (lv_opa_t)(x * 7);
+    }
+
+    lv_blend_sse2_isa_t isa_original = lv_blend_sse2_get_isa();
+    for (size_t i = 0; i < sizeof(blend_cases) / sizeof(blend_cases[0]); i++)
+    {
+        const blend_case_t* c = &blend_cases[i];
+        const char* dest_name = c->dest_cf == LV_COLOR_FORMAT_ARGB8888 ? "ARGB8888" :
+            c->dest_cf == LV_COLOR_FORMAT_XRGB8888 ? "XRGB8888" : "RGB565";
+        double isa_us[LV_BLEND_SSE2_ISA_AVX2 + 1] = { 0 };
+        for (int isa = LV_BLEND_SSE2_ISA_NONE; isa <= LV_BLEND_SSE2_ISA_AVX2; isa++)
+        {
+            lv_blend_sse2_set_isa((lv_blend_sse2_isa_t)isa);
+            if (lv_blend_sse2_get_isa() != (lv_blend_sse2_isa_t)isa) continue;
+
+            if (!check_blend(c, (lv_blend_sse2_isa_t)isa))
+            {
+                printf("blend %s to %s: %s gives other pixels than C\n", c->name, dest_name, isa_names[isa]);
+                passed = false;
+            }
+            isa_us[isa] = measure_blend_us(c);
+        }
+
+        printf("blend %dx%d, %s to %s: C %.1f us", BENCHMARK_BLEND_W, BENCHMARK_BLEND_H, c->name, dest_name,
+            isa_us[LV_BLEND_SSE2_ISA_NONE]);
+        if (isa_us[LV_BLEND_SSE2_ISA_SSE2] > 0)
+            printf(", SSE2 %.1f us (%.2fx)", isa_us[LV_BLEND_SSE2_ISA_SSE2],
+                isa_us[LV_BLEND_SSE2_ISA_NONE] / isa_us[LV_BLEND_SSE2_ISA_SSE2]);
+        if (isa_us[LV_BLEND_SSE2_ISA_AVX2] > 0)
+            printf(", AVX2 %.1f us (%.2fx)", isa_us[LV_BLEND_SSE2_ISA_AVX2],
+                isa_us[LV_BLEND_SSE2_ISA_NONE] / isa_us[LV_BLEND_SSE2_ISA_AVX2]);
+        printf("\n");
+    }
+    lv_blend_sse2_set_isa(isa_original);
+    return passed;
+}
+
+typedef struct
+{
+    const char* name;
+    int32_t rotation;
+    int32_t scale;
+    bool antialias;
+} transform_case_t;
+
+static const transform_case_t transform_cases[] = {
+    { "zoom 2x", 0, 512, false },
+    { "zoom 1.5x", 0, 384, true },
+    { "rotate 15", 150, LV_SCALE_NONE, true },
+    { "rotate 45", 450, LV_SCALE_NONE, true },
+    { "rotate 90", 900, LV_SCALE_NONE, false },
+    { "rotate 30 and zoom 0.75x", 300, 192, true },
+};
+
+static const lv_color_format_t transform_formats[] = {
+    LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_RGB565A8,
+};
+
+static uint8_t transform_src_buf[BENCHMARK_TRANSFORM_W * BENCHMARK_TRANSFORM_H * 4];
+// Large enough for the image zoomed by 2 and rotated by 45 degrees, with an alpha map
+static uint8_t transform_dest_buf[BENCHMARK_TRANSFORM_W * BENCHMARK_TRANSFORM_W * 4 * 5];
+static uint8_t transform_ref_buf[sizeof(transform_dest_buf)];
+
+/**
+ * Transforms once with the selected instruction set and compares the pixels with the C implementation's.
+ * @return false if the pixels differ. The C implementation always passes and stores the reference.
+ */
+static bool check_transform(const lv_draw_image_dsc_t* dsc, const lv_area_t* area, lv_color_format_t cf,
+    lv_blend_sse2_isa_t isa)
+{
+    uint32_t stride = BENCHMARK_TRANSFORM_W * lv_color_format_get_size(cf);
+    memset(transform_dest_buf, 0, sizeof(transform_dest_buf));
+    lv_draw_sw_transform(area, transform_src_buf, BENCHMARK_TRANSFORM_W, BENCHMARK_TRANSFORM_H, stride, dsc,
+        NULL, cf, transform_dest_buf);
+    if (isa == LV_BLEND_SSE2_ISA_NONE)
+    {
+        memcpy(transform_ref_buf, transform_dest_buf, sizeof(transform_ref_buf));
+        return true;
+    }
+    return memcmp(transform_ref_buf, transform_dest_buf, sizeof(transform_ref_buf)) == 0;
+}
+
+// Wall time of transforming the whole image with the selected instruction set, the best of a few rounds
+static double measure_transform_us(const lv_draw_image_dsc_t* dsc, const lv_area_t* area, lv_color_format_t cf)
+{
+    uint32_t stride = BENCHMARK_TRANSFORM_W * lv_color_format_get_size(cf);
+    double transform_us = 0;
+    for (int round = 0; round < BENCHMARK_TRANSFORM_ROUNDS; round++)
+    {
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (int i = 0; i < BENCHMARK_TRANSFORM_COUNT; i++)
+        {
+            lv_draw_sw_transform(area, transform_src_buf, BENCHMARK_TRANSFORM_W, BENCHMARK_TRANSFORM_H, stride, dsc,
+                NULL, cf, transform_dest_buf);
+        }
+        double round_us = elapsed_wall_us(&start) / BENCHMARK_TRANSFORM_COUNT;
+        if (round == 0 || round_us < transform_us) transform_us = round_us;
+    }
+    return transform_us;
+}
+
+/**
+ * Rotates and zooms an image of each color format around its center with the C implementation, SSE2 and
+ * AVX2, like an animated icon or a gauge needle.
+ * @return false if SSE2 or AVX2 gave other pixels than the C implementation
+ */
+static bool benchmark_transform(void)
+{
+    bool passed = true;
+    for (size_t i = 0; i < sizeof(transform_src_buf); i++)
+    {
+        // Gradients with a transparent frame, so the edges are antialiased too
+        int x = (int)(i / 4 % BENCHMARK_TRANSFORM_W);
+        transform_src_buf[i] = i % 4 == 3 && (x < 8 || x >= BENCHMARK_TRANSFORM_W - 8) ? 0 : (uint8_t)(i * 7 / 5);
+    }
+
+    lv_blend_sse2_isa_t isa_original = lv_blend_sse2_get_isa();
+    for (size_t f = 0; f < sizeof(transform_formats) / sizeof(transform_formats[0]); f++)
+    {
+        lv_color_format_t cf = transform_formats[f];
+        const char* cf_name = cf == LV_COLOR_FORMAT_ARGB8888 ? "ARGB8888" : cf == LV_COLOR_FORMAT_XRGB8888 ? "XRGB8888" :
+            cf == LV_COLOR_FORMAT_RGB888 ? "RGB888" : "RGB565A8";
+        for (size_t i = 0; i < sizeof(transform_cases) / sizeof(transform_cases[0]); i++)
+        {
+            const transform_case_t* c = &transform_cases[i];
+            lv_draw_image_dsc_t dsc;
+            lv_draw_image_dsc_init(&dsc);
+            dsc.rotation = c->rotation;
+            dsc.scale_x = c->scale;
+            dsc.scale_y = c->scale;
+            dsc.antialias = c->antialias;
+            dsc.pivot.x = BENCHMARK_TRANSFORM_W / 2;
+            dsc.pivot.y = BENCHMARK_TRANSFORM_H / 2;
+
+            lv_area_t area;
+            lv_image_buf_get_transformed_area(&area, BENCHMARK_TRANSFORM_W, BENCHMARK_TRANSFORM_H, dsc.rotation,
+                dsc.scale_x, dsc.scale_y, &dsc.pivot);
+
+            double isa_us[LV_BLEND_SSE2_ISA_AVX2 + 1] = { 0 };
+            for (int isa = LV_BLEND_SSE2_ISA_NONE; isa <= LV_BLEND_SSE2_ISA_AVX2; isa++)
+            {
+                lv_blend_sse2_set_isa((lv_blend_sse2_isa_t)isa);
+                if (lv_blend_sse2_get_isa() != (lv_blend_sse2_isa_t)isa) continue;
+
+                if (!check_transform(&dsc, &area, cf, (lv_blend_sse2_isa_t)isa))
+                {
+                    printf("transform %s, %s: %s gives other pixels than C\n", cf_name, c->name, isa_names[isa]);
+                    passed = false;
+                }
+                isa_us[isa] = measure_transform_us(&dsc, &area, cf);
+            }
+
+            printf("transform %dx%d %s, %s%s: C %.1f us", BENCHMARK_TRANSFORM_W, BENCHMARK_TRANSFORM_H, cf_name, c->name,
+                c->antialias ? "" : " without antialiasing", isa_us[LV_BLEND_SSE2_ISA_NONE]);
+            if (isa_us[LV_BLEND_SSE2_ISA_SSE2] > 0)
+                printf(", SSE2 %.1f us (%.2fx)", isa_us[LV_BLEND_SSE2_ISA_SSE2],
+                    isa_us[LV_BLEND_SSE2_ISA_NONE] / isa_us[LV_BLEND_SSE2_ISA_SSE2]);
+            if (isa_us[LV_BLEND_SSE2_ISA_AVX2] > 0)
+                printf(", AVX2 %.1f us (%.2fx)", isa_us[LV_BLEND_SSE2_ISA_AVX2],
+                    isa_us[LV_BLEND_SSE2_ISA_NONE] / isa_us[LV_BLEND_SSE2_ISA_AVX2]);
+            printf("\n");
+        }
+    }
+    lv_blend_sse2_set_isa(isa_original);
+    return passed;
+}
+#endif
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+// Average wall time of redrawing the shadow screen, the best of a few rounds
+static double redraw_shadows_us(void)
+{
+    double frame_us = 0;
+    for (int round = 0; round < BENCHMARK_SHADOW_ROUNDS; round++)
+    {
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (int frame = 0; frame < BENCHMARK_SHADOW_FRAMES; frame++)
+        {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(NULL);
+        }
+        double round_us = elapsed_wall_us(&start) / BENCHMARK_SHADOW_FRAMES;
+        if (round == 0 || round_us < frame_us) frame_us = round_us;
+    }
+    return frame_us;
+}
+
+/**
+ * Redraws a screen of cards with two kinds of shadows, large ones on the cards and small ones on their
+ * buttons, without and with the shadow cache.
+ */
+static void benchmark_shadows(void)
+{
+    lv_obj_t* previous = lv_screen_active();
+    lv_obj_t* screen = lv_obj_create(NULL);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(screen, 24, 0);
+    lv_obj_set_style_pad_gap(screen, 24, 0);
+
+    for (int i = 0; i < BENCHMARK_SHADOW_CARDS; i++)
+    {
+        lv_obj_t* card = lv_obj_create(screen);
+        lv_obj_set_size(card, 150 + (i % 3) * 20, 120);
+        lv_obj_set_style_radius(card, 12, 0);
+        lv_obj_set_style_shadow_width(card, 24, 0);
+        lv_obj_set_style_shadow_offset_y(card, 4, 0);
+        lv_obj_set_style_shadow_opa(card, LV_OPA_30, 0);
+
+        lv_obj_t* button = lv_obj_create(card);
+        lv_obj_set_size(button, 80, 32);
+        lv_obj_align(button, LV_ALIGN_BOTTOM_MID, 0, 0);
+        lv_obj_set_style_radius(button, 6, 0);
+        lv_obj_set_style_shadow_width(button, 8, 0);
+        lv_obj_set_style_shadow_spread(button, 1, 0);
+        lv_obj_set_style_shadow_opa(button, LV_OPA_40, 0);
+    }
+    lv_screen_load(screen);
+    lv_refr_now(NULL);
+
+    lv_draw_sw_shadow_cache_resize(0, true);
+    double uncached_us = redraw_shadows_us();
+
+    lv_draw_sw_shadow_cache_resize(LV_DRAW_SW_SHADOW_CACHE_DEF_SIZE, true);
+    lv_refr_now(NULL);
+    uint32_t hits = lv_draw_sw_shadow_cache_get_hit_cnt();
+    uint32_t misses = lv_draw_sw_shadow_cache_get_miss_cnt();
+    double cached_us = redraw_shadows_us();
+    hits = lv_draw_sw_shadow_cache_get_hit_cnt() - hits;
+    misses = lv_draw_sw_shadow_cache_get_miss_cnt() - misses;
+
+    printf("shadows: %d cards and buttons, without cache %.1f us/frame, with cache %.1f us/frame (%.2fx), "
+        "%u%% hits, %u bytes\n", BENCHMARK_SHADOW_CARDS, uncached_us, cached_us, uncached_us / cached_us,
+        hits + misses ? (unsigned)(hits * 100ull / (hits + misses)) : 0u, (unsigned)lv_draw_sw_shadow_cache_get_size());
+
+    lv_screen_load(previous);
+    lv_obj_delete(screen);
+}
+#endif
+
+#if LV_USE_DRAW_SW
+// Average wall time of redrawing the gradient screen, the best of a few rounds
+static double redraw_gradients_us(void)
+{
+    double frame_us = 0;
+    for (int round = 0; round < BENCHMARK_GRAD_ROUNDS; round++)
+    {
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (int frame = 0; frame < BENCHMARK_GRAD_FRAMES; frame++)
+        {
+            lv_obj_invalidate(lv_screen_active());
+            lv_refr_now(NULL);
+        }
+        double round_us = elapsed_wall_us(&start) / BENCHMARK_GRAD_FRAMES;
+        if (round == 0 || round_us < frame_us) frame_us = round_us;
+    }
+    return frame_us;
+}
+
+/**
+ * Redraws a screen of header bars with the same horizontal gradient and of tiles with the same vertical
+ * gradient, without and with the gradient cache.
+ */
+static void benchmark_gradients(void)
+{
+    lv_obj_t* previous = lv_screen_active();
+    lv_obj_t* screen = lv_obj_create(NULL);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(screen, 0, 0);
+    lv_obj_set_style_pad_gap(screen, 4, 0);
+
+    for (int i = 0; i < BENCHMARK_GRAD_BARS; i++)
+    {
+        lv_obj_t* bar = lv_obj_create(screen);
+        lv_obj_remove_style_all(bar);
+        bool header = i % 2 == 0;
+        lv_obj_set_size(bar, header ? lv_pct(100) : 96, header ? 8 : 24);
+        lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(bar, lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_bg_grad_color(bar, lv_palette_darken(LV_PALETTE_BLUE, 3), 0);
+        lv_obj_set_style_bg_grad_dir(bar, header ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+    }
+    lv_screen_load(screen);
+    lv_refr_now(NULL);
+
+    lv_draw_sw_grad_cache_resize(0, true);
+    double uncached_us = redraw_gradients_us();
+
+    lv_draw_sw_grad_cache_resize(LV_DRAW_SW_GRAD_CACHE_DEF_SIZE, true);
+    lv_refr_now(NULL);
+    uint32_t hits = lv_draw_sw_grad_cache_get_hit_cnt();
+    uint32_t misses = lv_draw_sw_grad_cache_get_miss_cnt();
+    double cached_us = redraw_gradients_us();
+    hits = lv_draw_sw_grad_cache_get_hit_cnt() - hits;
+    misses = lv_draw_sw_grad_cache_get_miss_cnt() - misses;
+
+    printf("gradients: %d bars and tiles, without cache %.1f us/frame, with cache %.1f us/frame (%.2fx), "
+        "%u%% hits, %u bytes\n", BENCHMARK_GRAD_BARS, uncached_us, cached_us, uncached_us / cached_us,
+        hits + misses ? (unsigned)(hits * 100ull / (hits + misses)) : 0u, (unsigned)lv_draw_sw_grad_cache_get_size());
+
+    lv_screen_load(previous);
+    lv_obj_delete(screen);
+}
+#endif
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_USE_OS
+// Creates rounded rectangle masks with many radii and applies them to a line at the corner, like the
+// SW renderer does for each rounded widget
+static void circle_mask_thread_cb(void* user_data)
+{
+    uint32_t first = (uint32_t)(lv_uintptr_t)user_data;
+    lv_opa_t line[64];
+    for (uint32_t i = 0; i < BENCHMARK_CIRCLE_MASKS; i++)
+    {
+        int32_t radius = 2 + (int32_t)((first + i * 7) % BENCHMARK_CIRCLE_RADII);
+        lv_area_t rect = { 0, 0, 199, 199 };
+        lv_draw_sw_mask_radius_param_t param;
+        lv_draw_sw_mask_radius_init(&param, &rect, radius, false);
+
+        void* masks[2] = { &param, NULL };
+        lv_memset(line, LV_OPA_COVER, sizeof(line));
+        lv_draw_sw_mask_apply(masks, line, 0, 1, sizeof(line));
+        lv_draw_sw_mask_free_param(&param);
+    }
+}
+
+// Wall time of each thread creating its masks, the best of a few rounds
+static double run_circle_masks_us(uint32_t thread_count)
+{
+    double best_us = 0;
+    for (int round = 0; round < BENCHMARK_CIRCLE_ROUNDS; round++)
+    {
+        lv_thread_t threads[BENCHMARK_CIRCLE_THREADS];
+        struct timespec start;
+        timespec_get(&start, TIME_UTC);
+        for (uint32_t i = 0; i < thread_count; i++)
+        {
+            lv_thread_init(&threads[i], "circle", LV_THREAD_PRIO_MID, circle_mask_thread_cb, 16 * 1024,
+                (void*)(lv_uintptr_t)(i * 11));
+        }
+        for (uint32_t i = 0; i < thread_count; i++) lv_thread_delete(&threads[i]);
+
+        double round_us = elapsed_wall_us(&start);
+        if (round == 0 || round_us < best_us) best_us = round_us;
+    }
+    return best_us;
+}
+
+/**
+ * Creates rounded corner masks of many distinct radii on 1 and 4 threads at the same time, like the
+ * SW render threads drawing rounded widgets.
+ */
+static void benchmark_circle_masks(void)
+{
+    lv_draw_sw_mask_cleanup();
+    double single_us = run_circle_masks_us(1);
+    double multi_us = run_circle_masks_us(BENCHMARK_CIRCLE_THREADS);
+    uint32_t masks = BENCHMARK_CIRCLE_MASKS * BENCHMARK_CIRCLE_THREADS;
+    printf("circle masks: %d radii, cache of %d, 1 thread %.1f ns/mask, %d threads %.1f ns/mask (%.2fx the masks per second)\n",
+        BENCHMARK_CIRCLE_RADII, LV_DRAW_SW_CIRCLE_CACHE_SIZE, single_us * 1000.0 / BENCHMARK_CIRCLE_MASKS,
+        BENCHMARK_CIRCLE_THREADS, multi_us * 1000.0 / masks, single_us * BENCHMARK_CIRCLE_THREADS / multi_us);
+    lv_draw_sw_mask_cleanup();
+}
+#endif
+
+bool run_schedule_benchmarks(void)
+{
+    bool passed = true;
+    benchmark_progress_ticks();
+    benchmark_schedule_file();
+    benchmark_schedule_lookup();
+    benchmark_schedule_update();
+    benchmark_glyph_lookup();
+    benchmark_glyph_bitmaps();
+    benchmark_lesson_block_styles();
+    benchmark_list_scroll();
+#if LV_OBJ_COVER_CACHE
+    benchmark_cover_check();
+#endif
+    benchmark_small_animations();
+    benchmark_draw_tasks();
+    benchmark_task_dispatch();
+    benchmark_render_threads();
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2 && LV_BLEND_SSE2_AVAILABLE
+    passed = benchmark_blend() && passed;
+    passed = benchmark_transform() && passed;
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX
+    benchmark_shadows();
+#endif
+#if LV_USE_DRAW_SW
+    benchmark_gradients();
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && LV_USE_OS
+    benchmark_circle_masks();
+#endif
+    return passed;
+}
@@ -0,0 +1,20 @@
+﻿#ifndef SCHEDULE_BENCHMARK_H
+#define SCHEDULE_BENCHMARK_H
+
+#include <stdbool.h>
+
+/**
+ * Set to 1 to run the schedule benchmarks once the UI is initialized.
+ */
+#ifndef SCHEDULE_RUN_BENCHMARKS
+#define SCHEDULE_RUN_BENCHMARKS 0
+#endif
+
+/**
+ * Runs the schedule benchmarks and prints their results to the console.
+ * @note Must be called after init_schedule_ui(). The schedule display is left showing the current date.
+ * @return false if an SSE2 or AVX2 implementation drew other pixels than the C one.
+ */
+bool run_schedule_benchmarks(void);
+
+#endif
@@ -1,7 +1,49 @@
 ﻿#include "schedule_data.h"
+#include <lvgl/lvgl.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
-static lesson_t lessons[] = {
+// Room whose lessons are returned by the date based functions
+#define DISPLAY_ROOM 0
+
+// Schedule images are mapped straight onto lesson_t records, so its layout must not change
+typedef char lesson_size_check[sizeof(lesson_t) == 16 ? 1 : -1];
+
+struct schedule {
+    int first_day;                          // Day number of the first indexed day
+    int day_count;                          // Number of indexed days per room
+    int room_count;                         // Number of rooms
+    int lesson_count;                       // Total number of lessons
+    uint32_t string_pool_size;              // Size of the string pool in bytes
+    const schedule_string_t* room_names;    // Room names, sorted
+    const uint32_t* day_offsets;            // Lessons of room r on day d: [day_offsets[r * day_count + d], day_offsets[r * day_count + d + 1])
+    const lesson_t* lessons;                // Lessons sorted by room, day and start time
+    const char* strings;                    // String pool
+    schedule_string_t type_names[LESSON_TYPE_COUNT]; // Identifier of the name of each lesson type, 0 if unused
+    void* image;                            // Schedule image holding the tables above
+    uint32_t image_size;                    // Size of the image in bytes
+    schedule_release_cb_t release_cb;       // Releases the image
+    void* user_data;                        // Passed to release_cb
+};
+
+/**
+ * A lesson of the built-in weekly timetable.
+ */
+typedef struct {
+    const char* type;
+    const char* subject;
+    const char* teacher;
+    int start_hour;
+    int start_minute;
+    int end_hour;
+    int end_minute;
+} WeeklyLesson;
+
+static const char* builtin_room = "101";
+
+// Lessons held every week from Monday to Saturday during the academic year
+static const WeeklyLesson weekly_lessons[] = {
     {"Лабораторные занятия", "Искусственные интеллект и нейронные сети", "Сурина Альфия Адгамовна", 9, 45, 11, 20},
     {"Практические занятия и семинары", "Теория оптимизации", "Кунгурцева Алла Васильевна", 11, 30, 13, 05},
     {"Лекции", "Компьютерная графика", "Алексеева Елена Юрьевна", 13, 35, 15, 10},
@@ -9,34 +51,574 @@ static lesson_t lessons[] = {
     {"Лекции", "111111111121111111111211111111111111111111121Основы компьютерного зрения", "Сурин Владимир Анатольевич", 17, 05, 18, 40 }
 };
 
-static int lesson_count = sizeof(lessons) / sizeof(lessons[0]);
+// Names of the lesson types, in lesson_type_t order
+static const char* lesson_type_names[LESSON_TYPE_COUNT] = {
+    "",
+    "Зачет",
+    "Экзамен",
+    "Дифференцированный зачет",
+    "Консультация к промежуточной аттестации",
+    "-",
+    "Курсовая работа",
+    "Лекции",
+    "Практические занятия и семинары",
+    "Лабораторные занятия"
+};
+
+// Hash index of lesson_type_names, filled on first use
+#define LESSON_TYPE_SLOT_COUNT 32
+static uint8_t lesson_type_slots[LESSON_TYPE_SLOT_COUNT];
+static int lesson_type_slots_ready;
+
+static schedule_t* active_schedule;
+
+// Sections of a schedule image start on 4-byte boundaries
+#define ALIGN_IMAGE(size) (((uint32_t)(size) + 3u) & ~3u)
+
+/**
+ * String pool with a hash index, used while a schedule is being built.
+ */
+typedef struct {
+    char* data;
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t* slots;        // Open addressing table of string offsets, 0 marks an empty slot
+    uint32_t slot_mask;
+} StringPool;
+
+/**
+ * A lesson together with its sort key, used while a schedule is being built.
+ */
+typedef struct {
+    int room;
+    int day;
+    lesson_t lesson;
+} SortItem;
+
+static void release_image(void* image, void* user_data)
+{
+    (void)user_data;
+    lv_free(image);
+}
+
+static int days_from_civil(int year, int month, int day)
+{
+    // Howard Hinnant's days_from_civil, valid for the proleptic Gregorian calendar
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+int get_day_number(const struct tm* date)
+{
+    return days_from_civil(date->tm_year + 1900, date->tm_mon + 1, date->tm_mday);
+}
+
+static uint32_t hash_string(const char* str)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*str)
+    {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
 
-lesson_t get_lesson(int index)
+/**
+ * Finds the lesson type with a given name.
+ * @param str   The name.
+ * @param hash  hash_string() of the name.
+ * @return The lesson type, LESSON_TYPE_OTHER if the name is unknown.
+ */
+static lesson_type_t find_lesson_type(const char* str, uint32_t hash)
 {
-    if (index >= 0 && index < lesson_count)
+    if (!lesson_type_slots_ready)
     {
-        return lessons[index];
+        for (int type = 1; type < LESSON_TYPE_COUNT; type++)
+        {
+            uint32_t slot = hash_string(lesson_type_names[type]) & (LESSON_TYPE_SLOT_COUNT - 1);
+            while (lesson_type_slots[slot])
+            {
+                slot = (slot + 1) & (LESSON_TYPE_SLOT_COUNT - 1);
+            }
+            lesson_type_slots[slot] = (uint8_t)type;
+        }
+        lesson_type_slots_ready = 1;
     }
-    return lessons[0]; // Fallback to first lesson
+
+    uint32_t slot = hash & (LESSON_TYPE_SLOT_COUNT - 1);
+    while (lesson_type_slots[slot])
+    {
+        if (strcmp(lesson_type_names[lesson_type_slots[slot]], str) == 0)
+        {
+            return (lesson_type_t)lesson_type_slots[slot];
+        }
+        slot = (slot + 1) & (LESSON_TYPE_SLOT_COUNT - 1);
+    }
+    return LESSON_TYPE_OTHER;
 }
 
-int get_lesson_count(void)
+static int init_string_pool(StringPool* pool, int max_strings)
+{
+    uint32_t slot_count = 16;
+    while (slot_count < (uint32_t)max_strings * 2)
+    {
+        slot_count <<= 1;
+    }
+
+    pool->slots = lv_calloc(slot_count, sizeof(uint32_t));
+    pool->slot_mask = slot_count - 1;
+    pool->capacity = 1024;
+    pool->data = lv_malloc(pool->capacity);
+    pool->size = 1;
+    if (!pool->slots || !pool->data)
+    {
+        lv_free(pool->slots);
+        lv_free(pool->data);
+        return 0;
+    }
+    pool->data[0] = '\0'; // Identifier 0 is the empty string
+    return 1;
+}
+
+/**
+ * Adds a string to the pool unless an equal string is already stored.
+ * @return The identifier of the string, or UINT32_MAX if out of memory.
+ */
+static schedule_string_t intern_string(StringPool* pool, const char* str)
+{
+    if (!str || !*str) return 0;
+
+    uint32_t slot = hash_string(str) & pool->slot_mask;
+    while (pool->slots[slot])
+    {
+        if (strcmp(pool->data + pool->slots[slot], str) == 0)
+        {
+            return pool->slots[slot];
+        }
+        slot = (slot + 1) & pool->slot_mask;
+    }
+
+    uint32_t length = (uint32_t)strlen(str) + 1;
+    if (pool->size + length > pool->capacity)
+    {
+        uint32_t capacity = pool->capacity;
+        while (pool->size + length > capacity)
+        {
+            capacity *= 2;
+        }
+        char* data = lv_realloc(pool->data, capacity);
+        if (!data) return UINT32_MAX;
+        pool->data = data;
+        pool->capacity = capacity;
+    }
+
+    uint32_t id = pool->size;
+    memcpy(pool->data + id, str, length);
+    pool->size += length;
+    pool->slots[slot] = id;
+    return id;
+}
+
+static const char* sort_strings; // String pool used by compare_room_names()
+
+static int compare_room_names(const void* a, const void* b)
+{
+    return strcmp(sort_strings + *(const schedule_string_t*)a, sort_strings + *(const schedule_string_t*)b);
+}
+
+static int compare_sort_items(const void* a, const void* b)
+{
+    const SortItem* x = a;
+    const SortItem* y = b;
+    if (x->room != y->room) return x->room < y->room ? -1 : 1;
+    if (x->day != y->day) return x->day < y->day ? -1 : 1;
+    int x_start = x->lesson.start_hour * 60 + x->lesson.start_minute;
+    int y_start = y->lesson.start_hour * 60 + y->lesson.start_minute;
+    return (x_start > y_start) - (x_start < y_start);
+}
+
+static int find_room(const schedule_string_t* room_names, int room_count, schedule_string_t name)
+{
+    // Room names are interned, so the sorted order is searched by content and matched by identifier
+    int low = 0, high = room_count - 1;
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        if (room_names[mid] == name) return mid;
+        if (strcmp(sort_strings + room_names[mid], sort_strings + name) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+schedule_t* create_schedule(const schedule_entry_t* entries, int count)
+{
+    schedule_t* schedule = NULL;
+    SortItem* items = lv_malloc(sizeof(SortItem) * (count > 0 ? count : 1));
+    schedule_string_t* room_ids = lv_malloc(sizeof(schedule_string_t) * (count > 0 ? count : 1));
+    StringPool pool;
+    if (!items || !room_ids || !init_string_pool(&pool, count * 4 + 1))
+    {
+        lv_free(items);
+        lv_free(room_ids);
+        return NULL;
+    }
+
+    // Intern all strings
+    int room_count = 0;
+    int first_day = 0, last_day = -1;
+    for (int i = 0; i < count; i++)
+    {
+        const schedule_entry_t* entry = &entries[i];
+        schedule_string_t room = intern_string(&pool, entry->room);
+        lesson_t* lesson = &items[i].lesson;
+        lesson->type = intern_string(&pool, entry->type);
+        lesson->subject = intern_string(&pool, entry->subject);
+        lesson->teacher = intern_string(&pool, entry->teacher);
+        if (room == UINT32_MAX || lesson->type == UINT32_MAX ||
+            lesson->subject == UINT32_MAX || lesson->teacher == UINT32_MAX)
+        {
+            goto cleanup;
+        }
+        lesson->start_hour = (uint8_t)entry->start_hour;
+        lesson->start_minute = (uint8_t)entry->start_minute;
+        lesson->end_hour = (uint8_t)entry->end_hour;
+        lesson->end_minute = (uint8_t)entry->end_minute;
+
+        int day = days_from_civil(entry->year, entry->month, entry->day);
+        items[i].day = day;
+        items[i].room = (int)room; // Replaced by the room index below
+        if (i == 0 || day < first_day) first_day = day;
+        if (i == 0 || day > last_day) last_day = day;
+
+        room_ids[i] = room;
+    }
+
+    // Sort the room names and drop the duplicates
+    sort_strings = pool.data;
+    qsort(room_ids, count, sizeof(schedule_string_t), compare_room_names);
+    for (int i = 0; i < count; i++)
+    {
+        if (room_count == 0 || room_ids[room_count - 1] != room_ids[i])
+        {
+            room_ids[room_count++] = room_ids[i];
+        }
+    }
+    for (int i = 0; i < count; i++)
+    {
+        items[i].room = find_room(room_ids, room_count, (schedule_string_t)items[i].room);
+    }
+    qsort(items, count, sizeof(SortItem), compare_sort_items);
+
+    // Lay out all tables in a single schedule image
+    int day_count = last_day - first_day + 1;
+    size_t offset_count = (size_t)room_count * day_count + 1;
+    uint32_t lessons_offset = ALIGN_IMAGE(sizeof(schedule_file_header_t));
+    uint32_t day_offsets_offset = lessons_offset + (uint32_t)(sizeof(lesson_t) * count);
+    uint32_t room_names_offset = day_offsets_offset + (uint32_t)(sizeof(uint32_t) * offset_count);
+    uint32_t strings_offset = room_names_offset + (uint32_t)(sizeof(schedule_string_t) * room_count);
+    uint32_t image_size = ALIGN_IMAGE(strings_offset + pool.size);
+    uint8_t* image = lv_malloc_zeroed(image_size);
+    if (!image) goto cleanup;
+
+    schedule_file_header_t* header = (schedule_file_header_t*)image;
+    header->magic = SCHEDULE_FILE_MAGIC;
+    header->version = SCHEDULE_FILE_VERSION;
+    header->header_size = sizeof(schedule_file_header_t);
+    header->file_size = image_size;
+    header->first_day = first_day;
+    header->day_count = day_count;
+    header->room_count = room_count;
+    header->lesson_count = count;
+    header->lessons_offset = lessons_offset;
+    header->day_offsets_offset = day_offsets_offset;
+    header->room_names_offset = room_names_offset;
+    header->strings_offset = strings_offset;
+    header->strings_size = pool.size;
+
+    lesson_t* lessons = (lesson_t*)(image + lessons_offset);
+    uint32_t* day_offsets = (uint32_t*)(image + day_offsets_offset);
+    size_t slot = 0;
+    for (int i = 0; i < count; i++)
+    {
+        size_t item_slot = (size_t)items[i].room * day_count + (items[i].day - first_day);
+        while (slot <= item_slot)
+        {
+            day_offsets[slot++] = (uint32_t)i;
+        }
+        lessons[i] = items[i].lesson;
+    }
+    while (slot < offset_count)
+    {
+        day_offsets[slot++] = (uint32_t)count;
+    }
+    memcpy(image + room_names_offset, room_ids, sizeof(schedule_string_t) * room_count);
+    memcpy(image + strings_offset, pool.data, pool.size);
+
+    schedule = open_schedule_image(image, image_size, release_image, NULL);
+    if (!schedule)
+    {
+        lv_free(image);
+    }
+
+cleanup:
+    sort_strings = NULL;
+    lv_free(items);
+    lv_free(room_ids);
+    lv_free(pool.slots);
+    lv_free(pool.data);
+    return schedule;
+}
+
+static int is_section_valid(const schedule_file_header_t* header, uint32_t offset, uint64_t size)
+{
+    return (offset & 3u) == 0 && offset >= header->header_size && offset + size <= header->file_size;
+}
+
+schedule_t* open_schedule_image(void* image, uint32_t size, schedule_release_cb_t release_cb, void* user_data)
+{
+    const schedule_file_header_t* header = image;
+    if (!image || ((uintptr_t)image & 3u) || size < sizeof(schedule_file_header_t)) return NULL;
+    if (header->magic != SCHEDULE_FILE_MAGIC || header->version != SCHEDULE_FILE_VERSION) return NULL;
+    if (header->header_size < sizeof(schedule_file_header_t) || header->file_size > size) return NULL;
+    if (header->day_count < 0 || header->room_count < 0 || header->lesson_count < 0) return NULL;
+
+    uint64_t offset_count = (uint64_t)header->room_count * (uint64_t)header->day_count + 1;
+    if (!is_section_valid(header, header->lessons_offset, sizeof(lesson_t) * (uint64_t)header->lesson_count) ||
+        !is_section_valid(header, header->day_offsets_offset, sizeof(uint32_t) * offset_count) ||
+        !is_section_valid(header, header->room_names_offset, sizeof(schedule_string_t) * (uint64_t)header->room_count) ||
+        !is_section_valid(header, header->strings_offset, header->strings_size))
+    {
+        return NULL;
+    }
+
+    // The pool must start with the empty string and end with a terminator, so no lookup can run past it
+    const char* strings = (const char*)image + header->strings_offset;
+    if (header->strings_size == 0 || strings[0] != '\0' || strings[header->strings_size - 1] != '\0') return NULL;
+
+    schedule_t* schedule = lv_malloc(sizeof(schedule_t));
+    if (!schedule) return NULL;
+
+    schedule->first_day = header->first_day;
+    schedule->day_count = header->day_count;
+    schedule->room_count = header->room_count;
+    schedule->lesson_count = header->lesson_count;
+    schedule->string_pool_size = header->strings_size;
+    schedule->room_names = (const schedule_string_t*)((const uint8_t*)image + header->room_names_offset);
+    schedule->day_offsets = (const uint32_t*)((const uint8_t*)image + header->day_offsets_offset);
+    schedule->lessons = (const lesson_t*)((const uint8_t*)image + header->lessons_offset);
+    schedule->strings = strings;
+    schedule->image = image;
+
+    // Resolve the lesson type names once, the pool holds every distinct text a single time
+    memset(schedule->type_names, 0, sizeof(schedule->type_names));
+    for (uint32_t id = 1; id < header->strings_size; id += (uint32_t)strlen(strings + id) + 1)
+    {
+        lesson_type_t type = find_lesson_type(strings + id, hash_string(strings + id));
+        if (type != LESSON_TYPE_OTHER)
+        {
+            schedule->type_names[type] = id;
+        }
+    }
+
+    schedule->image_size = header->file_size;
+    schedule->release_cb = release_cb;
+    schedule->user_data = user_data;
+    return schedule;
+}
+
+const void* get_schedule_image(const schedule_t* schedule, uint32_t* size)
+{
+    *size = schedule ? schedule->image_size : 0;
+    return schedule ? schedule->image : NULL;
+}
+
+void delete_schedule(schedule_t* schedule)
 {
-    return lesson_count;
+    if (!schedule || schedule == active_schedule) return;
+
+    if (schedule->release_cb)
+    {
+        schedule->release_cb(schedule->image, schedule->user_data);
+    }
+    lv_free(schedule);
 }
 
-int get_lesson_count_for_date(struct tm* date)
+/**
+ * Expands the weekly timetable over the academic year (September to June) containing today.
+ */
+static schedule_t* create_builtin_schedule(void)
 {
-    (void)date;
+    time_t now = time(NULL);
+    struct tm* today = localtime(&now);
+    int first_year = today->tm_year + 1900 - (today->tm_mon < 8 ? 1 : 0);
+    int first_day = days_from_civil(first_year, 9, 1);
+    int last_day = days_from_civil(first_year + 1, 6, 30);
+    int lessons_per_day = sizeof(weekly_lessons) / sizeof(weekly_lessons[0]);
+
+    schedule_entry_t* entries = lv_malloc(sizeof(schedule_entry_t) * (last_day - first_day + 1) * lessons_per_day);
+    if (!entries) return NULL;
 
-    // Return lesson count for date (e.g., check database or array)
-    return get_lesson_count(); // Fallback
+    int count = 0;
+    for (int day = first_day; day <= last_day; day++)
+    {
+        if ((day + 4) % 7 == 0) continue; // Day 0 was a Thursday, so this skips Sundays
+
+        // Day number back to a calendar date
+        time_t seconds = (time_t)day * 86400;
+        struct tm date = *gmtime(&seconds);
+        for (int i = 0; i < lessons_per_day; i++)
+        {
+            const WeeklyLesson* weekly = &weekly_lessons[i];
+            schedule_entry_t* entry = &entries[count++];
+            entry->room = builtin_room;
+            entry->year = date.tm_year + 1900;
+            entry->month = date.tm_mon + 1;
+            entry->day = date.tm_mday;
+            entry->type = weekly->type;
+            entry->subject = weekly->subject;
+            entry->teacher = weekly->teacher;
+            entry->start_hour = weekly->start_hour;
+            entry->start_minute = weekly->start_minute;
+            entry->end_hour = weekly->end_hour;
+            entry->end_minute = weekly->end_minute;
+        }
+    }
+
+    schedule_t* schedule = create_schedule(entries, count);
+    lv_free(entries);
+    return schedule;
 }
 
-lesson_t get_lesson_for_date(struct tm* date, int index)
+const schedule_t* get_active_schedule(void)
 {
-    (void)date;
+    if (!active_schedule)
+    {
+        active_schedule = create_builtin_schedule();
+    }
+    return active_schedule;
+}
+
+schedule_t* set_active_schedule(schedule_t* schedule)
+{
+    schedule_t* previous = active_schedule;
+    active_schedule = schedule;
+    return previous;
+}
+
+int get_schedule_room_count(const schedule_t* schedule)
+{
+    return schedule ? schedule->room_count : 0;
+}
+
+const char* get_schedule_room_name(const schedule_t* schedule, int room)
+{
+    if (!schedule || room < 0 || room >= schedule->room_count) return "";
+    return get_schedule_string(schedule, schedule->room_names[room]);
+}
 
-    // Return lesson for date and index
-    return get_lesson(index); // Fallback
+const lesson_t* get_schedule_lessons(const schedule_t* schedule, int room, int day, int* count)
+{
+    *count = 0;
+    if (!schedule || room < 0 || room >= schedule->room_count) return NULL;
+
+    int index = day - schedule->first_day;
+    if (index < 0 || index >= schedule->day_count) return NULL;
+
+    // Offsets come straight from the image, so they are checked here instead of at load time
+    const uint32_t* offsets = &schedule->day_offsets[(size_t)room * schedule->day_count + index];
+    if (offsets[0] >= offsets[1] || offsets[1] > (uint32_t)schedule->lesson_count) return NULL;
+
+    *count = (int)(offsets[1] - offsets[0]);
+    return &schedule->lessons[offsets[0]];
+}
+
+const char* get_schedule_string(const schedule_t* schedule, schedule_string_t id)
+{
+    if (!schedule || id >= schedule->string_pool_size) return "";
+    return schedule->strings + id;
+}
+
+lesson_type_t get_schedule_lesson_type(const schedule_t* schedule, const lesson_t* lesson)
+{
+    if (!schedule || !lesson->type) return LESSON_TYPE_OTHER;
+
+    for (int type = 1; type < LESSON_TYPE_COUNT; type++)
+    {
+        if (schedule->type_names[type] == lesson->type)
+        {
+            return (lesson_type_t)type;
+        }
+    }
+    return LESSON_TYPE_OTHER;
+}
+
+void get_schedule_stats(const schedule_t* schedule, schedule_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (!schedule) return;
+
+    stats->room_count = schedule->room_count;
+    stats->day_count = schedule->day_count;
+    stats->lesson_count = schedule->lesson_count;
+    stats->string_pool_size = schedule->string_pool_size;
+    stats->image_size = schedule->image_size;
+    stats->memory_size = (uint32_t)sizeof(schedule_t) + schedule->image_size;
+}
+
+const char* get_lesson_string(schedule_string_t id)
+{
+    return get_schedule_string(get_active_schedule(), id);
+}
+
+lesson_type_t get_lesson_type(const lesson_t* lesson)
+{
+    return get_schedule_lesson_type(get_active_schedule(), lesson);
+}
+
+const lesson_t* get_lesson(int index)
+{
+    time_t now = time(NULL);
+    return get_lesson_for_date(localtime(&now), index);
+}
+
+int get_lesson_count(void)
+{
+    time_t now = time(NULL);
+    return get_lesson_count_for_date(localtime(&now));
+}
+
+int get_lesson_count_for_date(const struct tm* date)
+{
+    int count;
+    get_schedule_lessons(get_active_schedule(), DISPLAY_ROOM, get_day_number(date), &count);
+    return count;
+}
+
+const lesson_t* get_lessons_for_date(const struct tm* date, int* count)
+{
+    return get_schedule_lessons(get_active_schedule(), DISPLAY_ROOM, get_day_number(date), count);
+}
+
+const lesson_t* get_lesson_for_date(const struct tm* date, int index)
+{
+    int count;
+    const lesson_t* lessons = get_lessons_for_date(date, &count);
+    if (index >= 0 && index < count)
+    {
+        return &lessons[index];
+    }
+    return NULL;
 }
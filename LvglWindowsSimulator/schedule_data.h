@@ -1,28 +1,245 @@
 ﻿#ifndef SCHEDULE_DATA_H
 #define SCHEDULE_DATA_H
 
+#include <stdint.h>
+
 struct tm;
 
+/**
+ * Identifier of an interned string: offset of the string in the string pool of a schedule.
+ * Every distinct text is stored once, so two strings of the same schedule are equal if and only if their identifiers are.
+ * Identifier 0 is always the empty string.
+ */
+typedef uint32_t schedule_string_t;
+
 /**
  * Structure representing a single lesson in the schedule.
  * Contains information about the lesson type, subject, teacher, and time.
  */
 typedef struct {
-    const char* type;       /** Type of the lesson */
-    const char* subject;    /** Subject of the lesson */
-    const char* teacher;    /** Name of the teacher */
-    int start_hour;         /** Start hour of the lesson */
-    int start_minute;       /** Start minute of the lesson */
-    int end_hour;           /** End hour of the lesson */
-    int end_minute;         /** End minute of the lesson */
+    schedule_string_t type;     /** Type of the lesson */
+    schedule_string_t subject;  /** Subject of the lesson */
+    schedule_string_t teacher;  /** Name of the teacher */
+    uint8_t start_hour;         /** Start hour of the lesson */
+    uint8_t start_minute;       /** Start minute of the lesson */
+    uint8_t end_hour;           /** End hour of the lesson */
+    uint8_t end_minute;         /** End minute of the lesson */
 } lesson_t;
 
+/**
+ * Kind of a lesson, resolved from the type string when a schedule is loaded.
+ * Lets the display pick colors without comparing strings.
+ */
+typedef enum {
+    LESSON_TYPE_OTHER,              /** Type without a known name */
+    LESSON_TYPE_CREDIT,             /** "Зачет" */
+    LESSON_TYPE_EXAM,               /** "Экзамен" */
+    LESSON_TYPE_GRADED_CREDIT,      /** "Дифференцированный зачет" */
+    LESSON_TYPE_CONSULTATION,       /** "Консультация к промежуточной аттестации" */
+    LESSON_TYPE_NONE,               /** "-" */
+    LESSON_TYPE_COURSE_WORK,        /** "Курсовая работа" */
+    LESSON_TYPE_LECTURE,            /** "Лекции" */
+    LESSON_TYPE_SEMINAR,            /** "Практические занятия и семинары" */
+    LESSON_TYPE_LABORATORY,         /** "Лабораторные занятия" */
+    LESSON_TYPE_COUNT
+} lesson_type_t;
+
+/**
+ * A single lesson of a room on a given date, used as input for create_schedule().
+ * Strings are copied into the string pool of the schedule, so they need not outlive the call.
+ */
+typedef struct {
+    const char* room;           /** Name of the room */
+    int year;                   /** Full year, e.g. 2025 */
+    int month;                  /** Month, 1-12 */
+    int day;                    /** Day of the month, 1-31 */
+    const char* type;           /** Type of the lesson */
+    const char* subject;        /** Subject of the lesson */
+    const char* teacher;        /** Name of the teacher */
+    int start_hour;             /** Start hour of the lesson */
+    int start_minute;           /** Start minute of the lesson */
+    int end_hour;               /** End hour of the lesson */
+    int end_minute;             /** End minute of the lesson */
+} schedule_entry_t;
+
+/**
+ * Immutable, date-indexed timetable of one or more rooms.
+ * Lessons are stored sorted by room, date and start time, with a dense per-day offset table,
+ * so the lessons of a day are found in constant time.
+ */
+typedef struct schedule schedule_t;
+
+/** Magic number at the start of a schedule image ("SCHD") */
+#define SCHEDULE_FILE_MAGIC 0x44484353u
+
+/** Version of the schedule image layout */
+#define SCHEDULE_FILE_VERSION 1
+
+/**
+ * Header of a schedule image, as stored in a schedule file and kept in memory by create_schedule().
+ * All values are little-endian and all sections are 4-byte aligned offsets from the start of the image:
+ * - lessons:     lesson_count lesson_t records, sorted by room, day and start time
+ * - day_offsets: room_count * day_count + 1 uint32_t values, the lessons of room r on day d are
+ *                [day_offsets[r * day_count + d], day_offsets[r * day_count + d + 1])
+ * - room_names:  room_count schedule_string_t values, sorted by name
+ * - strings:     the string pool, NUL-terminated strings starting with the empty string
+ */
+typedef struct {
+    uint32_t magic;                 /** SCHEDULE_FILE_MAGIC */
+    uint16_t version;               /** SCHEDULE_FILE_VERSION */
+    uint16_t header_size;           /** Size of this header in bytes */
+    uint32_t file_size;             /** Size of the whole image in bytes */
+    int32_t first_day;              /** Day number of the first indexed day */
+    int32_t day_count;              /** Number of indexed days per room */
+    int32_t room_count;             /** Number of rooms */
+    int32_t lesson_count;           /** Total number of lessons */
+    uint32_t lessons_offset;        /** Offset of the lessons */
+    uint32_t day_offsets_offset;    /** Offset of the day offset table */
+    uint32_t room_names_offset;     /** Offset of the room names */
+    uint32_t strings_offset;        /** Offset of the string pool */
+    uint32_t strings_size;          /** Size of the string pool in bytes */
+} schedule_file_header_t;
+
+/**
+ * Called when a schedule opened with open_schedule_image() is deleted, to release the image.
+ */
+typedef void (*schedule_release_cb_t)(void* image, void* user_data);
+
+/**
+ * Size information about a schedule.
+ */
+typedef struct {
+    int room_count;             /** Number of rooms */
+    int day_count;              /** Number of indexed days per room */
+    int lesson_count;           /** Total number of lessons */
+    uint32_t string_pool_size;  /** Bytes used by the interned strings */
+    uint32_t image_size;        /** Bytes of the schedule image (heap, read buffer or mapped file) */
+    uint32_t memory_size;       /** Bytes used by the whole schedule, including the image */
+} schedule_stats_t;
+
+/**
+ * Builds a schedule from an unsorted list of lessons.
+ * @param entries  Lessons to store.
+ * @param count    Number of entries.
+ * @return The new schedule, or NULL if out of memory. Free it with delete_schedule().
+ */
+schedule_t* create_schedule(const schedule_entry_t* entries, int count);
+
+/**
+ * Opens a schedule directly on a schedule image, without parsing or copying it.
+ * Only the header is validated, lookups stay within the image even if the tables are corrupt.
+ * @param image       The image, at least 4-byte aligned. Must stay valid until the schedule is deleted.
+ * @param size        Size of the image in bytes.
+ * @param release_cb  Called with the image and user_data when the schedule is deleted, may be NULL.
+ * @param user_data   Passed to release_cb.
+ * @return The new schedule, or NULL if the image is invalid or out of memory. release_cb is not called on failure.
+ */
+schedule_t* open_schedule_image(void* image, uint32_t size, schedule_release_cb_t release_cb, void* user_data);
+
+/**
+ * Gets the image of a schedule, e.g. to write it to a schedule file.
+ * @param schedule  The schedule to query.
+ * @param size      Receives the size of the image in bytes.
+ * @return The image.
+ */
+const void* get_schedule_image(const schedule_t* schedule, uint32_t* size);
+
+/**
+ * Frees a schedule created by create_schedule() or open_schedule_image().
+ * @param schedule  The schedule to free. Must not be the active schedule.
+ */
+void delete_schedule(schedule_t* schedule);
+
+/**
+ * Gets the schedule used by the date based functions below.
+ * The built-in timetable is loaded on the first call if no schedule was set.
+ * @return The active schedule.
+ */
+const schedule_t* get_active_schedule(void);
+
+/**
+ * Sets the schedule used by the date based functions.
+ * @param schedule  The new active schedule.
+ * @return The previous active schedule (may be NULL), which the caller may now delete.
+ */
+schedule_t* set_active_schedule(schedule_t* schedule);
+
+/**
+ * Gets the number of rooms in a schedule.
+ * @param schedule  The schedule to query.
+ * @return The number of rooms.
+ */
+int get_schedule_room_count(const schedule_t* schedule);
+
+/**
+ * Gets the name of a room.
+ * @param schedule  The schedule to query.
+ * @param room      Index of the room.
+ * @return The name of the room.
+ */
+const char* get_schedule_room_name(const schedule_t* schedule, int room);
+
+/**
+ * Gets the lessons of a room on a day, sorted by start time.
+ * @param schedule  The schedule to query.
+ * @param room      Index of the room.
+ * @param day       Day number, as returned by get_day_number().
+ * @param count     Receives the number of lessons.
+ * @return Pointer to the first lesson, or NULL if there are none.
+ */
+const lesson_t* get_schedule_lessons(const schedule_t* schedule, int room, int day, int* count);
+
+/**
+ * Resolves a string of a schedule.
+ * @param schedule  The schedule the identifier belongs to.
+ * @param id        The string identifier.
+ * @return The string.
+ */
+const char* get_schedule_string(const schedule_t* schedule, schedule_string_t id);
+
+/**
+ * Gets the kind of a lesson of a schedule.
+ * Type strings are resolved when the schedule is opened, so this only compares identifiers.
+ * @param schedule  The schedule the lesson belongs to.
+ * @param lesson    The lesson.
+ * @return The kind of the lesson, LESSON_TYPE_OTHER if its type has no known name.
+ */
+lesson_type_t get_schedule_lesson_type(const schedule_t* schedule, const lesson_t* lesson);
+
+/**
+ * Gets size information about a schedule.
+ * @param schedule  The schedule to query.
+ * @param stats     Receives the information.
+ */
+void get_schedule_stats(const schedule_t* schedule, schedule_stats_t* stats);
+
+/**
+ * Converts a date to a day number (days since 1970-01-01).
+ * @param date  Pointer to a struct tm containing the date (year, month, day).
+ * @return The day number.
+ */
+int get_day_number(const struct tm* date);
+
+/**
+ * Resolves a string of the active schedule.
+ * @param id  The string identifier.
+ * @return The string.
+ */
+const char* get_lesson_string(schedule_string_t id);
+
+/**
+ * Gets the kind of a lesson of the active schedule.
+ * @param lesson  The lesson.
+ * @return The kind of the lesson.
+ */
+lesson_type_t get_lesson_type(const lesson_t* lesson);
+
 /**
  * Retrieves a lesson by its index for the current date.
  * @param  index Index of the lesson to retrieve.
- * @return The lesson_t structure containing lesson details.
+ * @return Pointer to the lesson, or NULL if the index is out of range.
  */
-lesson_t get_lesson(int index);
+const lesson_t* get_lesson(int index);
 
 /**
  * Gets the total number of lessons for the current date.
@@ -35,14 +252,22 @@ int get_lesson_count(void);
  * @param date  Pointer to a struct tm containing the date to query (year, month, day).
  * @return The number of lessons for the specified date.
  */
-int get_lesson_count_for_date(struct tm* date);
+int get_lesson_count_for_date(const struct tm* date);
+
+/**
+ * Gets all lessons of a specified date, sorted by start time.
+ * @param date   Pointer to a struct tm containing the date to query (year, month, day).
+ * @param count  Receives the number of lessons.
+ * @return Pointer to the first lesson, or NULL if there are none. Valid while the active schedule is.
+ */
+const lesson_t* get_lessons_for_date(const struct tm* date, int* count);
 
 /**
  * Retrieves a lesson by its index for a specified date.
  * @param date  Pointer to a struct tm containing the date to query (year, month, day).
  * @param index  Index of the lesson to retrieve.
- * @return The lesson_t structure containing lesson details.
+ * @return Pointer to the lesson, or NULL if the index is out of range.
  */
-lesson_t get_lesson_for_date(struct tm* date, int index);
+const lesson_t* get_lesson_for_date(const struct tm* date, int index);
 
 #endif
@@ -0,0 +1,156 @@
+﻿#include "schedule_file.h"
+#include <lvgl/lvgl.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static void free_image(void* image, void* user_data)
+{
+    (void)user_data;
+    lv_free(image);
+}
+
+#ifdef _WIN32
+
+static void unmap_image(void* image, void* user_data)
+{
+    UnmapViewOfFile(image);
+    CloseHandle((HANDLE)user_data);
+}
+
+schedule_t* map_schedule_file(const char* path)
+{
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= UINT32_MAX)
+    {
+        mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(file); // The mapping keeps the file open
+    if (!mapping) return NULL;
+
+    void* image = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!image)
+    {
+        CloseHandle(mapping);
+        return NULL;
+    }
+
+    schedule_t* schedule = open_schedule_image(image, (uint32_t)size.QuadPart, unmap_image, mapping);
+    if (!schedule)
+    {
+        unmap_image(image, mapping);
+    }
+    return schedule;
+}
+
+schedule_t* load_schedule_file(const char* path)
+{
+    // A mapped view would make the rename that publishes a new version fail with ERROR_USER_MAPPED_FILE,
+    // so the file is only open while it is read
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER size;
+    void* image = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && size.QuadPart <= UINT32_MAX)
+    {
+        image = lv_malloc((size_t)size.QuadPart);
+    }
+
+    DWORD read = 0;
+    if (image && (!ReadFile(file, image, (DWORD)size.QuadPart, &read, NULL) || read != (DWORD)size.QuadPart))
+    {
+        lv_free(image);
+        image = NULL;
+    }
+    CloseHandle(file);
+    if (!image) return NULL;
+
+    schedule_t* schedule = open_schedule_image(image, (uint32_t)size.QuadPart, free_image, NULL);
+    if (!schedule)
+    {
+        lv_free(image);
+    }
+    return schedule;
+}
+
+#else
+
+static void unmap_image(void* image, void* user_data)
+{
+    munmap(image, (size_t)(uintptr_t)user_data);
+}
+
+schedule_t* map_schedule_file(const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void* image = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= UINT32_MAX)
+    {
+        image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // The mapping keeps the file open
+    if (image == MAP_FAILED) return NULL;
+
+    size_t size = (size_t)st.st_size;
+    schedule_t* schedule = open_schedule_image(image, (uint32_t)size, unmap_image, (void*)(uintptr_t)size);
+    if (!schedule)
+    {
+        munmap(image, size);
+    }
+    return schedule;
+}
+
+schedule_t* load_schedule_file(const char* path)
+{
+    // Renaming a new file over the mapped one keeps the old pages valid until they are unmapped
+    return map_schedule_file(path);
+}
+
+#endif
+
+schedule_t* read_schedule_file(const char* path)
+{
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return NULL;
+
+    uint32_t size = 0;
+    void* image = NULL;
+    if (lv_fs_seek(&file, 0, LV_FS_SEEK_END) == LV_FS_RES_OK &&
+        lv_fs_tell(&file, &size) == LV_FS_RES_OK && size > 0 &&
+        lv_fs_seek(&file, 0, LV_FS_SEEK_SET) == LV_FS_RES_OK)
+    {
+        image = lv_malloc(size);
+    }
+
+    uint32_t read = 0;
+    if (image && (lv_fs_read(&file, image, size, &read) != LV_FS_RES_OK || read != size))
+    {
+        lv_free(image);
+        image = NULL;
+    }
+    lv_fs_close(&file);
+    if (!image) return NULL;
+
+    schedule_t* schedule = open_schedule_image(image, size, free_image, NULL);
+    if (!schedule)
+    {
+        lv_free(image);
+    }
+    return schedule;
+}
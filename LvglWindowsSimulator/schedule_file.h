@@ -0,0 +1,42 @@
+﻿#ifndef SCHEDULE_FILE_H
+#define SCHEDULE_FILE_H
+
+#include "schedule_data.h"
+
+/**
+ * Schedule file loaded at startup, relative to the working directory.
+ * Built from CSV or JSON by tools/schedule_converter.py.
+ */
+#ifndef SCHEDULE_FILE_PATH
+#define SCHEDULE_FILE_PATH "schedule.bin"
+#endif
+
+/**
+ * Opens a schedule file by memory-mapping it.
+ * The lessons are served straight from the mapping, nothing is parsed or copied,
+ * and pages are only read when a day is looked up.
+ * @param path  Path of the file in the native file system.
+ * @return The schedule, or NULL if the file cannot be mapped or is not a valid schedule file.
+ */
+schedule_t* map_schedule_file(const char* path);
+
+/**
+ * Opens a schedule file that may be replaced while it is in use, see create_schedule_watcher().
+ * On POSIX systems the file is memory-mapped. On Windows it is read into a single buffer, because a
+ * mapped file cannot be replaced by a rename.
+ * Writers must publish a new version by renaming it over the old file. Truncating or rewriting the file
+ * in place would crash the application on POSIX systems, as the mapped pages disappear.
+ * @param path  Path of the file in the native file system.
+ * @return The schedule, or NULL if the file cannot be opened or is not a valid schedule file.
+ */
+schedule_t* load_schedule_file(const char* path);
+
+/**
+ * Opens a schedule file by reading it into a single buffer through lv_fs.
+ * Used where memory mapping is not available; the buffer is used as is, without parsing.
+ * @param path  lv_fs path of the file, including the drive letter (e.g. "A:schedule.bin").
+ * @return The schedule, or NULL if the file cannot be read or is not a valid schedule file.
+ */
+schedule_t* read_schedule_file(const char* path);
+
+#endif
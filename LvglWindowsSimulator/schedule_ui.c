@@ -5,52 +5,618 @@
 #include <time.h>
 #include <string.h>
 
-#define MAX_NUMBER_OF_LESSONS 16
+#define ROW_POOL_SIZE 16    // Lesson blocks allocated at first, the pool grows when more lessons are in range
+#define ROW_MARGIN 200      // Pixels above and below the visible part of the list that are kept filled
+#define ROW_GAP 15          // Space between two lesson blocks
+#define TEXT_HEIGHT_CACHE_SIZE 256
 
-typedef struct {
-    const char* type;
-    uint32_t color;
-} TypeColor;
-
-// Dictionary of lesson types and their background colors
-static const TypeColor type_colors[] = {
-    {"Зачет", 0xe91e63},
-    {"Экзамен", 0xe91e63},
-    {"Дифференцированный зачет", 0xe91e63},
-    {"Консультация к промежуточной аттестации", 0x9e5fa1},
-    {"-", 0x407ab2},
-    {"Курсовая работа", 0x407ab2},
-    {"Лекции", 0x276093},
-    {"Практические занятия и семинары", 0xff8f00},
-    {"Лабораторные занятия", 0x3e8470},
-    {NULL, 0xCCCCCC}
+// Background colors of the lesson type badges, in lesson_type_t order
+static const uint32_t type_colors[LESSON_TYPE_COUNT] = {
+    0xCCCCCC,   // Other
+    0xe91e63,   // Зачет
+    0xe91e63,   // Экзамен
+    0xe91e63,   // Дифференцированный зачет
+    0x9e5fa1,   // Консультация к промежуточной аттестации
+    0x407ab2,   // -
+    0x407ab2,   // Курсовая работа
+    0x276093,   // Лекции
+    0xff8f00,   // Практические занятия и семинары
+    0x3e8470    // Лабораторные занятия
 };
 
+/**
+ * Widgets of a single lesson block, kept alive between display updates and while scrolling
+ * together with the values they currently show.
+ */
+typedef struct {
+    lv_obj_t* block;
+    lv_obj_t* progress_bar;
+    lv_obj_t* start_time_label;
+    lv_obj_t* end_time_label;
+    lv_obj_t* type_label;
+    lv_obj_t* subject_label;
+    lv_obj_t* line;
+    lv_obj_t* teacher_label;
+    const lv_style_t* type_style; // Badge style currently applied to the type label
+    lesson_t lesson;        // Lesson currently shown by the row
+    int progress;           // Progress bar value currently shown by the row
+    int index;              // Index of the lesson shown by the row, -1 if the row is free
+} LessonRow;
+
+// Styles shared by all lesson blocks, so the widgets carry no local styles of their own
+static lv_style_t block_style;
+static lv_style_t bar_style;
+static lv_style_t bar_indicator_style;
+static lv_style_t start_time_style;
+static lv_style_t end_time_style;
+static lv_style_t type_style;
+static lv_style_t type_styles[LESSON_TYPE_COUNT]; // Badge color of each lesson type
+static lv_style_t subject_style;
+static lv_style_t line_style;
+static lv_style_t teacher_style;
+
 static lv_obj_t* list_container;
-static lv_obj_t* progress_bars[MAX_NUMBER_OF_LESSONS]; // Store lessons progress bars
+static LessonRow* lesson_rows;              // Lesson blocks near the visible part of the list, in no particular order
+static int lesson_row_count;
+static int lesson_row_capacity;
+static const lesson_t* day_lessons;         // Lessons of the displayed date
+static int day_lesson_count;
+static int32_t* lesson_offsets;             // Top of each lesson in the list, the last entry is the list height plus a gap
+static int lesson_offset_capacity;
+static int32_t empty_row_height;            // Height of a block whose labels are empty
+static int32_t empty_text_height;           // Height of an empty label
+static struct {
+    schedule_string_t id;                   // Measured string, 0 marks an empty slot
+    int32_t height;
+} text_heights[TEXT_HEIGHT_CACHE_SIZE];     // Heights of the texts of the labels that wrap, by label and string
+static const schedule_t* measured_schedule; // Schedule the cached heights belong to
+static int is_past_date;                    // The displayed date is before the current date
+static int is_future_date;                  // The displayed date is after the current date
+static int current_minutes;                 // Time of day of the last update
 static struct tm current_display_date;
+static schedule_ui_stats_t stats;
+static const schedule_t* reloaded_schedule; // Schedule the rows refer to while a reload is applied
+static int tracked_lesson;                  // First lesson of the displayed day that has not finished yet
+static progress_stats_t progress_stats;
+static uint32_t invalidated_pixels;         // Pixels invalidated on the display so far
+
+static int get_start_minutes(const lesson_t* lesson)
+{
+    return lesson->start_hour * 60 + lesson->start_minute;
+}
+
+static int get_end_minutes(const lesson_t* lesson)
+{
+    return lesson->end_hour * 60 + lesson->end_minute;
+}
+
+/**
+ * Calculates the progress of a lesson on the current day.
+ */
+static int get_progress(const lesson_t* lesson, int current_minutes)
+{
+    int start_minutes = get_start_minutes(lesson);
+    int end_minutes = get_end_minutes(lesson);
+    if (current_minutes >= end_minutes)
+    {
+        return 100;
+    }
+    if (current_minutes < start_minutes)
+    {
+        return 0;
+    }
+    return ((current_minutes - start_minutes) * 100) / (end_minutes - start_minutes);
+}
+
+static void set_row_progress(LessonRow* row, int progress)
+{
+    if (row->progress != progress)
+    {
+        lv_bar_set_value(row->progress_bar, progress, LV_ANIM_ON);
+        row->progress = progress;
+        progress_stats.bars_updated++;
+    }
+}
+
+static void count_invalidated_area(lv_event_t* e)
+{
+    const lv_area_t* area = lv_event_get_param(e);
+    invalidated_pixels += lv_area_get_size(area);
+}
+
+static int is_same_string(schedule_string_t shown, schedule_string_t id)
+{
+    // Strings are interned, so comparing identifiers is enough unless they come from different schedules
+    if (!reloaded_schedule) return shown == id;
+    return strcmp(get_schedule_string(reloaded_schedule, shown), get_lesson_string(id)) == 0;
+}
+
+static lv_obj_t* count_created(lv_obj_t* obj)
+{
+    stats.objects_created++;
+    return obj;
+}
+
+static void count_deleted(lv_event_t* e)
+{
+    // The children of a block are still there when the block gets the event
+    lv_obj_t* block = lv_event_get_current_target(e);
+    stats.objects_deleted += 1 + lv_obj_get_child_count(block);
+}
+
+static void set_time_text(lv_obj_t* label, int hour, int minute)
+{
+    char buffer[16]; // The times come from uint8_t fields, so even "255:255" has to fit
+    snprintf(buffer, sizeof(buffer), "%02d:%02d", hour, minute);
+    lv_label_set_text(label, buffer);
+}
+
+/**
+ * Initializes the styles shared by all lesson blocks.
+ */
+static void init_styles(void)
+{
+    lv_style_init(&block_style);
+    lv_style_set_width(&block_style, 630);
+    lv_style_set_height(&block_style, LV_SIZE_CONTENT);
+    //lv_style_set_bg_color(&block_style, lv_color_hex(0xF0F0F0));
+    lv_style_set_border_width(&block_style, 1);
+    lv_style_set_border_color(&block_style, lv_color_hex(0x525252));
+    lv_style_set_radius(&block_style, 0);
+    lv_style_set_align(&block_style, LV_ALIGN_TOP_MID);
+    lv_style_set_layout(&block_style, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&block_style, LV_FLEX_FLOW_COLUMN);
+    lv_style_set_flex_main_place(&block_style, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_cross_place(&block_style, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(&block_style, LV_FLEX_ALIGN_CENTER);
+
+    lv_style_init(&bar_style);
+    lv_style_set_width(&bar_style, 600);
+    lv_style_set_height(&bar_style, 30);
+    lv_style_set_radius(&bar_style, 0);
+    lv_style_set_bg_color(&bar_style, lv_color_hex(0x90EE90));
+
+    lv_style_init(&bar_indicator_style);
+    lv_style_set_radius(&bar_indicator_style, 0);
+    lv_style_set_bg_color(&bar_indicator_style, lv_color_hex(0x228B22));
+
+    lv_style_init(&start_time_style);
+    lv_style_set_text_font(&start_time_style, &lv_font_my_montserrat_20);
+    //lv_style_set_text_color(&start_time_style, lv_color_hex(0x2fb255));
+    lv_style_set_text_color(&start_time_style, lv_color_hex(0x000000));
+    lv_style_set_text_align(&start_time_style, LV_TEXT_ALIGN_LEFT);
+
+    lv_style_init(&end_time_style);
+    lv_style_set_text_font(&end_time_style, &lv_font_my_montserrat_20);
+    //lv_style_set_text_color(&end_time_style, lv_color_hex(0x2fb255));
+    lv_style_set_text_color(&end_time_style, lv_color_hex(0x000000));
+    lv_style_set_text_align(&end_time_style, LV_TEXT_ALIGN_RIGHT);
+
+    lv_style_init(&type_style);
+    lv_style_set_width(&type_style, 600);
+    lv_style_set_text_font(&type_style, &lv_font_my_montserrat_20);
+    lv_style_set_text_color(&type_style, lv_color_hex(0xffffff));
+    lv_style_set_text_align(&type_style, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_bg_opa(&type_style, LV_OPA_COVER);
+    lv_style_set_pad_all(&type_style, 5);
+    //lv_style_set_radius(&type_style, 4);
+
+    for (int i = 0; i < LESSON_TYPE_COUNT; i++)
+    {
+        lv_style_init(&type_styles[i]);
+        lv_style_set_bg_color(&type_styles[i], lv_color_hex(type_colors[i]));
+    }
+
+    lv_style_init(&subject_style);
+    lv_style_set_width(&subject_style, 600);
+    lv_style_set_text_font(&subject_style, &lv_font_my_montserrat_20);
+    //lv_style_set_text_color(&subject_style, lv_color_hex(0x525252));
+    lv_style_set_text_color(&subject_style, lv_color_hex(0x000000));
+    lv_style_set_pad_top(&subject_style, 5);
+    lv_style_set_pad_bottom(&subject_style, 10);
+
+    lv_style_init(&line_style);
+    lv_style_set_width(&line_style, 600);
+    lv_style_set_line_color(&line_style, lv_color_hex(0x000000));
+    lv_style_set_line_width(&line_style, 1);
+    lv_style_set_line_dash_width(&line_style, 2);
+    lv_style_set_line_dash_gap(&line_style, 2);
+
+    lv_style_init(&teacher_style);
+    lv_style_set_width(&teacher_style, 600);
+    lv_style_set_text_font(&teacher_style, &lv_font_my_montserrat_20);
+    lv_style_set_text_color(&teacher_style, lv_color_hex(0x000000));
+}
+
+/**
+ * Makes the next update_lesson_row() set every widget of a row, whatever lesson it showed before.
+ */
+static void forget_row_lesson(LessonRow* row)
+{
+    // Labels show the empty string (identifier 0) and no time
+    memset(&row->lesson, 0, sizeof(row->lesson));
+    row->lesson.start_hour = UINT8_MAX;
+    row->lesson.end_hour = UINT8_MAX;
+}
+
+/**
+ * Creates the widgets of an empty lesson block at the end of the list.
+ * Texts, colors and the progress value are filled in by update_lesson_row().
+ */
+static void create_lesson_row(LessonRow* row)
+{
+    // Create block container
+    lv_obj_t* block = count_created(lv_obj_create(list_container));
+    lv_obj_add_style(block, &block_style, 0);
+    lv_obj_add_event_cb(block, count_deleted, LV_EVENT_DELETE, NULL);
+    row->block = block;
+
+    // Progress bar with striped pattern
+    //LV_IMAGE_DECLARE(img_skew_strip);
+    //static lv_style_t style_indic;
+    //lv_style_init(&style_indic);
+    //lv_style_set_bg_image_src(&style_indic, &img_skew_strip);
+    //lv_style_set_bg_image_tiled(&style_indic, true);
+    //lv_style_set_bg_image_opa(&style_indic, LV_OPA_30);
+
+    //static lv_style_t style_main;
+    //lv_style_init(&style_main);
+    //lv_style_set_bg_image_src(&style_main, &img_skew_strip);
+    //lv_style_set_bg_image_tiled(&style_main, true);
+    //lv_style_set_bg_image_opa(&style_main, LV_OPA_50);
+
+    //lv_obj_t* progress_bar = lv_bar_create(block);
+    //lv_obj_add_style(progress_bar, &style_indic, LV_PART_INDICATOR);
+    //lv_obj_add_style(progress_bar, &style_main, LV_PART_MAIN);
+    //lv_obj_set_size(progress_bar, 600, 30);
+    //lv_bar_set_range(progress_bar, 0, 100);
+    //lv_obj_set_style_radius(progress_bar, 0, LV_PART_MAIN);
+    //lv_obj_set_style_radius(progress_bar, 0, LV_PART_INDICATOR);
+    //lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x90EE90), LV_PART_MAIN); // Fallback green
+    //lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x228B22), LV_PART_INDICATOR); // Fallback green
+    ////lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0xCCCCCC), 0);
+    //row->progress_bar = progress_bar;
+
+    // Progress bar
+    lv_obj_t* progress_bar = count_created(lv_bar_create(block));
+    lv_obj_add_style(progress_bar, &bar_style, LV_PART_MAIN);
+    lv_obj_add_style(progress_bar, &bar_indicator_style, LV_PART_INDICATOR);
+    lv_bar_set_range(progress_bar, 0, 100);
+    row->progress_bar = progress_bar;
+    row->progress = 0;
+
+    // Start time label
+    lv_obj_t* start_time_label = count_created(lv_label_create(block));
+    lv_label_set_text(start_time_label, "");
+    lv_obj_add_style(start_time_label, &start_time_style, 0);
+    lv_obj_add_flag(start_time_label, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align_to(start_time_label, progress_bar, LV_ALIGN_LEFT_MID, 5, -1);
+    row->start_time_label = start_time_label;
+
+    // End time label
+    lv_obj_t* end_time_label = count_created(lv_label_create(block));
+    lv_label_set_text(end_time_label, "");
+    lv_obj_add_style(end_time_label, &end_time_style, 0);
+    lv_obj_add_flag(end_time_label, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align_to(end_time_label, progress_bar, LV_ALIGN_RIGHT_MID, -5, -1);
+    row->end_time_label = end_time_label;
+
+    // Type label, its badge color is added by update_lesson_row()
+    lv_obj_t* type_label = count_created(lv_label_create(block));
+    lv_label_set_text(type_label, "");
+    lv_obj_add_style(type_label, &type_style, 0);
+    row->type_label = type_label;
+    row->type_style = NULL;
+
+    // Subject label (WRAP)
+    lv_obj_t* subject_label = count_created(lv_label_create(block));
+    lv_label_set_text(subject_label, "");
+    lv_label_set_long_mode(subject_label, LV_LABEL_LONG_WRAP);
+    lv_obj_add_style(subject_label, &subject_style, 0);
+    row->subject_label = subject_label;
+
+    // Dashed line
+    static lv_point_precise_t line_points[] = { {0, 0}, {600, 0} };
+    lv_obj_t* line = count_created(lv_line_create(block));
+    lv_line_set_points(line, line_points, 2);
+    lv_obj_add_style(line, &line_style, 0);
+    //lv_obj_center(line);
+    row->line = line;
+
+    // Teacher label
+    lv_obj_t* teacher_label = count_created(lv_label_create(block));
+    lv_label_set_text(teacher_label, "");
+    lv_obj_add_style(teacher_label, &teacher_style, 0);
+    row->teacher_label = teacher_label;
+
+    forget_row_lesson(row);
+    row->index = -1;
+}
+
+/**
+ * Brings a row in line with a lesson, touching only the widgets whose content differs.
+ */
+static void update_lesson_row(LessonRow* row, const lesson_t* lesson, int progress)
+{
+    if (row->progress != progress)
+    {
+        lv_bar_set_value(row->progress_bar, progress, LV_ANIM_ON);
+        row->progress = progress;
+        stats.properties_updated++;
+    }
+
+    if (row->lesson.start_hour != lesson->start_hour || row->lesson.start_minute != lesson->start_minute)
+    {
+        set_time_text(row->start_time_label, lesson->start_hour, lesson->start_minute);
+        stats.properties_updated++;
+    }
+
+    if (row->lesson.end_hour != lesson->end_hour || row->lesson.end_minute != lesson->end_minute)
+    {
+        set_time_text(row->end_time_label, lesson->end_hour, lesson->end_minute);
+        stats.properties_updated++;
+    }
+
+    if (!is_same_string(row->lesson.type, lesson->type))
+    {
+        lv_label_set_text(row->type_label, get_lesson_string(lesson->type));
+        const lv_style_t* style = &type_styles[get_lesson_type(lesson)];
+        if (row->type_style != style)
+        {
+            if (row->type_style)
+            {
+                lv_obj_replace_style(row->type_label, row->type_style, style, 0);
+            }
+            else
+            {
+                lv_obj_add_style(row->type_label, style, 0);
+            }
+            row->type_style = style;
+        }
+        stats.properties_updated += 2;
+    }
+
+    if (!is_same_string(row->lesson.subject, lesson->subject))
+    {
+        lv_label_set_text(row->subject_label, get_lesson_string(lesson->subject));
+        stats.properties_updated++;
+    }
+
+    if (!is_same_string(row->lesson.teacher, lesson->teacher))
+    {
+        lv_label_set_text(row->teacher_label, get_lesson_string(lesson->teacher));
+        stats.properties_updated++;
+    }
+
+    row->lesson = *lesson;
+}
 
 void update_schedule_display(struct tm* display_date)
 {
-    if (!list_container || !display_date) return;
+    time_t now = time(NULL);
+    update_schedule_display_at(display_date, localtime(&now));
+}
+
+/**
+ * Measures the height of a text shown by a label of the lesson blocks.
+ */
+static int32_t get_text_height(lv_obj_t* label, const char* text)
+{
+    lv_point_t size;
+    lv_text_get_size(&size, text, lv_obj_get_style_text_font(label, LV_PART_MAIN),
+        lv_obj_get_style_text_letter_space(label, LV_PART_MAIN), lv_obj_get_style_text_line_space(label, LV_PART_MAIN),
+        lv_obj_get_content_width(label), LV_TEXT_FLAG_NONE);
+    return size.y;
+}
+
+/**
+ * Measures the height of a string of the active schedule shown by a label, caching the result.
+ * @param slot  Index of the label in the block, so the labels of different widths use their own entries.
+ */
+static int32_t get_string_height(lv_obj_t* label, int slot, schedule_string_t id)
+{
+    if (id == 0) return empty_text_height;
+
+    int index = (id * 3 + slot) % TEXT_HEIGHT_CACHE_SIZE;
+    if (text_heights[index].id != id)
+    {
+        text_heights[index].id = id;
+        text_heights[index].height = get_text_height(label, get_lesson_string(id));
+    }
+    return text_heights[index].height;
+}
+
+/**
+ * Calculates the height of the block of a lesson without creating it.
+ * Only the labels that wrap their text change the height of a block.
+ */
+static int32_t get_lesson_height(const lesson_t* lesson)
+{
+    const LessonRow* row = &lesson_rows[0]; // Any block will do, they all have the same label widths
+    return empty_row_height +
+        get_string_height(row->type_label, 0, lesson->type) - empty_text_height +
+        get_string_height(row->subject_label, 1, lesson->subject) - empty_text_height +
+        get_string_height(row->teacher_label, 2, lesson->teacher) - empty_text_height;
+}
+
+/**
+ * Lays out the lessons of the displayed date.
+ * @return 0 if out of memory.
+ */
+static int update_lesson_offsets(void)
+{
+    if (day_lesson_count + 1 > lesson_offset_capacity)
+    {
+        int capacity = lesson_offset_capacity ? lesson_offset_capacity : 32;
+        while (capacity < day_lesson_count + 1)
+        {
+            capacity *= 2;
+        }
+        int32_t* offsets = lv_realloc(lesson_offsets, sizeof(int32_t) * capacity);
+        if (!offsets) return 0;
+        lesson_offsets = offsets;
+        lesson_offset_capacity = capacity;
+    }
 
-    // Clear existing content
-    lv_obj_clean(list_container);
-    for (int i = 0; i < MAX_NUMBER_OF_LESSONS; i++)
+    // String identifiers are only unique within a schedule
+    if (measured_schedule != get_active_schedule())
     {
-        progress_bars[i] = NULL;
+        memset(text_heights, 0, sizeof(text_heights));
+        measured_schedule = get_active_schedule();
     }
 
+    int32_t offset = 0;
+    for (int i = 0; i < day_lesson_count; i++)
+    {
+        lesson_offsets[i] = offset;
+        offset += get_lesson_height(&day_lessons[i]) + ROW_GAP;
+    }
+    lesson_offsets[day_lesson_count] = offset;
+    return 1;
+}
+
+static int get_lesson_progress(int index)
+{
+    if (is_past_date) return 100;
+    if (is_future_date) return 0;
+    return get_progress(&day_lessons[index], current_minutes);
+}
+
+static LessonRow* find_row(int index)
+{
+    for (int i = 0; i < lesson_row_count; i++)
+    {
+        if (lesson_rows[i].index == index)
+        {
+            return &lesson_rows[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Takes a free row, creating a new one if all rows are in use.
+ * The number of rows in range depends on the list height and on how short the lessons are, so the pool
+ * grows on demand.
+ * @return The row, or NULL if out of memory.
+ */
+static LessonRow* get_free_row(void)
+{
+    LessonRow* row = find_row(-1);
+    if (row)
+    {
+        stats.rows_reused++;
+        return row;
+    }
+
+    if (lesson_row_count == lesson_row_capacity)
+    {
+        int capacity = lesson_row_capacity ? lesson_row_capacity * 2 : ROW_POOL_SIZE;
+        LessonRow* rows = lv_realloc(lesson_rows, sizeof(LessonRow) * capacity);
+        if (!rows)
+        {
+            LV_LOG_WARN("Out of memory for more than %d lesson blocks", lesson_row_count);
+            return NULL;
+        }
+        lesson_rows = rows;
+        lesson_row_capacity = capacity;
+    }
+
+    row = &lesson_rows[lesson_row_count++];
+    create_lesson_row(row);
+    return row;
+}
+
+/**
+ * Binds the rows to the lessons in and around the visible part of the list.
+ * Rows that scrolled out of range are hidden and reused for the lessons that scrolled in.
+ * @param refresh  Nonzero to bring the rows that stay in range in line with their lessons too.
+ */
+static void update_visible_rows(int refresh)
+{
+    int32_t scroll_y = lv_obj_get_scroll_y(list_container);
+    int32_t top = scroll_y - ROW_MARGIN;
+    int32_t bottom = scroll_y + lv_obj_get_content_height(list_container) + ROW_MARGIN;
+
+    // First lesson whose block reaches below the top of the range
+    int low = 0, high = day_lesson_count;
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+        if (lesson_offsets[mid + 1] <= top)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    int first = low;
+    int last = first;
+    while (last < day_lesson_count && lesson_offsets[last] < bottom)
+    {
+        last++;
+    }
+
+    for (int i = 0; i < lesson_row_count; i++)
+    {
+        LessonRow* row = &lesson_rows[i];
+        if (row->index >= 0 && (row->index < first || row->index >= last))
+        {
+            row->index = -1;
+            lv_obj_add_flag(row->block, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    for (int i = first; i < last; i++)
+    {
+        LessonRow* row = find_row(i);
+        if (row)
+        {
+            if (!refresh) continue;
+            stats.rows_reused++;
+        }
+        else
+        {
+            row = get_free_row();
+            if (!row) break; // Already logged, the remaining lessons stay blank
+            row->index = i;
+            lv_obj_remove_flag(row->block, LV_OBJ_FLAG_HIDDEN);
+        }
+        lv_obj_set_y(row->block, lesson_offsets[i]);
+        update_lesson_row(row, &day_lessons[i], get_lesson_progress(i));
+    }
+}
+
+static void scroll_list(lv_event_t* e)
+{
+    (void)e;
+    update_visible_rows(0);
+}
+
+static void get_list_size(lv_event_t* e)
+{
+    // The blocks of the lessons out of range do not exist, so the list reports their height itself
+    lv_point_t* size = lv_event_get_param(e);
+    int32_t height = day_lesson_count ? lesson_offsets[day_lesson_count] - ROW_GAP : 0;
+    size->y = LV_MAX(size->y, height);
+}
+
+void update_schedule_display_at(const struct tm* display_date, const struct tm* current_time)
+{
+    if (!list_container || !display_date) return;
+
+    memset(&stats, 0, sizeof(stats));
+
     // Store display date
     memcpy(&current_display_date, display_date, sizeof(struct tm));
 
-    // Get current time
-    time_t now = time(NULL);
-    struct tm* current_time = localtime(&now);
-    int current_minutes = current_time->tm_hour * 60 + current_time->tm_min;
+    current_minutes = current_time->tm_hour * 60 + current_time->tm_min;
 
     // Compare dates (ignoring time)
-    int is_past_date = 0, is_future_date = 0;
+    is_past_date = 0;
+    is_future_date = 0;
     if (display_date->tm_year < current_time->tm_year ||
         (display_date->tm_year == current_time->tm_year && display_date->tm_mon < current_time->tm_mon) ||
         (display_date->tm_year == current_time->tm_year && display_date->tm_mon == current_time->tm_mon &&
@@ -66,172 +632,34 @@ void update_schedule_display(struct tm* display_date)
         is_future_date = 1;
     }
 
-    // Get total number of lessons
-    int lesson_count = get_lesson_count(); // Update to get_lesson_count_for_date(&current_display_date)
+    // Lay out all lessons, but create blocks only for the ones near the visible part of the list
+    day_lessons = get_lessons_for_date(&current_display_date, &day_lesson_count);
+    if (!update_lesson_offsets())
+    {
+        day_lesson_count = 0;
+    }
+    lv_obj_refresh_self_size(list_container);
+    update_visible_rows(1);
 
-    // Create a block for each lesson
-    for (int i = 0; i < lesson_count; i++)
+    // Start tracking at the first lesson that has not finished yet
+    tracked_lesson = is_past_date ? day_lesson_count : 0;
+    while (!is_past_date && !is_future_date && tracked_lesson < day_lesson_count &&
+           current_minutes > get_end_minutes(&day_lessons[tracked_lesson]))
     {
-        lesson_t lesson = get_lesson(i); // Update to get_lesson_for_date(&current_display_date, i)
-
-        // Create block container
-        lv_obj_t* block = lv_obj_create(list_container);
-        lv_obj_set_size(block, 630, LV_SIZE_CONTENT);
-        //lv_obj_set_style_bg_color(block, lv_color_hex(0xF0F0F0), 0);
-        lv_obj_set_style_border_width(block, 1, 0);
-        lv_obj_set_style_border_color(block, lv_color_hex(0x525252), 0);
-        lv_obj_set_style_radius(block, 0, 0);
-        lv_obj_set_layout(block, LV_LAYOUT_FLEX);
-        lv_obj_set_flex_flow(block, LV_FLEX_FLOW_COLUMN);
-        lv_obj_set_flex_align(block, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-
-        // Progress bar with striped pattern
-        //LV_IMAGE_DECLARE(img_skew_strip);
-        //static lv_style_t style_indic;
-        //lv_style_init(&style_indic);
-        //lv_style_set_bg_image_src(&style_indic, &img_skew_strip);
-        //lv_style_set_bg_image_tiled(&style_indic, true);
-        //lv_style_set_bg_image_opa(&style_indic, LV_OPA_30);
-
-        //static lv_style_t style_main;
-        //lv_style_init(&style_main);
-        //lv_style_set_bg_image_src(&style_main, &img_skew_strip);
-        //lv_style_set_bg_image_tiled(&style_main, true);
-        //lv_style_set_bg_image_opa(&style_main, LV_OPA_50);
-
-        //lv_obj_t* progress_bar = lv_bar_create(block);
-        //lv_obj_add_style(progress_bar, &style_indic, LV_PART_INDICATOR);
-        //lv_obj_add_style(progress_bar, &style_main, LV_PART_MAIN);
-        //lv_obj_set_size(progress_bar, 600, 30);
-        //lv_bar_set_range(progress_bar, 0, 100);
-        //lv_obj_set_style_radius(progress_bar, 0, LV_PART_MAIN);
-        //lv_obj_set_style_radius(progress_bar, 0, LV_PART_INDICATOR);
-        //lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x90EE90), LV_PART_MAIN); // Fallback green
-        //lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x228B22), LV_PART_INDICATOR); // Fallback green
-        ////lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0xCCCCCC), 0);
-        //progress_bars[i] = progress_bar;
-
-        // Progress bar
-        lv_obj_t* progress_bar = lv_bar_create(block);
-        lv_obj_set_size(progress_bar, 600, 30);
-        lv_bar_set_range(progress_bar, 0, 100);
-        lv_obj_set_style_radius(progress_bar, 0, LV_PART_MAIN);
-        lv_obj_set_style_radius(progress_bar, 0, LV_PART_INDICATOR);
-        lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x90EE90), LV_PART_MAIN);
-        lv_obj_set_style_bg_color(progress_bar, lv_color_hex(0x228B22), LV_PART_INDICATOR);
-        progress_bars[i] = progress_bar;
-
-        // Calculate progress
-        int progress = 0;
-        if (is_past_date)
-        {
-            progress = 100;
-        }
-        else if (is_future_date)
-        {
-            progress = 0;
-        }
-        else
-        {
-            int start_minutes = lesson.start_hour * 60 + lesson.start_minute;
-            int end_minutes = lesson.end_hour * 60 + lesson.end_minute;
-            if (current_minutes > end_minutes)
-            {
-                progress = 100;
-            }
-            else if (current_minutes >= start_minutes && current_minutes <= end_minutes)
-            {
-                progress = ((current_minutes - start_minutes) * 100) / (end_minutes - start_minutes);
-            }
-        }
-        lv_bar_set_value(progress_bar, progress, LV_ANIM_ON);
-
-        char buffer[6];
-
-        // Start time label
-        lv_obj_t* start_time_label = lv_label_create(block);
-        snprintf(buffer, sizeof(buffer), "%02d:%02d", lesson.start_hour, lesson.start_minute);
-        lv_label_set_text(start_time_label, buffer);
-        lv_obj_set_style_text_font(start_time_label, &lv_font_my_montserrat_20, 0);
-        //lv_obj_set_style_text_color(start_time_label, lv_color_hex(0x2fb255), 0);
-        lv_obj_set_style_text_color(start_time_label, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_text_align(start_time_label, LV_TEXT_ALIGN_LEFT, 0);
-        lv_obj_add_flag(start_time_label, LV_OBJ_FLAG_FLOATING);
-        lv_obj_align_to(start_time_label, progress_bar, LV_ALIGN_LEFT_MID, 5, -1);
-
-        // End time label
-        lv_obj_t* end_time_label = lv_label_create(block);
-        snprintf(buffer, sizeof(buffer), "%02d:%02d", lesson.end_hour, lesson.end_minute);
-        lv_label_set_text(end_time_label, buffer);
-        lv_obj_set_style_text_font(end_time_label, &lv_font_my_montserrat_20, 0);
-        //lv_obj_set_style_text_color(end_time_label, lv_color_hex(0x2fb255), 0);
-        lv_obj_set_style_text_color(end_time_label, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_text_align(end_time_label, LV_TEXT_ALIGN_RIGHT, 0);
-        lv_obj_add_flag(end_time_label, LV_OBJ_FLAG_FLOATING);
-        lv_obj_align_to(end_time_label, progress_bar, LV_ALIGN_RIGHT_MID, -5, -1);
-
-        // Type label
-        lv_obj_t* type_label = lv_label_create(block);
-        lv_label_set_text(type_label, lesson.type);
-        //lv_obj_set_size(type_label, 600, 30);
-        lv_obj_set_width(type_label, 600);
-        lv_obj_set_style_text_font(type_label, &lv_font_my_montserrat_20, 0);
-        lv_obj_set_style_text_color(type_label, lv_color_hex(0xffffff), 0);
-        lv_obj_set_style_text_align(type_label, LV_TEXT_ALIGN_CENTER, 0);
-        lv_obj_set_style_bg_opa(type_label, LV_OPA_COVER, 0);
-        lv_obj_set_style_pad_all(type_label, 5, 0);
-        //lv_obj_set_style_radius(type_label, 4, 0);
-        
-        uint32_t bg_color = 0xCCCCCC; // Default color
-        for (size_t j = 0; type_colors[j].type != NULL; j++)
-        {
-            if (strcmp(lesson.type, type_colors[j].type) == 0)
-            {
-                bg_color = type_colors[j].color;
-                break;
-            }
-        }
-        lv_obj_set_style_bg_color(type_label, lv_color_hex(bg_color), 0);
-        
-        // Subject label (WRAP)
-        lv_obj_t* subject_label = lv_label_create(block);
-        lv_label_set_text(subject_label, lesson.subject);
-        lv_label_set_long_mode(subject_label, LV_LABEL_LONG_WRAP);
-        lv_obj_set_width(subject_label, 600);
-        lv_obj_set_style_text_font(subject_label, &lv_font_my_montserrat_20, 0);
-        //lv_obj_set_style_text_color(subject_label, lv_color_hex(0x525252), 0);
-        lv_obj_set_style_text_color(subject_label, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_pad_top(subject_label, 5, 0);
-        lv_obj_set_style_pad_bottom(subject_label, 10, 0);
-
-        // Dashed line
-        static lv_point_precise_t line_points[] = { {0, 0}, {600, 0} };
-        lv_obj_t* line = lv_line_create(block);
-        lv_line_set_points(line, line_points, 2);
-        lv_obj_set_style_line_color(line, lv_color_hex(0x000000), 0);
-        lv_obj_set_style_line_width(line, 1, 0);
-        lv_obj_set_style_line_dash_width(line, 2, 0);
-        lv_obj_set_style_line_dash_gap(line, 2, 0);
-        lv_obj_set_width(line, 600);
-        //lv_obj_center(line);
-
-        // Teacher label
-        lv_obj_t* teacher_label = lv_label_create(block);
-        lv_label_set_text(teacher_label, lesson.teacher);
-        lv_obj_set_width(teacher_label, 600);
-        lv_obj_set_style_text_font(teacher_label, &lv_font_my_montserrat_20, 0);
-        lv_obj_set_style_text_color(teacher_label, lv_color_hex(0x000000), 0);
+        tracked_lesson++;
     }
 }
 
 void update_progress_bar(void)
 {
-    if (!list_container) return;
-
-    // Get current time
     time_t now = time(NULL);
-    struct tm* current_time = localtime(&now);
-    int current_minutes = current_time->tm_hour * 60 + current_time->tm_min;
+    update_progress_bar_at(localtime(&now));
+}
+
+void update_progress_bar_at(const struct tm* current_time)
+{
+    memset(&progress_stats, 0, sizeof(progress_stats));
+    if (!list_container) return;
 
     // Check if displayed date is today
     int is_today = (current_display_date.tm_year == current_time->tm_year &&
@@ -239,34 +667,75 @@ void update_progress_bar(void)
                     current_display_date.tm_mday == current_time->tm_mday);
     if (!is_today) return;
 
-    // Get total number of lessons
-    int lesson_count = get_lesson_count(); // Update to get_lesson_count_for_date(&current_display_date)
+    current_minutes = current_time->tm_hour * 60 + current_time->tm_min;
+    uint32_t invalidated_before = invalidated_pixels;
 
-    // MIGHT BE OPTIMIZED
-    // Update progress bar of current lesson
-    for (int i = 0; i < lesson_count; i++)
+    // Complete the lessons that ended since the last tick and move on to the next one
+    while (tracked_lesson < day_lesson_count &&
+           current_minutes > get_end_minutes(&day_lessons[tracked_lesson]))
     {
-        if (progress_bars[i])
+        LessonRow* row = find_row(tracked_lesson);
+        if (row)
         {
-            lesson_t lesson = get_lesson(i); // Update to get_lesson_for_date(&current_display_date, i)
-            int start_minutes = lesson.start_hour * 60 + lesson.start_minute;
-            int end_minutes = lesson.end_hour * 60 + lesson.end_minute;
-            int progress = 0;
-            if (current_minutes > end_minutes)
-            {
-                progress = 100;
-            }
-            else if (current_minutes >= start_minutes && current_minutes <= end_minutes)
-            {
-                progress = ((current_minutes - start_minutes) * 100) / (end_minutes - start_minutes);
-            }
-            lv_bar_set_value(progress_bars[i], progress, LV_ANIM_ON);
+            set_row_progress(row, 100);
         }
+        tracked_lesson++;
+    }
+
+    // Only the bar of the running lesson moves, finished and future bars are left alone.
+    // Lessons without a block get their progress when they are scrolled into view.
+    LessonRow* row = find_row(tracked_lesson);
+    if (row && current_minutes >= get_start_minutes(&row->lesson))
+    {
+        set_row_progress(row, get_progress(&row->lesson, current_minutes));
     }
+
+    progress_stats.invalidated_pixels = invalidated_pixels - invalidated_before;
+}
+
+void reload_schedule_display(const schedule_t* previous)
+{
+    struct tm display_date = current_display_date;
+    reloaded_schedule = previous;
+    update_schedule_display(&display_date);
+    reloaded_schedule = NULL;
+
+    // The free rows still hold string identifiers of the previous schedule, which could match
+    // unrelated strings of the new one when the rows are reused
+    for (int i = 0; i < lesson_row_count; i++)
+    {
+        if (lesson_rows[i].index == -1)
+        {
+            forget_row_lesson(&lesson_rows[i]);
+        }
+    }
+}
+
+const schedule_ui_stats_t* get_schedule_ui_stats(void)
+{
+    return &stats;
+}
+
+const progress_stats_t* get_progress_stats(void)
+{
+    return &progress_stats;
+}
+
+lv_obj_t* get_lesson_block(int index)
+{
+    LessonRow* row = index >= 0 ? find_row(index) : NULL;
+    return row ? row->block : NULL;
+}
+
+int get_lesson_row_count(void)
+{
+    return lesson_row_count;
 }
 
 void init_schedule_ui(void)
 {
+    init_styles();
+
     // Create main container
     list_container = lv_obj_create(lv_screen_active());
     lv_obj_set_size(list_container, 670, 400);
@@ -276,9 +745,18 @@ void init_schedule_ui(void)
     lv_obj_set_style_bg_color(list_container, lv_color_hex(0xFFFFFF), 0); // White background
     lv_obj_set_style_radius(list_container, 0, 0);
     lv_obj_add_flag(list_container, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_layout(list_container, LV_LAYOUT_FLEX);
-    lv_obj_set_flex_flow(list_container, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_style_pad_gap(list_container, 15, 0);
+    lv_obj_add_event_cb(list_container, scroll_list, LV_EVENT_SCROLL, NULL);
+    lv_obj_add_event_cb(list_container, get_list_size, LV_EVENT_GET_SELF_SIZE, NULL);
+
+    // Measure an empty block, the height of every lesson is derived from it
+    if (!get_free_row()) return;
+    lv_obj_update_layout(list_container);
+    empty_row_height = lv_obj_get_height(lesson_rows[0].block);
+    empty_text_height = get_text_height(lesson_rows[0].subject_label, "");
+    lv_obj_add_flag(lesson_rows[0].block, LV_OBJ_FLAG_HIDDEN);
+
+    // Measure how much of the screen each update invalidates
+    lv_display_add_event_cb(lv_obj_get_display(list_container), count_invalidated_area, LV_EVENT_INVALIDATE_AREA, NULL);
 
     // Initial update (current date)
     time_t now = time(NULL);
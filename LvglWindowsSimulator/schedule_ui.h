@@ -1,8 +1,31 @@
 ﻿#ifndef SCHEDULE_UI_H
 #define SCHEDULE_UI_H
 
+#include "schedule_data.h"
+#include <lvgl/lvgl.h>
+#include <stdint.h>
+
 struct tm;
 
+/**
+ * Counters describing the work done since the last call to update_schedule_display(), including scrolling.
+ * Used to measure how many widgets the incremental update saves compared to a full rebuild.
+ */
+typedef struct {
+    uint32_t objects_created;       /** Widgets created (new lesson blocks and their children) */
+    uint32_t objects_deleted;       /** Widgets freed (lesson blocks and their children), rows are recycled instead */
+    uint32_t rows_reused;           /** Lesson blocks kept from the previous update or recycled while scrolling */
+    uint32_t properties_updated;    /** Texts, colors and bar values that actually changed */
+} schedule_ui_stats_t;
+
+/**
+ * Counters describing the work done by the last progress bar update.
+ */
+typedef struct {
+    uint32_t bars_updated;          /** Progress bars whose value changed, each starting one animation */
+    uint32_t invalidated_pixels;    /** Pixels invalidated on the display during the update */
+} progress_stats_t;
+
 /**
  * Initializes the schedule user interface.
  * @note Must be called after lvgl initialization and before any UI updates.
@@ -11,11 +34,21 @@ void init_schedule_ui(void);
 
 /**
  * Updates the schedule display for a specified date.
- * Clears the existing schedule UI and rebuilds it with lesson data for the given date.
+ * Reuses the lesson blocks already on screen and changes only the texts, colors and bar values that differ.
+ * Only the lessons in and near the visible part of the list get a block, so the number of widgets
+ * does not depend on the number of lessons. Blocks are recycled while the list is scrolled.
  * @param date  Pointer to a struct tm containing the date to display (year, month, day).
  */
 void update_schedule_display(struct tm* date);
 
+/**
+ * Updates the schedule display for a specified date as seen at a given time.
+ * Same as update_schedule_display(), with the current time passed in instead of read from the system clock.
+ * @param date          Pointer to a struct tm containing the date to display (year, month, day).
+ * @param current_time  Pointer to a struct tm containing the current date and time.
+ */
+void update_schedule_display_at(const struct tm* date, const struct tm* current_time);
+
 /**
  * Updates the progress bar for the current lesson.
  * Updates only the progress bar of the active lesson (if any) for the current date, based on the current time.
@@ -24,4 +57,44 @@ void update_schedule_display(struct tm* date);
  */
 void update_progress_bar(void);
 
+/**
+ * Updates the progress bar for the lesson active at a given time.
+ * The active lesson is tracked between calls: lessons that ended are completed once and
+ * only the bar of the running lesson is changed, so time must not go backwards between calls.
+ * @param current_time  Pointer to a struct tm containing the current date and time.
+ */
+void update_progress_bar_at(const struct tm* current_time);
+
+/**
+ * Updates the schedule display after the active schedule was replaced.
+ * Only the widgets whose content differs between the two schedules are changed and redrawn.
+ * @param previous  The schedule that was active before, still valid during the call.
+ */
+void reload_schedule_display(const schedule_t* previous);
+
+/**
+ * Gets the counters of the last schedule display update.
+ * @return Pointer to the statistics of the last update_schedule_display() call.
+ */
+const schedule_ui_stats_t* get_schedule_ui_stats(void);
+
+/**
+ * Gets the counters of the last progress bar update.
+ * @return Pointer to the statistics of the last update_progress_bar() call.
+ */
+const progress_stats_t* get_progress_stats(void);
+
+/**
+ * Gets the container widget of a displayed lesson block.
+ * @param index  Index of the lesson of the displayed date.
+ * @return The block, or NULL if the lesson is not near the visible part of the list.
+ */
+lv_obj_t* get_lesson_block(int index);
+
+/**
+ * Gets the number of lesson blocks created, whether they show a lesson or wait to be recycled.
+ * @return The number of lesson blocks.
+ */
+int get_lesson_row_count(void);
+
 #endif
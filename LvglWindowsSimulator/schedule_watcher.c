@@ -0,0 +1,153 @@
+﻿#include "schedule_watcher.h"
+#include "schedule_file.h"
+#include <lvgl/src/osal/lv_os.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define LOADER_STACK_SIZE (16 * 1024)
+
+/**
+ * Progress of a file version through the loader thread.
+ */
+typedef enum {
+    LOAD_IDLE,      // No load requested
+    LOAD_RUNNING,   // The loader thread is reading the file
+    LOAD_DONE,      // The result waits in loaded_schedule for the next poll
+} LoadState;
+
+/**
+ * State of a schedule file watcher.
+ */
+struct schedule_watcher {
+    const char* path;
+    schedule_reload_cb_t reload_cb;
+    time_t loaded_mtime;    // Modification time of the file version that was loaded or rejected
+    long long loaded_size;  // Size of the file version that was loaded or rejected
+    time_t seen_mtime;      // Modification time seen by the previous poll
+    long long seen_size;    // Size seen by the previous poll
+
+    lv_thread_t loader;
+    lv_thread_sync_t load_request;  // Wakes the loader thread
+    lv_mutex_t lock;                // Protects load_state and loaded_schedule
+    LoadState load_state;
+    schedule_t* loaded_schedule;    // NULL if the file was not a valid schedule
+};
+
+static int get_file_version(const char* path, time_t* mtime, long long* size)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+    {
+        *mtime = 0;
+        *size = -1;
+        return 0;
+    }
+    *mtime = st.st_mtime;
+    *size = (long long)st.st_size;
+    return 1;
+}
+
+/**
+ * Reads each requested file version, so the UI thread never waits for the disk.
+ * It lives as long as the watcher, which is never deleted.
+ */
+static void load_schedule_thread(void* user_data)
+{
+    schedule_watcher_t* watcher = user_data;
+    while (true)
+    {
+        lv_thread_sync_wait(&watcher->load_request);
+        schedule_t* schedule = load_schedule_file(watcher->path);
+
+        lv_mutex_lock(&watcher->lock);
+        watcher->loaded_schedule = schedule;
+        watcher->load_state = LOAD_DONE;
+        lv_mutex_unlock(&watcher->lock);
+    }
+}
+
+/**
+ * Makes the schedule read by the loader thread the active one.
+ * @return false if the loader thread is still reading, so no other version may be requested.
+ */
+static bool swap_loaded_schedule(schedule_watcher_t* watcher)
+{
+    lv_mutex_lock(&watcher->lock);
+    LoadState state = watcher->load_state;
+    schedule_t* schedule = watcher->loaded_schedule;
+    if (state == LOAD_DONE)
+    {
+        watcher->load_state = LOAD_IDLE;
+        watcher->loaded_schedule = NULL;
+    }
+    lv_mutex_unlock(&watcher->lock);
+
+    if (state == LOAD_RUNNING) return false;
+    if (state == LOAD_IDLE) return true;
+
+    if (!schedule)
+    {
+        LV_LOG_WARN("%s is not a valid schedule file", watcher->path);
+        return true;
+    }
+
+    schedule_t* previous = set_active_schedule(schedule);
+    if (watcher->reload_cb)
+    {
+        watcher->reload_cb(previous);
+    }
+    delete_schedule(previous);
+    return true;
+}
+
+void poll_schedule_watcher(schedule_watcher_t* watcher)
+{
+    if (!swap_loaded_schedule(watcher)) return;
+
+    time_t mtime;
+    long long size;
+    int exists = get_file_version(watcher->path, &mtime, &size);
+
+    // Wait until the file stops changing
+    int is_stable = mtime == watcher->seen_mtime && size == watcher->seen_size;
+    watcher->seen_mtime = mtime;
+    watcher->seen_size = size;
+    if (!exists || !is_stable) return;
+    if (mtime == watcher->loaded_mtime && size == watcher->loaded_size) return;
+
+    // Remember this version even if it is invalid, so it is not retried on every poll
+    watcher->loaded_mtime = mtime;
+    watcher->loaded_size = size;
+
+    lv_mutex_lock(&watcher->lock);
+    watcher->load_state = LOAD_RUNNING;
+    lv_mutex_unlock(&watcher->lock);
+    lv_thread_sync_signal(&watcher->load_request);
+}
+
+schedule_watcher_t* create_schedule_watcher(const char* path, schedule_reload_cb_t reload_cb)
+{
+    schedule_watcher_t* watcher = lv_malloc_zeroed(sizeof(schedule_watcher_t));
+    if (!watcher) return NULL;
+
+    watcher->path = path;
+    watcher->reload_cb = reload_cb;
+
+    // The version present at startup was already loaded (or rejected) by main()
+    get_file_version(path, &watcher->loaded_mtime, &watcher->loaded_size);
+    watcher->seen_mtime = watcher->loaded_mtime;
+    watcher->seen_size = watcher->loaded_size;
+
+    // The watcher is never deleted, so neither is the loader thread
+    lv_mutex_init(&watcher->lock);
+    lv_thread_sync_init(&watcher->load_request);
+    if (lv_thread_init(&watcher->loader, "schedule", LV_THREAD_PRIO_LOW, load_schedule_thread,
+        LOADER_STACK_SIZE, watcher) != LV_RESULT_OK)
+    {
+        lv_thread_sync_delete(&watcher->load_request);
+        lv_mutex_delete(&watcher->lock);
+        lv_free(watcher);
+        return NULL;
+    }
+    return watcher;
+}
@@ -0,0 +1,41 @@
+﻿#ifndef SCHEDULE_WATCHER_H
+#define SCHEDULE_WATCHER_H
+
+#include "schedule_data.h"
+#include <lvgl/lvgl.h>
+
+/**
+ * Watches a schedule file, see create_schedule_watcher().
+ */
+typedef struct schedule_watcher schedule_watcher_t;
+
+/**
+ * Called right after a new schedule became active, while the previous one is still valid.
+ * @param previous  The schedule that was active before, deleted when the callback returns.
+ */
+typedef void (*schedule_reload_cb_t)(const schedule_t* previous);
+
+/**
+ * Starts watching a schedule file, to make it the active schedule whenever it changes.
+ * A change is picked up once the modification time and size stayed the same between two polls,
+ * so a file that is still being written is never loaded. The file is then read by a loader thread,
+ * and the schedule is swapped in by the next poll, so the UI thread never waits for the disk.
+ * New files must be published by writing them under another name and renaming them over the old one,
+ * as schedule_converter.py does. The file must never be truncated or rewritten in place,
+ * see load_schedule_file().
+ * @param path       Path of the schedule file in the native file system.
+ * @param reload_cb  Called after each swap to update the screen, may be NULL.
+ * @return The watcher, which is never deleted, or NULL if the loader thread could not be started.
+ */
+schedule_watcher_t* create_schedule_watcher(const char* path, schedule_reload_cb_t reload_cb);
+
+/**
+ * Swaps in the schedule read since the previous poll, then checks the file for a new version.
+ * It has no timer of its own: the app polls from its minute tick, so an idle sign still wakes up
+ * only at minute boundaries, and a new file shows up within three minutes of being published.
+ * Call it from the LVGL thread, outside of a refresh.
+ * @param watcher  The watcher created by create_schedule_watcher().
+ */
+void poll_schedule_watcher(schedule_watcher_t* watcher);
+
+#endif
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+Builds a binary schedule file for the signage app from CSV or JSON.
+
+Input records have the fields room, date (YYYY-MM-DD), start and end (HH:MM),
+type, subject and teacher. CSV files need a header row with these names, JSON
+files hold either a list of records or an object with a "lessons" list.
+
+The output layout is described by schedule_file_header_t in schedule_data.h;
+the app maps it and serves lessons from it without parsing.
+
+Usage:
+    schedule_converter.py timetable.csv schedule.bin
+    schedule_converter.py timetable.json schedule.bin
+"""
+
+import argparse
+import csv
+import datetime
+import json
+import os
+import struct
+import sys
+
+SCHEDULE_FILE_MAGIC = 0x44484353
+SCHEDULE_FILE_VERSION = 1
+
+HEADER_FORMAT = "<IHHIiiiiIIIII"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+LESSON_FORMAT = "<IIIBBBB"
+
+EPOCH = datetime.date(1970, 1, 1).toordinal()
+
+FIELDS = ("room", "date", "start", "end", "type", "subject", "teacher")
+
+
+def align(size):
+    return (size + 3) & ~3
+
+
+def parse_time(text):
+    hour, minute = (int(part) for part in text.strip().split(":"))
+    if not (0 <= hour < 24 and 0 <= minute < 60):
+        raise ValueError(f"invalid time: {text}")
+    return hour, minute
+
+
+class StringPool:
+    """Interned NUL-terminated UTF-8 strings, identifier 0 is the empty string."""
+
+    def __init__(self):
+        self.data = bytearray(b"\0")
+        self.ids = {"": 0}
+
+    def intern(self, text):
+        text = text or ""
+        if text not in self.ids:
+            self.ids[text] = len(self.data)
+            self.data += text.encode("utf-8") + b"\0"
+        return self.ids[text]
+
+
+def read_records(path):
+    with open(path, encoding="utf-8-sig", newline="") as file:
+        if path.lower().endswith(".json"):
+            records = json.load(file)
+            if isinstance(records, dict):
+                records = records["lessons"]
+        else:
+            records = list(csv.DictReader(file))
+
+    for number, record in enumerate(records, 1):
+        missing = [field for field in FIELDS if field not in record]
+        if missing:
+            raise ValueError(f"record {number}: missing {', '.join(missing)}")
+        yield number, record
+
+
+def build_image(records):
+    pool = StringPool()
+    lessons = []
+    for number, record in records:
+        try:
+            day = datetime.date.fromisoformat(record["date"].strip()).toordinal() - EPOCH
+            start = parse_time(record["start"])
+            end = parse_time(record["end"])
+        except ValueError as error:
+            raise ValueError(f"record {number}: {error}") from None
+        if end <= start:
+            raise ValueError(f"record {number}: lesson ends before it starts")
+        lessons.append((pool.intern(record["room"]), day, start, end,
+                        pool.intern(record["type"]),
+                        pool.intern(record["subject"]),
+                        pool.intern(record["teacher"])))
+
+    # Rooms are sorted like strcmp() does, by their UTF-8 bytes
+    room_ids = sorted({lesson[0] for lesson in lessons},
+                      key=lambda id: pool.data[id:pool.data.index(0, id)])
+    room_index = {id: index for index, id in enumerate(room_ids)}
+    lessons.sort(key=lambda lesson: (room_index[lesson[0]], lesson[1], lesson[2]))
+
+    first_day = min((lesson[1] for lesson in lessons), default=0)
+    last_day = max((lesson[1] for lesson in lessons), default=-1)
+    day_count = last_day - first_day + 1
+
+    day_offsets = []
+    for index, lesson in enumerate(lessons):
+        slot = room_index[lesson[0]] * day_count + lesson[1] - first_day
+        while len(day_offsets) <= slot:
+            day_offsets.append(index)
+    while len(day_offsets) < len(room_ids) * day_count + 1:
+        day_offsets.append(len(lessons))
+
+    lessons_offset = align(HEADER_SIZE)
+    day_offsets_offset = lessons_offset + struct.calcsize(LESSON_FORMAT) * len(lessons)
+    room_names_offset = day_offsets_offset + 4 * len(day_offsets)
+    strings_offset = room_names_offset + 4 * len(room_ids)
+    file_size = align(strings_offset + len(pool.data))
+
+    image = bytearray(file_size)
+    struct.pack_into(HEADER_FORMAT, image, 0,
+                     SCHEDULE_FILE_MAGIC, SCHEDULE_FILE_VERSION, HEADER_SIZE, file_size,
+                     first_day, day_count, len(room_ids), len(lessons),
+                     lessons_offset, day_offsets_offset, room_names_offset,
+                     strings_offset, len(pool.data))
+    for index, (_, _, start, end, type, subject, teacher) in enumerate(lessons):
+        struct.pack_into(LESSON_FORMAT, image, lessons_offset + index * struct.calcsize(LESSON_FORMAT),
+                         type, subject, teacher, start[0], start[1], end[0], end[1])
+    struct.pack_into(f"<{len(day_offsets)}I", image, day_offsets_offset, *day_offsets)
+    struct.pack_into(f"<{len(room_ids)}I", image, room_names_offset, *room_ids)
+    image[strings_offset:strings_offset + len(pool.data)] = pool.data
+    return image, len(room_ids), len(lessons), len(pool.data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build a binary schedule file from CSV or JSON.")
+    parser.add_argument("input", help="timetable in CSV or JSON format")
+    parser.add_argument("output", help="schedule file to write")
+    args = parser.parse_args()
+
+    try:
+        image, rooms, lessons, strings = build_image(read_records(args.input))
+    except (OSError, ValueError, KeyError) as error:
+        print(f"error: {error}", file=sys.stderr)
+        return 1
+
+    # Signs watching the file must never see it half written, so it is replaced in one rename.
+    # Writing it in place would also crash signs that have it memory-mapped.
+    temporary = args.output + ".tmp"
+    with open(temporary, "wb") as file:
+        file.write(image)
+    os.replace(temporary, args.output)
+    print(f"{args.output}: {rooms} rooms, {lessons} lessons, {strings} bytes of strings, {len(image)} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())